@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/graph.h"
+
+#define DEFAULT_REPEATS 7
+#define DEFAULT_PARTS 8
+#define MIN_SAMPLE_SECONDS 0.02   // Najkrótszy mierzony odcinek (krótkie pętle są powtarzane)
+
+// Funkcja zwracająca bieżący czas monotoniczny w sekundach
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Mierzone pętle
+typedef enum {
+    BENCH_DEGREES,   // compute_part_degrees
+    BENCH_PAIR,      // neighbor_pair_weights dla każdego węzła (własna i następna część)
+    BENCH_CUT        // calculate_cut_from_parts
+} BenchKernel;
+
+// Funkcja wykonująca jeden przebieg mierzonej pętli
+// Zwraca przekrój (BENCH_CUT) lub sumę kontrolną wyników
+static long run_kernel(const Graph* graph, const int* part_of, int num_parts, int* internal, int* external,
+                       BenchKernel kernel) {
+    if (kernel == BENCH_CUT) return calculate_cut_from_parts(graph, part_of);
+    if (kernel == BENCH_DEGREES) {
+        compute_part_degrees(graph, part_of, internal, external);
+        return 0;
+    }
+    long checksum = 0;
+    for (int v = 0; v < graph->total_vertices; v++) {
+        int own = part_of[v];
+        int to_part, to_other;
+        int count = neighbor_pair_weights(graph, part_of, v, own, (own + 1) % num_parts, &to_part, &to_other);
+        checksum += to_other - to_part + count;
+    }
+    return checksum;
+}
+
+// Funkcja mierząca medianę czasu jednego przebiegu pętli dla bieżącej wersji
+// Parametr result - wynik ostatniego przebiegu (run_kernel)
+// Zwraca medianę w sekundach
+static double measure_kernel(const Graph* graph, const int* part_of, int num_parts, int* internal, int* external,
+                             BenchKernel kernel, int repeats, double* samples, long* result) {
+    // Liczba wywołań w próbce dobierana tak, aby próbka trwała co najmniej MIN_SAMPLE_SECONDS
+    int calls = 1;
+    for (;;) {
+        double start = now_seconds();
+        for (int c = 0; c < calls; c++) {
+            *result = run_kernel(graph, part_of, num_parts, internal, external, kernel);
+        }
+        if (now_seconds() - start >= MIN_SAMPLE_SECONDS || calls >= 1 << 20) break;
+        calls *= 2;
+    }
+
+    for (int r = 0; r < repeats; r++) {
+        double start = now_seconds();
+        for (int c = 0; c < calls; c++) {
+            *result = run_kernel(graph, part_of, num_parts, internal, external, kernel);
+        }
+        samples[r] = (now_seconds() - start) / calls;
+    }
+    qsort(samples, repeats, sizeof(double), compare_doubles);
+    return samples[repeats / 2];
+}
+
+// Funkcja nadająca krawędziom grafu wagi 1-8 zależne od pary końców (symetryczne)
+// Wersje wektorowe mają osobne ścieżki dla grafów z wagami krawędzi, dlatego pętle
+// porównywane są także na grafie ważonym
+// Zwraca tablicę wag (przypisaną do graph->adjwgt) lub NULL w przypadku błędu alokacji
+static int* add_edge_weights(Graph* graph) {
+    int n = graph->total_vertices;
+    int64_t slots = graph->xadj[n];
+    int* adjwgt = (int*)malloc((slots > 0 ? slots : 1) * sizeof(int));
+    if (!adjwgt) return NULL;
+    for (int v = 0; v < n; v++) {
+        for (int64_t j = graph->xadj[v]; j < graph->xadj[v + 1]; j++) {
+            unsigned int pair = (unsigned int)(v ^ graph_neighbor(graph, j));
+            adjwgt[j] = 1 + (int)((pair * 2654435761u) >> 29);
+        }
+    }
+    graph->adjwgt = adjwgt;
+    return adjwgt;
+}
+
+// Funkcja mierząca wszystkie pętle dla każdej obsługiwanej wersji i porównująca
+// wyniki wersji wektorowych z wersją skalarną
+// Parametr edges - opis wag krawędzi w tabeli
+// Zwraca 0, gdy wyniki są zgodne, 1 w przeciwnym przypadku
+static int compare_versions(const char* filename, const Graph* graph, const int* part_of, int parts,
+                            const char* edges, int* internal, int* external, int* reference_internal,
+                            int* reference_external, int repeats, double* samples) {
+    int n = graph->total_vertices;
+    int max_degree = 0;
+    for (int v = 0; v < n; v++) {
+        if (graph_degree(graph, v) > max_degree) max_degree = graph_degree(graph, v);
+    }
+    double average_degree = n > 0 ? 2.0 * graph->num_edges / n : 0.0;
+
+    KernelIsa supported = kernels_supported();
+    int result = 0;
+    double scalar_degrees = 0.0;
+    double scalar_pair = 0.0;
+    double scalar_cut = 0.0;
+    long reference_pair = 0;
+    long reference_cut = 0;
+    for (int isa = KERNEL_SCALAR; isa <= (int)supported; isa++) {
+        kernels_select((KernelIsa)isa);
+        long unused, pair, cut;
+        double degrees_time = measure_kernel(graph, part_of, parts, internal, external, BENCH_DEGREES,
+                                             repeats, samples, &unused);
+        double pair_time = measure_kernel(graph, part_of, parts, internal, external, BENCH_PAIR,
+                                          repeats, samples, &pair);
+        double cut_time = measure_kernel(graph, part_of, parts, internal, external, BENCH_CUT,
+                                         repeats, samples, &cut);
+        if (isa == KERNEL_SCALAR) {
+            scalar_degrees = degrees_time;
+            scalar_pair = pair_time;
+            scalar_cut = cut_time;
+            reference_pair = pair;
+            reference_cut = cut;
+            memcpy(reference_internal, internal, n * sizeof(int));
+            memcpy(reference_external, external, n * sizeof(int));
+        } else if (cut != reference_cut || pair != reference_pair ||
+                   memcmp(reference_internal, internal, n * sizeof(int)) != 0 ||
+                   memcmp(reference_external, external, n * sizeof(int)) != 0) {
+            fprintf(stderr, "Błąd: Wynik wersji %s różni się od wersji skalarnej (krawędzie: %s): %s\n",
+                    kernels_name((KernelIsa)isa), edges, filename);
+            result = 1;
+        }
+        printf("%-24s %10d %8.2f %8d %8s %8s %14.1f %7.2fx %14.1f %7.2fx %14.1f %7.2fx\n", filename, n,
+               average_degree, max_degree, edges, kernels_name((KernelIsa)isa), degrees_time * 1e6,
+               scalar_degrees / degrees_time, pair_time * 1e6, scalar_pair / pair_time,
+               cut_time * 1e6, scalar_cut / cut_time);
+    }
+    kernels_select(supported);
+    return result;
+}
+
+// Program porównujący wersje skalarne i wektorowe (AVX2, AVX-512) pętli zliczających
+// części sąsiadów: wag krawędzi do własnej i obcych części (compute_part_degrees),
+// wag krawędzi do dwóch części dla pojedynczych węzłów (neighbor_pair_weights, jak przy
+// liczeniu zysków KL i FM) oraz przekroju (calculate_cut_from_parts)
+// Podziałem jest podział wielopoziomowy na -p części, więc proporcja krawędzi
+// wewnętrznych i brzegowych odpowiada rzeczywistemu udoskonalaniu
+// Każdy graf mierzony jest bez wag krawędzi i z wagami nadanymi przez add_edge_weights;
+// wyniki wersji wektorowych porównywane są z wersją skalarną
+// Użycie: bench_kernels [-r powtórzenia] [-p części] plik.csrrg...
+int main(int argc, char* argv[]) {
+    int repeats = DEFAULT_REPEATS;
+    int num_parts = DEFAULT_PARTS;
+    int opt;
+    while ((opt = getopt(argc, argv, "r:p:")) != -1) {
+        switch (opt) {
+            case 'r':
+                repeats = atoi(optarg);
+                break;
+            case 'p':
+                num_parts = atoi(optarg);
+                break;
+            default:
+                repeats = 0;
+                break;
+        }
+    }
+    if (optind >= argc || repeats <= 0 || num_parts <= 0) {
+        printf("Użycie: %s [-r powtórzenia] [-p części] plik.csrrg...\n", argv[0]);
+        return 1;
+    }
+
+    double* samples = (double*)malloc(repeats * sizeof(double));
+    if (!samples) return 1;
+
+    printf("Obsługiwane wersje pętli: do %s\n\n", kernels_name(kernels_supported()));
+    printf("%-24s %10s %8s %8s %8s %8s %14s %8s %14s %8s %14s %8s\n", "plik", "węzły", "śr. st.", "maks. st.",
+           "krawędzie", "wersja", "stopnie [us]", "przysp.", "para [us]", "przysp.", "przekrój [us]", "przysp.");
+
+    int result = 0;
+    for (int f = optind; f < argc; f++) {
+        Graph* graph = NULL;
+        if (load_graph_from_file(argv[f], &graph) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", argv[f]);
+            result = 1;
+            continue;
+        }
+        int n = graph->total_vertices;
+        int* part_of = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        int* internal = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        int* external = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        int* reference_internal = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        int* reference_external = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+        PartitionOptions options;
+        partition_options_init(&options);
+        options.num_parts = num_parts < n ? num_parts : (n > 0 ? n : 1);
+        options.multilevel = true;
+        options.refinement = REFINE_KWAY;
+        if (!part_of || !internal || !external || !reference_internal || !reference_external ||
+            graph->adjwgt || partition_graph(graph, &options, part_of) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się podzielić grafu: %s\n", argv[f]);
+            result = 1;
+        } else {
+            result |= compare_versions(argv[f], graph, part_of, options.num_parts, "1", internal, external,
+                                       reference_internal, reference_external, repeats, samples);
+            int* adjwgt = add_edge_weights(graph);
+            if (!adjwgt) {
+                result = 1;
+            } else {
+                result |= compare_versions(argv[f], graph, part_of, options.num_parts, "wagi", internal,
+                                           external, reference_internal, reference_external, repeats, samples);
+                // Wagi nie należą do grafu odwzorowanego z pliku .csrb, więc zwalniane są tutaj
+                graph->adjwgt = NULL;
+                free(adjwgt);
+            }
+        }
+
+        free(part_of);
+        free(internal);
+        free(external);
+        free(reference_internal);
+        free(reference_external);
+        destroy_graph(graph);
+    }
+
+    free(samples);
+    return result;
+}
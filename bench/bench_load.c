@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/graph.h"
+
+#define DEFAULT_REPEATS 20
+
+// Funkcja zwracająca bieżący czas monotoniczny w sekundach
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Funkcja mierząca medianę czasu wczytywania pliku dla danej liczby wątków
+// Zwraca medianę w sekundach lub wartość ujemną w przypadku błędu
+static double measure_load(const char* filename, int num_threads, int repeats, double* samples,
+                           int* vertices, long* edges) {
+    for (int r = 0; r < repeats; r++) {
+        Graph* graph = NULL;
+        double start = now_seconds();
+        if (load_graph_from_file_parallel(filename, &graph, num_threads) != 0) return -1.0;
+        samples[r] = now_seconds() - start;
+        *vertices = graph->total_vertices;
+        *edges = graph->num_edges;
+        destroy_graph(graph);
+    }
+    qsort(samples, repeats, sizeof(double), compare_doubles);
+    return samples[repeats / 2];
+}
+
+// Program mierzący przepustowość wczytywania plików CSRRG (MB/s)
+// Przy -j większym od 1 porównuje wczytywanie równoległe z jednowątkowym
+// Użycie: bench_load [-r powtórzenia] [-j wątki] plik.csrrg...
+int main(int argc, char* argv[]) {
+    int repeats = DEFAULT_REPEATS;
+    int num_threads = 1;
+    int opt;
+    while ((opt = getopt(argc, argv, "r:j:")) != -1) {
+        switch (opt) {
+            case 'r':
+                repeats = atoi(optarg);
+                break;
+            case 'j':
+                num_threads = atoi(optarg);
+                break;
+            default:
+                repeats = 0;
+                break;
+        }
+    }
+    if (optind >= argc || repeats <= 0 || num_threads <= 0) {
+        printf("Użycie: %s [-r powtórzenia] [-j wątki] plik.csrrg...\n", argv[0]);
+        return 1;
+    }
+
+    double* samples = (double*)malloc(repeats * sizeof(double));
+    if (!samples) return 1;
+
+    printf("%-24s %10s %10s %10s %12s %10s", "plik", "rozmiar", "węzły", "krawędzie", "mediana [ms]", "MB/s");
+    if (num_threads > 1) printf(" %14s %10s %10s", "równolegle [ms]", "MB/s", "przysp.");
+    printf("\n");
+
+    for (int f = optind; f < argc; f++) {
+        struct stat st;
+        if (stat(argv[f], &st) != 0) {
+            fprintf(stderr, "Błąd: Nie można odczytać pliku %s\n", argv[f]);
+            continue;
+        }
+
+        int vertices = 0;
+        long edges = 0;
+        double median = measure_load(argv[f], 1, repeats, samples, &vertices, &edges);
+        double parallel = num_threads > 1 ?
+            measure_load(argv[f], num_threads, repeats, samples, &vertices, &edges) : 0.0;
+        if (median < 0 || parallel < 0) {
+            fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", argv[f]);
+            continue;
+        }
+
+        printf("%-24s %10ld %10d %10ld %12.3f %10.1f", argv[f], (long)st.st_size,
+               vertices, edges, median * 1e3, st.st_size / median / 1e6);
+        if (num_threads > 1) {
+            printf(" %14.3f %10.1f %9.2fx", parallel * 1e3, st.st_size / parallel / 1e6, median / parallel);
+        }
+        printf("\n");
+    }
+
+    free(samples);
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/graph.h"
+
+#define DEFAULT_REPEATS 5
+#define DEFAULT_PARTS 8
+#define DEFAULT_MARGIN 10.0
+
+// Funkcja zwracająca bieżący czas monotoniczny w sekundach
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Funkcja mierząca medianę czasu udoskonalania propagacją etykiet dla danej liczby wątków
+// Każde powtórzenie zaczyna od tego samego podziału początkowego
+// Zwraca medianę w sekundach lub wartość ujemną w przypadku błędu
+static double measure_refine(const Graph* graph, const int* initial, int* part_of, int num_parts,
+                             int num_threads, int repeats, double* samples, long* cut) {
+    int n = graph->total_vertices;
+    for (int r = 0; r < repeats; r++) {
+        memcpy(part_of, initial, n * sizeof(int));
+        double start = now_seconds();
+        if (refine_lp(graph, part_of, num_parts, DEFAULT_MARGIN, num_threads) != 0) return -1.0;
+        samples[r] = now_seconds() - start;
+    }
+    *cut = calculate_cut_from_parts(graph, part_of);
+    qsort(samples, repeats, sizeof(double), compare_doubles);
+    return samples[repeats / 2];
+}
+
+// Program mierzący skalowanie równoległego udoskonalania (propagacja etykiet)
+// dla liczby wątków 1, 2, 4, ... aż do podanej wartości -j
+// Podziałem początkowym jest podział na ciągłe zakresy indeksów
+// Użycie: bench_refine [-r powtórzenia] [-j wątki] [-p części] plik.csrrg...
+int main(int argc, char* argv[]) {
+    int repeats = DEFAULT_REPEATS;
+    int max_threads = 1;
+    int num_parts = DEFAULT_PARTS;
+    int opt;
+    while ((opt = getopt(argc, argv, "r:j:p:")) != -1) {
+        switch (opt) {
+            case 'r':
+                repeats = atoi(optarg);
+                break;
+            case 'j':
+                max_threads = atoi(optarg);
+                break;
+            case 'p':
+                num_parts = atoi(optarg);
+                break;
+            default:
+                repeats = 0;
+                break;
+        }
+    }
+    if (optind >= argc || repeats <= 0 || max_threads <= 0 || num_parts <= 0) {
+        printf("Użycie: %s [-r powtórzenia] [-j wątki] [-p części] plik.csrrg...\n", argv[0]);
+        return 1;
+    }
+
+    double* samples = (double*)malloc(repeats * sizeof(double));
+    if (!samples) return 1;
+
+    printf("%-24s %10s %10s %8s %12s %10s %10s\n", "plik", "węzły", "krawędzie", "wątki",
+           "mediana [ms]", "przekrój", "przysp.");
+
+    for (int f = optind; f < argc; f++) {
+        Graph* graph = NULL;
+        if (load_graph_from_file(argv[f], &graph) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", argv[f]);
+            continue;
+        }
+
+        int n = graph->total_vertices;
+        int* initial = (int*)malloc(n * sizeof(int));
+        int* part_of = (int*)malloc(n * sizeof(int));
+        if (!initial || !part_of) {
+            free(initial);
+            free(part_of);
+            destroy_graph(graph);
+            continue;
+        }
+        initial_partition_contiguous(n, num_parts, initial);
+
+        double baseline = 0.0;
+        for (int threads = 1; ; threads *= 2) {
+            if (threads > max_threads) threads = max_threads;
+            long cut = 0;
+            double median = measure_refine(graph, initial, part_of, num_parts, threads, repeats, samples, &cut);
+            if (median < 0) {
+                fprintf(stderr, "Błąd: Udoskonalanie nie powiodło się: %s\n", argv[f]);
+                break;
+            }
+            if (threads == 1) baseline = median;
+            printf("%-24s %10d %10ld %8d %12.3f %10ld %9.2fx\n", argv[f], n, (long)graph->num_edges, threads,
+                   median * 1e3, cut, baseline / median);
+            if (threads == max_threads) break;
+        }
+
+        free(initial);
+        free(part_of);
+        destroy_graph(graph);
+    }
+
+    free(samples);
+    return 0;
+}
@@ -0,0 +1,359 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "../include/graph.h"
+
+#define DEFAULT_REPEATS 5
+#define DEFAULT_CONFIGS "2:10,8:10,32:10"
+#define MAX_CONFIGS 64
+
+// Ustawienia podziału mierzone dla każdego pliku
+typedef struct {
+    int num_parts;       // Liczba części (-p)
+    double margin;       // Margines w procentach (-m)
+} BenchConfig;
+
+// Mediana i 95. percentyl serii pomiarów
+typedef struct {
+    double median;
+    double p95;
+} TimingStats;
+
+// Funkcja zwracająca bieżący czas monotoniczny w sekundach
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Funkcja sortująca próbki i wyznaczająca medianę oraz 95. percentyl (metoda najbliższej rangi)
+static TimingStats summarize(double* samples, int repeats) {
+    qsort(samples, repeats, sizeof(double), compare_doubles);
+    TimingStats stats;
+    stats.median = samples[repeats / 2];
+    int rank = (int)ceil(0.95 * repeats) - 1;
+    stats.p95 = samples[rank < 0 ? 0 : rank];
+    return stats;
+}
+
+// Funkcja zwracająca maksymalny rozmiar pamięci rezydentnej procesu w KB
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+    return usage.ru_maxrss;
+}
+
+// Funkcja parsująca listę ustawień w postaci p:m[,p:m...]
+// Zwraca liczbę ustawień lub -1 w przypadku błędnego zapisu
+static int parse_configs(const char* text, BenchConfig* configs) {
+    int count = 0;
+    const char* p = text;
+    while (*p) {
+        char* end;
+        long parts = strtol(p, &end, 10);
+        if (end == p || *end != ':' || parts <= 0 || count >= MAX_CONFIGS) return -1;
+        p = end + 1;
+        double margin = strtod(p, &end);
+        if (end == p || margin < 0 || (*end != ',' && *end != '\0')) return -1;
+        configs[count].num_parts = (int)parts;
+        configs[count].margin = margin;
+        count++;
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+// Funkcja wypisująca napis w formacie JSON (z cudzysłowami i znakami ucieczki)
+static void print_json_string(FILE* out, const char* text) {
+    fputc('"', out);
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            fprintf(out, "\\%c", *p);
+        } else if (*p < 0x20) {
+            fprintf(out, "\\u%04x", *p);
+        } else {
+            fputc(*p, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Funkcja wypisująca obiekt JSON z medianą i 95. percentylem czasu w milisekundach
+static void print_json_timing(FILE* out, const char* name, TimingStats stats) {
+    fprintf(out, "\"%s\": {\"median_ms\": %.4f, \"p95_ms\": %.4f}", name, stats.median * 1e3, stats.p95 * 1e3);
+}
+
+// Funkcja zwalniająca grupy węzłów
+static void free_groups(VertexGroup* groups, int num_groups) {
+    if (!groups) return;
+    for (int i = 0; i < num_groups; i++) free(groups[i].vertices);
+    free(groups);
+}
+
+// Funkcja mierząca czas wczytywania pliku
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu; *graph zawiera graf z ostatniego wczytania
+static int measure_load(const char* filename, int num_threads, int repeats, double* samples,
+                        Graph** graph, TimingStats* stats) {
+    *graph = NULL;
+    for (int r = 0; r < repeats; r++) {
+        destroy_graph(*graph);
+        *graph = NULL;
+        double start = now_seconds();
+        if (load_graph_from_file_parallel(filename, graph, num_threads) != 0) return -1;
+        samples[r] = now_seconds() - start;
+    }
+    *stats = summarize(samples, repeats);
+    return 0;
+}
+
+// Nazwa kolejności węzłów w wynikach JSON
+static const char* ordering_name(VertexOrdering ordering) {
+    switch (ordering) {
+        case ORDER_BFS: return "bfs";
+        case ORDER_RCM: return "rcm";
+        default: return "none";
+    }
+}
+
+// Funkcja mierząca fazy podziału, liczenia przekroju i zapisu dla jednego ustawienia
+// i wypisująca wynik jako obiekt JSON
+// Parametry ordering i reorder_ms - kolejność węzłów grafu i czas jego przenumerowania
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int measure_config(FILE* out, const char* filename, Graph* graph, TimingStats load,
+                          VertexOrdering ordering, double reorder_ms,
+                          const PartitionOptions* options, int repeats, double* samples,
+                          const char* save_path) {
+    TimingStats partition, cut_count, save;
+    VertexGroup* groups = NULL;
+    int num_parts = options->num_parts;
+
+    for (int r = 0; r < repeats; r++) {
+        free_groups(groups, num_parts);
+        groups = NULL;
+        double start = now_seconds();
+        if (divide_graph_with_options(graph, options, &groups) != 0) return -1;
+        samples[r] = now_seconds() - start;
+    }
+    partition = summarize(samples, repeats);
+
+    long cut = 0;
+    for (int r = 0; r < repeats; r++) {
+        double start = now_seconds();
+        cut = calculate_edges_between_groups(graph, groups, num_parts);
+        samples[r] = now_seconds() - start;
+    }
+    cut_count = summarize(samples, repeats);
+
+    for (int r = 0; r < repeats; r++) {
+        double start = now_seconds();
+        if (save_graph_division(save_path, graph, groups, num_parts, false) != 0) {
+            free_groups(groups, num_parts);
+            return -1;
+        }
+        samples[r] = now_seconds() - start;
+    }
+    save = summarize(samples, repeats);
+    remove(save_path);
+
+    double imbalance = calculate_size_difference(groups, num_parts);
+    free_groups(groups, num_parts);
+
+    fprintf(out, "    {\"file\": ");
+    print_json_string(out, filename);
+    fprintf(out, ", \"vertices\": %d, \"edges\": %ld, \"parts\": %d, \"margin\": %.2f,\n      ",
+            graph->total_vertices, (long)graph->num_edges, num_parts, options->margin_percentage);
+    fprintf(out, "\"ordering\": \"%s\", \"reorder_ms\": %.4f, ", ordering_name(ordering), reorder_ms);
+    print_json_timing(out, "load", load);
+    fprintf(out, ", ");
+    print_json_timing(out, "partition", partition);
+    fprintf(out, ",\n      ");
+    print_json_timing(out, "cut_count", cut_count);
+    fprintf(out, ", ");
+    print_json_timing(out, "save", save);
+    fprintf(out, ",\n      \"edge_cut\": %ld, \"imbalance_percent\": ", cut);
+    if (isfinite(imbalance)) {
+        fprintf(out, "%.4f", imbalance);
+    } else {
+        fprintf(out, "null");
+    }
+    fprintf(out, ", \"adjacency_bytes\": %zu, \"peak_rss_kb\": %ld}", graph_adjacency_bytes(graph), peak_rss_kb());
+    return 0;
+}
+
+// Program mierzący osobno fazy wczytywania, podziału, liczenia przekroju i zapisu
+// dla każdego pliku i każdego ustawienia -p/-m; wynik wypisywany jest jako JSON
+// (mediana i 95. percentyl czasów, przekrój, niezrównoważenie, szczytowe RSS)
+// Szczytowe RSS dotyczy całego procesu, więc rośnie monotonicznie między wpisami
+// Opcja -z kompresuje listy sąsiadów po wczytaniu (czas wczytywania jej nie obejmuje)
+// Opcja -O mierzy każde ustawienie dwukrotnie: w kolejności węzłów z pliku i po
+// przenumerowaniu (rcm lub bfs); wpisy różnią się polem "ordering", a "reorder_ms"
+// podaje jednorazowy czas przenumerowania
+// Użycie: bench_suite [-r powtórzenia] [-j wątki] [-c p:m,...] [-R kl|fm|kway|lp|none] [-I contiguous|geometric] [-M] [-O rcm|bfs] [-z] plik.csrrg...
+int main(int argc, char* argv[]) {
+    int repeats = DEFAULT_REPEATS;
+    int num_threads = 1;
+    BenchConfig configs[MAX_CONFIGS];
+    int num_configs = parse_configs(DEFAULT_CONFIGS, configs);
+    PartitionOptions options;
+    partition_options_init(&options);
+    const char* refinement_name = "kl";
+    const char* initial_name = "contiguous";
+    bool compress = false;
+    VertexOrdering ordering = ORDER_NONE;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:j:c:R:I:MO:z")) != -1) {
+        switch (opt) {
+            case 'r':
+                repeats = atoi(optarg);
+                break;
+            case 'j':
+                num_threads = atoi(optarg);
+                break;
+            case 'c':
+                num_configs = parse_configs(optarg, configs);
+                break;
+            case 'R':
+                refinement_name = optarg;
+                if (strcmp(optarg, "kl") == 0) {
+                    options.refinement = REFINE_KL;
+                } else if (strcmp(optarg, "fm") == 0) {
+                    options.refinement = REFINE_FM;
+                } else if (strcmp(optarg, "kway") == 0) {
+                    options.refinement = REFINE_KWAY;
+                } else if (strcmp(optarg, "lp") == 0) {
+                    options.refinement = REFINE_LP;
+                } else if (strcmp(optarg, "none") == 0) {
+                    options.refinement = REFINE_NONE;
+                } else {
+                    repeats = 0;
+                }
+                break;
+            case 'I':
+                initial_name = optarg;
+                if (strcmp(optarg, "contiguous") == 0) {
+                    options.initial = INITIAL_CONTIGUOUS;
+                } else if (strcmp(optarg, "geometric") == 0) {
+                    options.initial = INITIAL_GEOMETRIC;
+                } else {
+                    repeats = 0;
+                }
+                break;
+            case 'M':
+                options.multilevel = true;
+                break;
+            case 'O':
+                if (strcmp(optarg, "rcm") == 0) {
+                    ordering = ORDER_RCM;
+                } else if (strcmp(optarg, "bfs") == 0) {
+                    ordering = ORDER_BFS;
+                } else {
+                    repeats = 0;
+                }
+                break;
+            case 'z':
+                compress = true;
+                break;
+            default:
+                repeats = 0;
+                break;
+        }
+    }
+    if (optind >= argc || repeats <= 0 || num_threads <= 0 || num_configs <= 0) {
+        printf("Użycie: %s [-r powtórzenia] [-j wątki] [-c p:m,...] [-R kl|fm|kway|lp|none] [-I contiguous|geometric] [-M] [-O rcm|bfs] [-z] plik.csrrg...\n",
+               argv[0]);
+        return 1;
+    }
+    options.num_threads = num_threads;
+
+    double* samples = (double*)malloc(repeats * sizeof(double));
+    if (!samples) return 1;
+
+    // Plik wynikowy fazy zapisu umieszczany jest w katalogu tymczasowym
+    const char* tmpdir = getenv("TMPDIR");
+    char save_path[4096];
+    snprintf(save_path, sizeof(save_path), "%s/bench_suite_%ld.txt", tmpdir ? tmpdir : "/tmp", (long)getpid());
+
+    FILE* out = stdout;
+    fprintf(out, "{\n  \"repeats\": %d, \"threads\": %d, \"refinement\": ", repeats, num_threads);
+    print_json_string(out, refinement_name);
+    fprintf(out, ", \"initial\": ");
+    print_json_string(out, initial_name);
+    fprintf(out, ", \"multilevel\": %s, \"compressed\": %s,\n  \"results\": [\n",
+            options.multilevel ? "true" : "false", compress ? "true" : "false");
+
+    int status = 0;
+    bool first = true;
+    for (int f = optind; f < argc; f++) {
+        Graph* graph = NULL;
+        TimingStats load;
+        if (measure_load(argv[f], num_threads, repeats, samples, &graph, &load) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", argv[f]);
+            destroy_graph(graph);
+            status = 1;
+            continue;
+        }
+
+        // Przebieg w kolejności z pliku, a z opcją -O także po przenumerowaniu grafu
+        // wczytanego ponownie (przenumerowanie musi poprzedzać kompresję)
+        int num_passes = ordering != ORDER_NONE ? 2 : 1;
+        for (int pass = 0; pass < num_passes && graph; pass++) {
+            VertexOrdering pass_ordering = pass == 0 ? ORDER_NONE : ordering;
+            double reorder_ms = 0.0;
+            if (pass > 0) {
+                destroy_graph(graph);
+                graph = NULL;
+                if (load_graph_from_file_parallel(argv[f], &graph, num_threads) != 0) {
+                    fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", argv[f]);
+                    status = 1;
+                    break;
+                }
+                double start = now_seconds();
+                if (graph_reorder(graph, pass_ordering) != 0) {
+                    fprintf(stderr, "Błąd: Nie udało się przenumerować węzłów grafu: %s\n", argv[f]);
+                    status = 1;
+                    break;
+                }
+                reorder_ms = (now_seconds() - start) * 1e3;
+            }
+            if (compress && graph_compress(graph) != 0) {
+                fprintf(stderr, "Błąd: Nie udało się skompresować list sąsiadów grafu: %s\n", argv[f]);
+                status = 1;
+                break;
+            }
+
+            for (int c = 0; c < num_configs; c++) {
+                options.num_parts = configs[c].num_parts;
+                options.margin_percentage = configs[c].margin;
+                if (options.num_parts > graph->total_vertices) continue;
+
+                if (!first) fprintf(out, ",\n");
+                first = false;
+                if (measure_config(out, argv[f], graph, load, pass_ordering, reorder_ms, &options, repeats,
+                                   samples, save_path) != 0) {
+                    fprintf(stderr, "Błąd: Pomiar nie powiódł się: %s (p=%d)\n", argv[f], options.num_parts);
+                    fprintf(out, "    {\"file\": ");
+                    print_json_string(out, argv[f]);
+                    fprintf(out, ", \"parts\": %d, \"error\": true}", options.num_parts);
+                    status = 1;
+                }
+                fflush(out);
+            }
+        }
+        destroy_graph(graph);
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    free(samples);
+    return status;
+}
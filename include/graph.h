@@ -4,16 +4,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #define INITIAL_CAPACITY 16
 
-// Struktura reprezentująca sąsiadów węzła
-typedef struct {
-    int* neighbors;     // Lista sąsiadów
-    int count;         // Liczba sąsiadów
-    int capacity;      // Pojemność tablicy sąsiadów
-} AdjacencyList;
-
 // Struktura reprezentująca grupę węzłów
 typedef struct {
     int* vertices;      // Węzły w grupie
@@ -22,48 +16,505 @@ typedef struct {
     int capacity;      // Pojemność tablicy węzłów
 } VertexGroup;
 
+// Szerokość identyfikatorów węzłów w tablicy adjncy
+// Wczytywanie wybiera najwęższą szerokość mieszczącą wszystkie węzły grafu
+typedef enum {
+    INDEX_WIDTH_16 = 16,  // uint16_t - grafy do 65536 węzłów
+    INDEX_WIDTH_32 = 32   // int32_t
+} IndexWidth;
+
 // Struktura reprezentująca graf
 typedef struct {
     int max_vertices;        // Maksymalna liczba węzłów w wierszu
     int total_vertices;      // Całkowita liczba węzłów
-    int* vertex_indices;     // Tablica wszystkich indeksów węzłów
+    int* vertex_indices;     // Pierwotny indeks (z pliku wejściowego) każdego węzła
     int* row_pointers;      // Wskaźniki na pierwsze indeksy węzłów w wierszach
+    int* vertex_cols;       // Kolumna każdego węzła w macierzy (druga linia CSRRG, NULL - brak)
     int num_rows;           // Liczba wierszy
-    AdjacencyList* adj_list; // Lista sąsiedztwa dla każdego węzła
+    int64_t* xadj;          // Początki list sąsiadów w tablicy adjncy (CSR, total_vertices + 1; NULL w grafie skompresowanym)
+    void* adjncy;           // Posortowane listy sąsiadów (CSR) o elementach szerokości index_width
+                            // albo strumień list skompresowanych (adj_offsets != NULL)
+    uint32_t* adj_offsets;  // Początki list w strumieniu skompresowanym względem początku bloku węzłów
+                            // (total_vertices + 1, NULL - brak kompresji; zob. compressed_list_offset)
+    int64_t* adj_block_offsets; // Początki bloków ADJ_BLOCK_VERTICES kolejnych list w strumieniu
+    bool adj_inline_weights; // Wagi krawędzi zapisane w strumieniu skompresowanym po każdym sąsiedzie
+    IndexWidth index_width; // Szerokość identyfikatorów węzłów w adjncy
+    int64_t num_edges;      // Liczba krawędzi nieskierowanych
+    int* vwgt;              // Wagi węzłów (NULL - wagi jednostkowe)
+    int* adjwgt;            // Wagi krawędzi równoległe do adjncy (NULL - wagi jednostkowe)
+    void* mapping;          // Odwzorowany plik .csrb, w którym leżą tablice grafu (NULL - brak)
+    size_t mapping_size;    // Rozmiar odwzorowania w bajtach
 } Graph;
 
-// Struktura pomocnicza do przechowywania informacji o zysku
+// Waga węzła v (1 dla grafu bez wag węzłów)
+static inline int vertex_weight(const Graph* graph, int v) {
+    return graph->vwgt ? graph->vwgt[v] : 1;
+}
+
+// Waga krawędzi zapisanej na pozycji j tablicy adjncy (1 dla grafu bez wag krawędzi)
+static inline int edge_weight(const Graph* graph, int64_t j) {
+    return graph->adjwgt ? graph->adjwgt[j] : 1;
+}
+
+// Sąsiad zapisany na pozycji j tablicy adjncy (tylko graf nieskompresowany)
+// Gorące pętle mają wersje wyspecjalizowane dla każdej szerokości (kernels.inc)
+static inline int graph_neighbor(const Graph* graph, int64_t j) {
+    if (graph->index_width == INDEX_WIDTH_16) return ((const uint16_t*)graph->adjncy)[j];
+    return ((const int32_t*)graph->adjncy)[j];
+}
+
+// Funkcja odczytująca liczbę w kodowaniu varint (7 bitów na bajt, najmłodsze najpierw)
+// i przesuwająca kursor za nią
+static inline uint32_t varint_decode(const uint8_t** cursor) {
+    const uint8_t* p = *cursor;
+    uint32_t value = *p & 0x7F;
+    int shift = 7;
+    while (*p++ & 0x80) {
+        value |= (uint32_t)(*p & 0x7F) << shift;
+        shift += 7;
+    }
+    *cursor = p;
+    return value;
+}
+
+// Położenia list w strumieniu skompresowanym przechowywane są dwupoziomowo: 64-bitowy
+// początek każdego bloku ADJ_BLOCK_VERTICES kolejnych węzłów (adj_block_offsets)
+// oraz 32-bitowe położenie listy względem początku jej bloku (adj_offsets). Strumień
+// może więc przekraczać 4 GiB, a tablica położeń zajmuje nadal ok. 4 bajtów na węzeł
+#define ADJ_BLOCK_SHIFT 8
+#define ADJ_BLOCK_VERTICES (1 << ADJ_BLOCK_SHIFT)
+
+// Położenie listy węzła v w strumieniu skompresowanym (v == total_vertices - koniec strumienia)
+static inline int64_t compressed_list_offset(const Graph* graph, int v) {
+    return graph->adj_block_offsets[v >> ADJ_BLOCK_SHIFT] + graph->adj_offsets[v];
+}
+
+// Kursor przeglądania listy sąsiadów węzła, niezależny od reprezentacji list
+// Lista skompresowana (compress.c) to ciąg różnic kolejnych sąsiadów w kodowaniu
+// varint ze znakiem (zigzag): pierwsza względem samego węzła, kolejne względem
+// poprzedniego sąsiada; po każdej różnicy może następować waga krawędzi
+// Kursor ma tylko cztery pola, aby w gorących pętlach mieścił się w rejestrach
+typedef struct {
+    int64_t slot;   // Pozycja bieżącej krawędzi w adjncy (w liście skompresowanej - następnego bajtu)
+    int64_t end;    // Koniec listy
+    int neighbor;   // Bieżący sąsiad
+    int weight;     // Waga krawędzi do bieżącego sąsiada (tylko lista skompresowana)
+} NeighborIterator;
+
+// Funkcja ustawiająca kursor przed pierwszym sąsiadem węzła v
+static inline NeighborIterator neighbors_start(const Graph* graph, int v) {
+    NeighborIterator it;
+    if (__builtin_expect(graph->adj_offsets != NULL, 0)) {
+        it.slot = compressed_list_offset(graph, v);
+        it.end = compressed_list_offset(graph, v + 1);
+        it.neighbor = v;
+    } else {
+        it.slot = graph->xadj[v] - 1;
+        it.end = graph->xadj[v + 1];
+        it.neighbor = -1;
+    }
+    it.weight = 1;
+    return it;
+}
+
+// Funkcja przesuwająca kursor do następnego sąsiada
+// Zwraca false, gdy lista się skończyła
+static inline bool neighbors_next(const Graph* graph, NeighborIterator* it) {
+    if (__builtin_expect(graph->adj_offsets != NULL, 0)) {
+        if (it->slot >= it->end) return false;
+        const uint8_t* base = (const uint8_t*)graph->adjncy;
+        const uint8_t* cursor = base + it->slot;
+        uint32_t code = varint_decode(&cursor);
+        it->neighbor += (int)((code >> 1) ^ -(code & 1));
+        if (graph->adj_inline_weights) it->weight = (int)varint_decode(&cursor);
+        it->slot = cursor - base;
+        return true;
+    }
+    if (++it->slot >= it->end) return false;
+    it->neighbor = graph_neighbor(graph, it->slot);
+    return true;
+}
+
+// Waga krawędzi do bieżącego sąsiada kursora
+// W listach CSR odczytywana dopiero na żądanie, jak w pętlach po indeksach adjncy
+static inline int neighbor_weight(const Graph* graph, const NeighborIterator* it) {
+    return __builtin_expect(graph->adj_offsets != NULL, 0) ? it->weight : edge_weight(graph, it->slot);
+}
+
+// Pętla po sąsiadach węzła v: w treści dostępne są it.neighbor i neighbor_weight(graph, &it)
+#define FOR_EACH_NEIGHBOR(graph, v, it) \
+    for (NeighborIterator it = neighbors_start((graph), (v)); neighbors_next((graph), &it);)
+
+// Stopień węzła v (liczba sąsiadów)
+static inline int graph_degree(const Graph* graph, int v) {
+    if (graph->adj_offsets) {
+        int degree = 0;
+        FOR_EACH_NEIGHBOR(graph, v, it) degree++;
+        return degree;
+    }
+    return (int)(graph->xadj[v + 1] - graph->xadj[v]);
+}
+
+// Format pliku z wynikiem podziału
+typedef enum {
+    DIVISION_GROUPS,       // Listy węzłów kolejnych grup (tekstowo lub binarnie)
+    DIVISION_PART_VECTOR,  // Numer części każdego węzła (jak pliki .part programu METIS)
+    DIVISION_VARINT        // Listy grup jako różnice indeksów w kodowaniu varint (binarnie)
+} DivisionFormat;
+
+// Kolejność węzłów grafu (przenumerowanie dla lokalności odwołań do pamięci)
+typedef enum {
+    ORDER_NONE, // Kolejność z pliku wejściowego
+    ORDER_BFS,  // Przeszukiwanie wszerz kolejnych spójnych składowych
+    ORDER_RCM   // Odwrócona kolejność Cuthilla-McKee (od węzłów pseudoperyferyjnych)
+} VertexOrdering;
+
+// Algorytm udoskonalania podziału
+typedef enum {
+    REFINE_KL,  // Zamiany par węzłów (Kernighan-Lin), rozmiary grup pozostają równe
+    REFINE_FM,  // Przenoszenie pojedynczych węzłów (Fiduccia-Mattheyses) w granicach marginesu
+    REFINE_KWAY, // Przenoszenie węzłów brzegowych do najlepszej sąsiedniej grupy (k-drożne)
+    REFINE_LP,   // Równoległa propagacja etykiet z rozstrzyganiem konfliktów (wielowątkowe)
+    REFINE_NONE  // Bez udoskonalania (wynikiem jest podział początkowy)
+} RefinementMode;
+
+// Podział początkowy trybu jednopoziomowego
+typedef enum {
+    INITIAL_CONTIGUOUS, // Równe, ciągłe zakresy indeksów węzłów
+    INITIAL_GEOMETRIC   // Rekurencyjna bisekcja inercyjna według położenia węzłów w macierzy
+} InitialPartition;
+
+// Opcje podziału grafu
+typedef struct {
+    int num_parts;              // Liczba części
+    double margin_percentage;   // Dopuszczalna różnica wielkości części w %
+    RefinementMode refinement;  // Algorytm udoskonalania podziału
+    InitialPartition initial;   // Podział początkowy (bez podziału wielopoziomowego)
+    bool multilevel;            // Podział wielopoziomowy (zgrubianie, podział, udoskonalanie)
+    unsigned int seed;          // Ziarno generatora liczb losowych
+    int num_starts;             // Liczba niezależnych startów (zachowywany jest najlepszy wynik)
+    int num_threads;            // Liczba wątków wykonujących starty
+    bool components;            // Osobny podział każdej spójnej składowej grafu
+} PartitionOptions;
+
+// Generator liczb pseudolosowych (splitmix64) ze stanem przechowywanym przez wywołującego
+static inline uint32_t random_next(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t)((z ^ (z >> 31)) >> 32);
+}
+
+// Pula wątków wykonująca zadania w stylu "parallel for"
+typedef struct ThreadPool ThreadPool;
+typedef void (*ThreadTask)(void* arg, int index);
+
+// Kolejka kubełkowa zysków węzłów (zyski z zakresu [-max_gain, max_gain])
+typedef struct {
+    int* head;          // Pierwszy węzeł każdego kubełka (-1 dla pustego)
+    int* next;          // Następny węzeł w kubełku
+    int* prev;          // Poprzedni węzeł w kubełku
+    int* gain;          // Zysk węzła znajdującego się w kolejce
+    bool* in_queue;     // Czy węzeł znajduje się w kolejce
+    int max_gain;       // Największy obsługiwany zysk (co do wartości bezwzględnej)
+    int num_buckets;    // Liczba kubełków (2 * max_gain + 1)
+    int num_vertices;   // Liczba obsługiwanych węzłów
+    int top;            // Górne ograniczenie indeksu najwyższego niepustego kubełka
+    int size;           // Liczba węzłów w kolejce
+} GainBuckets;
+
+// Alokator strefowy (arena.c)
+// Pamięć przydzielana jest kolejno z dużych, wyrównanych bloków; zwalniana jest
+// w całości (arena_reset, arena_destroy) lub cofana do zapamiętanego znacznika
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t)1 << 20)
+#define ARENA_ALIGNMENT 64   // Wyrównanie każdego przydziału (linia pamięci podręcznej)
+
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock* first;     // Pierwszy blok listy
+    ArenaBlock* current;   // Blok, z którego przydzielana jest pamięć (NULL - żaden)
+    size_t block_size;     // Minimalny rozmiar nowego bloku
+} Arena;
+
+// Znacznik stanu areny (arena_mark, arena_release)
+typedef struct {
+    ArenaBlock* block;
+    size_t offset;
+} ArenaMark;
+
+// Kontekst jednego podziału: pamięć hierarchii grafów i pamięć robocza
+// Tablice hierarchii żyją do końca podziału, pamięć robocza cofana jest po każdym
+// etapie, a cały kontekst zwalniany jest jednym wywołaniem
 typedef struct {
-    int vertex;
-    int gain;
-} GainInfo;
+    Arena hierarchy;   // Grafy grubsze, odwzorowania węzłów i podziały poziomów
+    Arena scratch;     // Tablice pomocnicze zgrubiania i bisekcji
+} PartitionContext;
 
 // Funkcje do operacji na grafie
 Graph* create_graph(int max_vertices);
+Graph* create_graph_in_arena(Arena* arena, int max_vertices);
 void destroy_graph(Graph* graph);
 int load_graph_from_file(const char* filename, Graph** graph);
+int load_graph_from_buffer(const char* data, size_t size, Graph** graph);
+int load_graph_from_file_parallel(const char* filename, Graph** graph, int num_threads);
+int load_graph_from_buffer_parallel(const char* data, size_t size, Graph** graph, int num_threads);
 int save_graph_division(const char* filename, const Graph* graph, 
                        VertexGroup* groups, int num_groups, bool binary_output);
+int save_graph_division_format(const char* filename, const Graph* graph, VertexGroup* groups,
+                               int num_groups, DivisionFormat format, bool binary_output);
+
+// Bufor zapisu do pliku (output.c)
+// Liczby są formatowane bezpośrednio do bufora, bez wywołań funkcji biblioteki
+// standardowej dla każdego węzła
+typedef struct {
+    int fd;          // Deskryptor pliku wyjściowego
+    char* data;      // Bufor zapisu
+    size_t size;     // Liczba bajtów oczekujących w buforze
+    bool failed;     // Czy wystąpił błąd zapisu
+} OutputBuffer;
+
+int output_open(OutputBuffer* out, const char* filename);
+void output_flush(OutputBuffer* out);
+void output_string(OutputBuffer* out, const char* text);
+void output_char(OutputBuffer* out, char c);
+void output_int(OutputBuffer* out, int value);
+int output_close(OutputBuffer* out);
+
+// Binarny format grafu (.csrb) odwzorowywany w pamięci
+bool is_graph_binary_file(const char* filename);
+int save_graph_binary(const char* filename, const Graph* graph);
+int load_graph_binary(const char* filename, Graph** graph);
+int verify_graph_binary(const char* filename);
 
 // Funkcje do podziału grafu
 int divide_graph(Graph* graph, int num_parts, double margin_percentage, VertexGroup** groups);
-int calculate_edges_between_groups(const Graph* graph, const VertexGroup* groups, int num_groups);
+int partition_to_groups(const int* part_of, int num_vertices, int num_parts, VertexGroup** groups);
+void partition_options_init(PartitionOptions* options);
+int divide_graph_with_options(Graph* graph, const PartitionOptions* options, VertexGroup** groups);
+int partition_graph(const Graph* graph, const PartitionOptions* options, int* part_of);
+int partition_graph_direct(const Graph* graph, const PartitionOptions* options, int* part_of);
+void compute_part_bounds(int total, int num_parts, double margin_percentage, int* min_size, int* max_size);
+void initial_partition_contiguous(int num_vertices, int num_parts, int* part_of);
+int initial_partition_geometric(const Graph* graph, int* part_of, int num_parts);
+int initial_partition(const Graph* graph, int* part_of, const PartitionOptions* options);
+int initial_partition_growing(const Graph* graph, int* part_of, const PartitionOptions* options);
+int partition_multistart(const Graph* graph, int* part_of, const PartitionOptions* options);
+int repartition_incremental(const Graph* graph, const VertexGroup* previous, int num_previous,
+                            const PartitionOptions* options, int* part_of, int* migrated, int* added);
+
+// Spójne składowe grafu
+int find_components(const Graph* graph, int* component_of);
+int partition_components(const Graph* graph, const PartitionOptions* options, int* part_of);
+
+// Algorytmy udoskonalania podziału zapisanego w tablicy part_of
+int refine_partition(const Graph* graph, int* part_of, const PartitionOptions* options);
+int refine_kl(const Graph* graph, int* part_of, int num_parts);
+int refine_fm(const Graph* graph, int* part_of, int num_parts, double margin_percentage);
+int refine_fm_bounded(const Graph* graph, int* part_of, int num_parts,
+                      const int* min_weight, const int* max_weight);
+int refine_kway(const Graph* graph, int* part_of, int num_parts, double margin_percentage);
+int balance_kway(const Graph* graph, int* part_of, int num_parts, double margin_percentage);
+int refine_kway_bounded(const Graph* graph, int* part_of, int num_parts,
+                        const int* min_weight, const int* max_weight);
+int refine_lp(const Graph* graph, int* part_of, int num_parts, double margin_percentage, int num_threads);
+int refine_lp_bounded(const Graph* graph, int* part_of, int num_parts,
+                      const int* min_weight, const int* max_weight, int num_threads);
+
+// Podział wielopoziomowy
+int partition_multilevel(const Graph* graph, int* part_of, const PartitionOptions* options);
+
+// Funkcje pomocnicze operujące na wagach
+long total_vertex_weight(const Graph* graph);
+int max_weighted_degree(const Graph* graph);
+Graph* extract_subgraph(const Graph* graph, const int* vertices, int count, int* local_index);
+long calculate_edges_between_groups(const Graph* graph, const VertexGroup* groups, int num_groups);
 double calculate_size_difference(const VertexGroup* groups, int num_groups);
+double calculate_weight_difference(const Graph* graph, const int* part_of, int num_parts);
+
+// Gorące pętle zliczające części sąsiadów (kernels.c)
+// Każda ma wersję skalarną i wektorowe, wybierane w czasie działania według możliwości procesora
+typedef enum {
+    KERNEL_SCALAR = 0,   // Pętle skalarne
+    KERNEL_AVX2,         // AVX2: 8 pozycji listy sąsiadów naraz
+    KERNEL_AVX512        // AVX-512 (F, BW, VL): 16 pozycji listy sąsiadów naraz
+} KernelIsa;
 
-// Funkcje pomocnicze
+long calculate_cut_from_parts(const Graph* graph, const int* part_of);
+void compute_part_degrees(const Graph* graph, const int* part_of, int* internal, int* external);
+int neighbor_pair_weights(const Graph* graph, const int* part_of, int vertex, int part, int other,
+                          int* to_part, int* to_other);
+KernelIsa kernels_supported(void);
+KernelIsa kernels_select(KernelIsa isa);
+KernelIsa kernels_selected(void);
+const char* kernels_name(KernelIsa isa);
+
+// Raporty tekstowe programów wiersza poleceń (report.c, poza biblioteką libgraphpart)
 void print_graph_info(const Graph* graph);
-void print_division_info(const VertexGroup* groups, int num_groups);
+void print_division_info(const Graph* graph, const VertexGroup* groups, int num_groups);
+
+// Budowa symetrycznej reprezentacji CSR z grup krawędzi formatu CSRRG
+int build_graph_csr(Graph* graph, const int* edges, int64_t edge_count,
+                    const int64_t* group_pointers, int64_t group_count);
+void graph_set_adjacency(Graph* graph, int64_t* xadj, int32_t* adjncy);
+IndexWidth graph_index_width(int num_vertices);
 
-// Funkcje do operacji na listach sąsiedztwa
-int init_adjacency_list(AdjacencyList* list);
-int add_neighbor(AdjacencyList* list, int neighbor);
+// Kompresja list sąsiadów (różnice w kodowaniu varint)
+int graph_compress(Graph* graph);
+size_t graph_adjacency_bytes(const Graph* graph);
+
+// Przenumerowanie węzłów (RCM lub BFS) z zachowaniem pierwotnych indeksów w vertex_indices
+int graph_reorder(Graph* graph, VertexOrdering ordering);
+bool graph_is_reordered(const Graph* graph);
+double graph_average_gap(const Graph* graph);
+
+// Funkcje kolejki kubełkowej zysków
+int gain_buckets_init(GainBuckets* buckets, int num_vertices, int max_gain);
+void gain_buckets_free(GainBuckets* buckets);
+void gain_buckets_clear(GainBuckets* buckets);
+void gain_buckets_insert(GainBuckets* buckets, int vertex, int gain);
+void gain_buckets_remove(GainBuckets* buckets, int vertex);
+void gain_buckets_update(GainBuckets* buckets, int vertex, int gain);
+int gain_buckets_top(GainBuckets* buckets);
+int gain_buckets_max_gain(GainBuckets* buckets);
 
 // Funkcje pomocnicze do alokacji pamięci
 void* safe_realloc(void* ptr, size_t size);
 
+// Funkcje areny i kontekstu podziału
+void arena_init(Arena* arena, size_t block_size);
+void* arena_alloc(Arena* arena, size_t count, size_t size);
+void* arena_calloc(Arena* arena, size_t count, size_t size);
+ArenaMark arena_mark(const Arena* arena);
+void arena_release(Arena* arena, ArenaMark mark);
+void arena_reset(Arena* arena);
+void arena_destroy(Arena* arena);
+void partition_context_init(PartitionContext* context);
+void partition_context_destroy(PartitionContext* context);
+
 int* read_semicolon_separated_numbers(char* line, int* count);
 
+// Funkcje parsujące liczby bezpośrednio z bufora tekstu
+long count_separators(const char* begin, const char* end);
+long parse_numbers_into(const char* begin, const char* end, int* out, long capacity);
+int* parse_number_list(const char* begin, const char* end, int* count);
+int* parse_number_list_parallel(ThreadPool* pool, const char* begin, const char* end, int* count);
+
+// Funkcje puli wątków
+ThreadPool* thread_pool_create(int num_threads);
+void thread_pool_destroy(ThreadPool* pool);
+int thread_pool_size(const ThreadPool* pool);
+void thread_pool_run(ThreadPool* pool, int task_count, ThreadTask task, void* arg);
+
 // Funkcja do odczytu podziału grafu z pliku binarnego
 int load_graph_division(const char* filename, VertexGroup** groups, int* num_groups);
 
+// Protokół serwera podziału (protocol.c, server.c, graph_client.c)
+// Komunikaty przesyłane są przez gniazdo uniksowe jako ramki: długość treści (uint32)
+// i treść złożona z pól o stałej szerokości w kolejności bajtów komputera
+// (klient i serwer działają na tej samej maszynie)
+#define PROTOCOL_MAGIC 0x51525047u       // "GPRQ" - początek treści każdego żądania
+#define PROTOCOL_VERSION 2
+#define PROTOCOL_MAX_PATH 4096
+#define PROTOCOL_MAX_MESSAGE 256
+
+// Rodzaj żądania
+typedef enum {
+    REQUEST_PARTITION = 1,   // Podział grafu
+    REQUEST_SHUTDOWN = 2     // Zatrzymanie serwera
+} RequestType;
+
+// Żądanie podziału grafu wskazanego ścieżką
+typedef struct {
+    RequestType type;
+    PartitionOptions options;                // num_threads ustala serwer
+    DivisionFormat format;                   // Format pliku wynikowego
+    bool binary_output;                      // Binarny plik wynikowy
+    char graph_path[PROTOCOL_MAX_PATH];      // Ścieżka grafu (CSRRG lub .csrb) widziana przez serwer
+    char output_path[PROTOCOL_MAX_PATH];     // Plik wynikowy zapisywany przez serwer ("" - wynik w odpowiedzi)
+} PartitionRequest;
+
+// Odpowiedź serwera
+typedef struct {
+    int status;                              // 0 - sukces, -1 - błąd (opis w message)
+    char message[PROTOCOL_MAX_MESSAGE];
+    long cut;                                // Przekrój podziału
+    int num_vertices;                        // Liczba węzłów grafu
+    bool cache_hit;                          // Czy graf był już wczytany
+    double load_ms;                          // Czas wczytywania grafu (0 przy trafieniu)
+    double partition_ms;                     // Czas podziału
+    int* part_of;                            // Wektor części przesłany w odpowiedzi (NULL - brak)
+} PartitionResponse;
+
+int protocol_send_request(int fd, const PartitionRequest* request);
+int protocol_recv_request(int fd, PartitionRequest* request);
+int protocol_send_response(int fd, const PartitionResponse* response);
+int protocol_recv_response(int fd, PartitionResponse* response);
+int serve_command(int argc, char* argv[]);
+
+// Wsadowe wykonanie listy zadań podziału (graph_divider batch)
+int batch_command(int argc, char* argv[]);
+
+// Instrumentacja: czasy faz i liczniki pętli udoskonalania (--stats-json)
+// Budowanie z INSTRUMENT=0 usuwa wszystkie pomiary z kodu
+#ifndef INSTRUMENT
+#define INSTRUMENT 1
+#endif
+
+// Mierzone fazy programu
+typedef enum {
+    PHASE_LOAD,         // Całe wczytywanie grafu
+    PHASE_PARSE,        // Parsowanie liczb pliku tekstowego
+    PHASE_BUILD_CSR,    // Budowa reprezentacji CSR
+    PHASE_REORDER,      // Przenumerowanie węzłów (RCM lub BFS)
+    PHASE_PARTITION,    // Cały podział (z udoskonalaniem)
+    PHASE_REFINE,       // Udoskonalanie podziału
+    PHASE_CUT,          // Liczenie krawędzi między grupami
+    PHASE_SAVE,         // Zapis podziału
+    PHASE_COUNT
+} StatsPhase;
+
+// Liczniki zdarzeń w pętlach udoskonalania
+typedef enum {
+    COUNTER_KL_PASSES,
+    COUNTER_KL_PAIR_PASSES,
+    COUNTER_KL_GAIN_EVALUATIONS,
+    COUNTER_KL_SWAPS,
+    COUNTER_KL_ROLLBACKS,
+    COUNTER_FM_PASSES,
+    COUNTER_FM_MOVES,
+    COUNTER_FM_ROLLBACKS,
+    COUNTER_KWAY_PASSES,
+    COUNTER_KWAY_MOVES,
+    COUNTER_KWAY_UNBALANCED,
+    COUNTER_LP_ITERATIONS,
+    COUNTER_LP_MOVES,
+    COUNTER_COUNT
+} StatsCounter;
+
+int stats_write_json(const char* filename);
+
+#if INSTRUMENT
+void stats_enable(void);
+bool stats_enabled(void);
+long stats_phase_begin(void);
+void stats_phase_end(StatsPhase phase, long start);
+void stats_add(StatsCounter counter, long value);
+void stats_record_cut(long cut);
+
+#define STATS_ENABLED() stats_enabled()
+#define STATS_PHASE_BEGIN(start) long start = stats_phase_begin()
+#define STATS_PHASE_END(phase, start) stats_phase_end(phase, start)
+#define STATS_ADD(counter, value) stats_add(counter, value)
+#define STATS_INC(local) ((local)++)
+#define STATS_RECORD_CUT(cut) stats_record_cut(cut)
+#else
+#define STATS_ENABLED() false
+#define STATS_PHASE_BEGIN(start) ((void)0)
+#define STATS_PHASE_END(phase, start) ((void)0)
+#define STATS_ADD(counter, value) ((void)0)
+#define STATS_INC(local) ((void)0)
+#define STATS_RECORD_CUT(cut) ((void)(cut))
+#endif
+
 #endif // GRAPH_H
\ No newline at end of file
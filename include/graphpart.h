@@ -0,0 +1,90 @@
+#ifndef GRAPHPART_H
+#define GRAPHPART_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Publiczny interfejs biblioteki libgraphpart (podział grafu wewnątrz procesu)
+// Cały stan biblioteki przechowywany jest w kontekście: różne konteksty mogą być
+// używane jednocześnie z wielu wątków, jeden kontekst - przez jeden wątek naraz
+// Biblioteka niczego nie wypisuje; opis ostatniego błędu zwraca graphpart_error
+
+#define GRAPHPART_VERSION_MAJOR 1
+#define GRAPHPART_VERSION_MINOR 0
+
+// Symbole eksportowane z biblioteki współdzielonej (pozostałe są ukryte)
+#if defined(__GNUC__)
+#define GRAPHPART_API __attribute__((visibility("default")))
+#else
+#define GRAPHPART_API
+#endif
+
+// Kontekst biblioteki: wczytany graf i opis ostatniego błędu
+typedef struct GraphPartContext GraphPartContext;
+
+// Algorytm udoskonalania podziału
+typedef enum {
+    GRAPHPART_REFINE_KL,    // Zamiany par węzłów (Kernighan-Lin), rozmiary części pozostają równe
+    GRAPHPART_REFINE_FM,    // Przenoszenie pojedynczych węzłów (Fiduccia-Mattheyses)
+    GRAPHPART_REFINE_KWAY,  // Przenoszenie węzłów brzegowych do najlepszej sąsiedniej części
+    GRAPHPART_REFINE_LP     // Równoległa propagacja etykiet
+} GraphPartRefinement;
+
+// Kolejność węzłów wewnątrz kontekstu (graphpart_reorder)
+typedef enum {
+    GRAPHPART_ORDER_NONE,   // Kolejność z pliku wejściowego
+    GRAPHPART_ORDER_BFS,    // Przeszukiwanie wszerz
+    GRAPHPART_ORDER_RCM     // Odwrócona kolejność Cuthilla-McKee
+} GraphPartOrdering;
+
+// Opcje podziału (wartości domyślne ustawia graphpart_options_init)
+typedef struct {
+    int num_parts;                   // Liczba części
+    double margin_percentage;        // Dopuszczalna różnica wielkości części w %
+    GraphPartRefinement refinement;  // Algorytm udoskonalania podziału
+    bool multilevel;                 // Podział wielopoziomowy
+    unsigned int seed;               // Ziarno generatora liczb losowych
+    int num_starts;                  // Liczba niezależnych startów (zachowywany jest najlepszy)
+    int num_threads;                 // Liczba wątków
+} GraphPartOptions;
+
+GRAPHPART_API void graphpart_options_init(GraphPartOptions* options);
+
+// Tworzenie i zwalnianie kontekstu
+GRAPHPART_API GraphPartContext* graphpart_context_create(void);
+GRAPHPART_API void graphpart_context_destroy(GraphPartContext* context);
+
+// Wczytywanie grafu do kontekstu (poprzedni graf kontekstu jest zwalniany)
+// Bufor zawiera tekst w formacie CSRRG; plik może być w formacie CSRRG lub .csrb
+// Zwracają 0 w przypadku sukcesu, -1 w przypadku błędu
+GRAPHPART_API int graphpart_load_buffer(GraphPartContext* context, const char* data, size_t size,
+                                        int num_threads);
+GRAPHPART_API int graphpart_load_file(GraphPartContext* context, const char* filename, int num_threads);
+
+// Kompresja list sąsiadów wczytanego grafu (różnice w kodowaniu varint): mniej pamięci
+// kosztem dłuższego podziału, wyniki bez zmian; niedostępna dla grafów z plików .csrb
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+GRAPHPART_API int graphpart_compress(GraphPartContext* context);
+
+// Przenumerowanie węzłów wczytanego grafu dla lokalności odwołań do pamięci; tablice
+// part_of funkcji graphpart_partition i graphpart_edge_cut pozostają indeksowane
+// pierwotnymi numerami węzłów. Należy wywołać przed graphpart_compress; niedostępne
+// dla grafów z plików .csrb
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+GRAPHPART_API int graphpart_reorder(GraphPartContext* context, GraphPartOrdering ordering);
+
+// Rozmiar wczytanego grafu (0, gdy kontekst nie zawiera grafu)
+GRAPHPART_API int graphpart_num_vertices(const GraphPartContext* context);
+GRAPHPART_API long graphpart_num_edges(const GraphPartContext* context);
+
+// Podział wczytanego grafu do tablicy part_of o graphpart_num_vertices elementach
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+GRAPHPART_API int graphpart_partition(GraphPartContext* context, const GraphPartOptions* options, int* part_of);
+
+// Suma wag krawędzi między częściami podziału part_of (-1 w przypadku błędu)
+GRAPHPART_API long graphpart_edge_cut(GraphPartContext* context, const int* part_of);
+
+// Opis ostatniego błędu kontekstu (pusty napis, gdy błędu nie było)
+GRAPHPART_API const char* graphpart_error(const GraphPartContext* context);
+
+#endif // GRAPHPART_H
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/graph.h"
+
+// Blok areny; dane bloku następują bezpośrednio po nagłówku
+struct ArenaBlock {
+    ArenaBlock* next;   // Następny blok listy
+    size_t capacity;    // Rozmiar danych bloku w bajtach
+    size_t offset;      // Liczba zajętych bajtów
+};
+
+// Rozmiar nagłówka bloku zaokrąglony do wyrównania
+#define ARENA_HEADER_SIZE ((sizeof(ArenaBlock) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+// Funkcja inicjalizująca pustą arenę
+// Parametr block_size - minimalny rozmiar bloku; większe przydziały otrzymują własny blok
+void arena_init(Arena* arena, size_t block_size) {
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size > 0 ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+}
+
+// Funkcja tworząca blok o pojemności capacity bajtów
+// Zwraca blok lub NULL w przypadku błędu alokacji
+static ArenaBlock* arena_block_create(size_t capacity) {
+    void* memory = NULL;
+    if (capacity > SIZE_MAX - ARENA_HEADER_SIZE ||
+        posix_memalign(&memory, ARENA_ALIGNMENT, ARENA_HEADER_SIZE + capacity) != 0) {
+        return NULL;
+    }
+    ArenaBlock* block = (ArenaBlock*)memory;
+    block->next = NULL;
+    block->capacity = capacity;
+    block->offset = 0;
+    return block;
+}
+
+// Funkcja przydzielająca z areny tablicę count elementów rozmiaru size
+// Pamięć nie jest zerowana i jest wyrównana do ARENA_ALIGNMENT bajtów
+// Najpierw wykorzystywana jest reszta bieżącego bloku, potem bloki zachowane po
+// arena_release i arena_reset; dopiero gdy żaden nie wystarcza, tworzony jest nowy blok
+// Zwraca wskaźnik na pamięć lub NULL w przypadku błędu alokacji
+void* arena_alloc(Arena* arena, size_t count, size_t size) {
+    if (size > 0 && count > SIZE_MAX / size) return NULL;
+    size_t bytes = count * size;
+    if (bytes == 0) bytes = 1;
+    if (bytes > SIZE_MAX - ARENA_ALIGNMENT) return NULL;
+    bytes = (bytes + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    ArenaBlock* block = arena->current;
+    if (!block || block->capacity - block->offset < bytes) {
+        // Bloki za bieżącym są wolne; pomijane są bloki zbyt małe
+        ArenaBlock* next = block ? block->next : arena->first;
+        while (next && next->capacity < bytes) next = next->next;
+        if (!next) {
+            next = arena_block_create(bytes > arena->block_size ? bytes : arena->block_size);
+            if (!next) return NULL;
+            // Nowy blok wstawiany jest za bieżącym, aby kolejność listy odpowiadała
+            // kolejności przydziałów
+            if (block) {
+                next->next = block->next;
+                block->next = next;
+            } else {
+                next->next = arena->first;
+                arena->first = next;
+            }
+        }
+        next->offset = 0;
+        arena->current = next;
+        block = next;
+    }
+
+    void* result = (char*)block + ARENA_HEADER_SIZE + block->offset;
+    block->offset += bytes;
+    return result;
+}
+
+// Funkcja przydzielająca z areny wyzerowaną tablicę count elementów rozmiaru size
+// Zwraca wskaźnik na pamięć lub NULL w przypadku błędu alokacji
+void* arena_calloc(Arena* arena, size_t count, size_t size) {
+    void* result = arena_alloc(arena, count, size);
+    if (result) memset(result, 0, count * size);
+    return result;
+}
+
+// Funkcja zapamiętująca bieżący stan areny
+ArenaMark arena_mark(const Arena* arena) {
+    ArenaMark mark;
+    mark.block = arena->current;
+    mark.offset = arena->current ? arena->current->offset : 0;
+    return mark;
+}
+
+// Funkcja cofająca arenę do stanu zapamiętanego w mark
+// Pamięć przydzielona po arena_mark staje się ponownie dostępna; bloki nie są zwalniane
+void arena_release(Arena* arena, ArenaMark mark) {
+    arena->current = mark.block;
+    if (mark.block) mark.block->offset = mark.offset;
+}
+
+// Funkcja zwalniająca wszystkie przydziały areny z zachowaniem bloków do ponownego użycia
+void arena_reset(Arena* arena) {
+    arena->current = NULL;
+}
+
+// Funkcja zwalniająca wszystkie bloki areny
+void arena_destroy(Arena* arena) {
+    ArenaBlock* block = arena->first;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+// Funkcja inicjalizująca kontekst podziału z pustymi arenami
+void partition_context_init(PartitionContext* context) {
+    arena_init(&context->hierarchy, ARENA_DEFAULT_BLOCK_SIZE);
+    arena_init(&context->scratch, ARENA_DEFAULT_BLOCK_SIZE);
+}
+
+// Funkcja zwalniająca całą pamięć kontekstu podziału
+void partition_context_destroy(PartitionContext* context) {
+    arena_destroy(&context->hierarchy);
+    arena_destroy(&context->scratch);
+}
@@ -0,0 +1,444 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../include/graph.h"
+
+#define DEFAULT_JOB_WORKERS 4      // Domyślna liczba zadań wykonywanych jednocześnie
+#define JOB_FIELD_SEPARATORS " \t\r\n"
+
+// Zadanie podziału z pliku zadań wraz z wynikiem
+typedef struct {
+    int line;                    // Numer wiersza w pliku zadań
+    int graph;                   // Indeks grafu na liście różnych grafów
+    int num_parts;
+    double margin_percentage;
+    char* output_path;           // Plik wynikowy (NULL - bez zapisu)
+    const char* error;           // Opis błędu (NULL - zadanie wykonane)
+    bool partitioned;            // Czy podział się powiódł (wyniki poniżej są ważne)
+    long cut;
+    double imbalance;            // Różnica wag części w procentach
+    double partition_ms;         // Czas podziału
+    double save_ms;              // Czas zapisu wyniku
+} BatchJob;
+
+// Graf występujący w zadaniach; wczytywany raz dla wszystkich swoich zadań
+typedef struct {
+    char* path;
+    double load_ms;              // Czas wczytywania
+} BatchGraph;
+
+// Stan wykonywania zadań jednego grafu w puli wątków
+// Każdy wątek pobiera na czas zadania własny bufor części (scratch) z listy wolnych
+// buforów, więc pamięć na wynik alokowana jest raz na wątek, a nie raz na zadanie
+typedef struct {
+    const Graph* graph;
+    const PartitionOptions* options;   // Opcje wspólne (bez liczby części i marginesu)
+    DivisionFormat format;
+    bool binary_output;
+    BatchJob* jobs;
+    const int* pending;                // Numery zadań bieżącego grafu
+    int** scratch;                     // Bufory części, po jednym na wątek
+    int* free_slots;                   // Numery wolnych buforów
+    int num_free;
+    pthread_mutex_t lock;              // Ochrona listy wolnych buforów
+} BatchContext;
+
+// Funkcja zwracająca bieżący czas monotoniczny w milisekundach
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+// Funkcja zwalniająca zadania i listę grafów
+static void free_jobs(BatchJob* jobs, int num_jobs, BatchGraph* graphs, int num_graphs) {
+    for (int i = 0; i < num_jobs; i++) free(jobs[i].output_path);
+    for (int i = 0; i < num_graphs; i++) free(graphs[i].path);
+    free(jobs);
+    free(graphs);
+}
+
+// Funkcja zwracająca indeks grafu o podanej ścieżce, dopisując go do listy przy pierwszym wystąpieniu
+// Zwraca indeks lub -1 w przypadku błędu alokacji
+static int find_or_add_graph(BatchGraph** graphs, int* num_graphs, int* capacity, const char* path) {
+    for (int i = 0; i < *num_graphs; i++) {
+        if (strcmp((*graphs)[i].path, path) == 0) return i;
+    }
+    if (*num_graphs == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 8;
+        BatchGraph* grown = (BatchGraph*)realloc(*graphs, new_capacity * sizeof(BatchGraph));
+        if (!grown) return -1;
+        *graphs = grown;
+        *capacity = new_capacity;
+    }
+    BatchGraph* graph = &(*graphs)[*num_graphs];
+    memset(graph, 0, sizeof(*graph));
+    if (!(graph->path = strdup(path))) return -1;
+    return (*num_graphs)++;
+}
+
+// Funkcja wczytująca plik zadań
+// Każdy niepusty wiersz (poza komentarzami od znaku #) opisuje jedno zadanie:
+//   plik_grafu liczba_części margines [plik_wyjściowy]
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu (opis na stderr)
+static int load_jobs(const char* filename, BatchJob** jobs_out, int* num_jobs_out,
+                     BatchGraph** graphs_out, int* num_graphs_out) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Błąd: Nie udało się otworzyć pliku zadań: %s\n", filename);
+        return -1;
+    }
+
+    BatchJob* jobs = NULL;
+    BatchGraph* graphs = NULL;
+    int num_jobs = 0, job_capacity = 0;
+    int num_graphs = 0, graph_capacity = 0;
+    char* line = NULL;
+    size_t line_size = 0;
+    int line_number = 0;
+    int result = 0;
+    while (result == 0 && getline(&line, &line_size, file) != -1) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        char* state = NULL;
+        char* fields[5];
+        int num_fields = 0;
+        for (char* field = strtok_r(line, JOB_FIELD_SEPARATORS, &state); field && num_fields < 5;
+             field = strtok_r(NULL, JOB_FIELD_SEPARATORS, &state)) {
+            fields[num_fields++] = field;
+        }
+        if (num_fields == 0) continue;
+
+        char* end_parts = NULL;
+        char* end_margin = NULL;
+        long parts = num_fields >= 3 ? strtol(fields[1], &end_parts, 10) : 0;
+        double margin = num_fields >= 3 ? strtod(fields[2], &end_margin) : -1;
+        if (num_fields < 3 || num_fields > 4 || *end_parts != '\0' || *end_margin != '\0' ||
+            parts <= 0 || parts > 1 << 30 || !(margin >= 0) || isinf(margin)) {
+            fprintf(stderr, "Błąd: Niepoprawne zadanie w wierszu %d pliku %s "
+                    "(oczekiwano: plik_grafu liczba_części margines [plik_wyjściowy])\n", line_number, filename);
+            result = -1;
+            break;
+        }
+
+        if (num_jobs == job_capacity) {
+            int new_capacity = job_capacity ? job_capacity * 2 : 16;
+            BatchJob* grown = (BatchJob*)realloc(jobs, new_capacity * sizeof(BatchJob));
+            if (!grown) {
+                result = -1;
+                break;
+            }
+            jobs = grown;
+            job_capacity = new_capacity;
+        }
+        BatchJob* job = &jobs[num_jobs];
+        memset(job, 0, sizeof(*job));
+        job->line = line_number;
+        job->num_parts = (int)parts;
+        job->margin_percentage = margin;
+        job->graph = find_or_add_graph(&graphs, &num_graphs, &graph_capacity, fields[0]);
+        if (job->graph < 0 || (num_fields == 4 && !(job->output_path = strdup(fields[3])))) {
+            fprintf(stderr, "Błąd: Brak pamięci\n");
+            result = -1;
+            break;
+        }
+        num_jobs++;
+    }
+    free(line);
+    fclose(file);
+
+    if (result == 0 && num_jobs == 0) {
+        fprintf(stderr, "Błąd: Plik zadań nie zawiera żadnego zadania: %s\n", filename);
+        result = -1;
+    }
+    if (result != 0) {
+        free_jobs(jobs, num_jobs, graphs, num_graphs);
+        return -1;
+    }
+    *jobs_out = jobs;
+    *num_jobs_out = num_jobs;
+    *graphs_out = graphs;
+    *num_graphs_out = num_graphs;
+    return 0;
+}
+
+// Zadanie puli wątków: podział grafu dla jednego zadania z pliku
+static void batch_task(void* arg, int index) {
+    BatchContext* ctx = (BatchContext*)arg;
+    BatchJob* job = &ctx->jobs[ctx->pending[index]];
+    const Graph* graph = ctx->graph;
+
+    pthread_mutex_lock(&ctx->lock);
+    int slot = ctx->free_slots[--ctx->num_free];
+    pthread_mutex_unlock(&ctx->lock);
+    int* part_of = ctx->scratch[slot];
+
+    PartitionOptions options = *ctx->options;
+    options.num_parts = job->num_parts;
+    options.margin_percentage = job->margin_percentage;
+    double start = now_ms();
+    int status = partition_graph(graph, &options, part_of);
+    job->partition_ms = now_ms() - start;
+    if (status == 0) {
+        job->partitioned = true;
+        job->cut = calculate_cut_from_parts(graph, part_of);
+        job->imbalance = calculate_weight_difference(graph, part_of, job->num_parts);
+    } else {
+        job->error = "podział nie powiódł się";
+    }
+
+    if (status == 0 && job->output_path) {
+        start = now_ms();
+        VertexGroup* groups = NULL;
+        status = partition_to_groups(part_of, graph->total_vertices, job->num_parts, &groups);
+        if (status == 0) {
+            status = save_graph_division_format(job->output_path, graph, groups, job->num_parts,
+                                                ctx->format, ctx->binary_output);
+            for (int i = 0; i < job->num_parts; i++) free(groups[i].vertices);
+            free(groups);
+        }
+        job->save_ms = now_ms() - start;
+        if (status != 0) job->error = "zapis wyniku nie powiódł się";
+    }
+
+    pthread_mutex_lock(&ctx->lock);
+    ctx->free_slots[ctx->num_free++] = slot;
+    pthread_mutex_unlock(&ctx->lock);
+}
+
+// Funkcja wykonująca zadania jednego, już wczytanego grafu
+// Zadania z niepoprawną liczbą części lub wymagające nieobecnych położeń węzłów
+// oznaczane są błędem bez uruchamiania podziału
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int run_graph_jobs(BatchContext* ctx, ThreadPool* pool, int num_workers, int graph_index, int num_jobs) {
+    const Graph* graph = ctx->graph;
+    int* pending = (int*)malloc(num_jobs * sizeof(int));
+    if (!pending) return -1;
+    int count = 0;
+    for (int i = 0; i < num_jobs; i++) {
+        BatchJob* job = &ctx->jobs[i];
+        if (job->graph != graph_index) continue;
+        if (job->num_parts > graph->total_vertices) {
+            job->error = "liczba części większa od liczby węzłów";
+        } else if (ctx->options->initial == INITIAL_GEOMETRIC && !graph->vertex_cols) {
+            job->error = "graf nie zawiera położeń węzłów";
+        } else {
+            pending[count++] = i;
+        }
+    }
+
+    // Bufory wątków rosną do rozmiaru największego grafu
+    size_t size = (size_t)(graph->total_vertices > 0 ? graph->total_vertices : 1) * sizeof(int);
+    for (int i = 0; i < num_workers; i++) {
+        int* grown = (int*)realloc(ctx->scratch[i], size);
+        if (!grown) {
+            free(pending);
+            return -1;
+        }
+        ctx->scratch[i] = grown;
+    }
+
+    ctx->pending = pending;
+    thread_pool_run(pool, count, batch_task, ctx);
+    free(pending);
+    return 0;
+}
+
+// Funkcja zapisująca tabelę wyników zadań
+static void print_summary(FILE* out, const BatchJob* jobs, int num_jobs, const BatchGraph* graphs) {
+    // Nagłówek wyrównany ręcznie (polskie znaki zajmują po dwa bajty)
+    fprintf(out, "Wiersz  %-32s  Części  Margines   Przekrój  Różnica[%%]  Podział[ms]  Zapis[ms]  Wynik\n", "Graf");
+    for (int i = 0; i < num_jobs; i++) {
+        const BatchJob* job = &jobs[i];
+        const char* path = graphs[job->graph].path;
+        size_t length = strlen(path);
+        const char* name = length > 32 ? path + length - 32 : path;
+        if (!job->partitioned) {
+            fprintf(out, "%-6d  %-32s  %6d  %8.2f  %9s  %10s  %11s  %9s  błąd: %s\n", job->line, name,
+                    job->num_parts, job->margin_percentage, "-", "-", "-", "-", job->error);
+            continue;
+        }
+        fprintf(out, "%-6d  %-32s  %6d  %8.2f  %9ld  %10.2f  %11.3f  %9.3f  ", job->line, name, job->num_parts,
+                job->margin_percentage, job->cut, job->imbalance, job->partition_ms, job->save_ms);
+        if (job->error) {
+            fprintf(out, "błąd: %s\n", job->error);
+        } else if (job->imbalance > job->margin_percentage) {
+            fprintf(out, "margines przekroczony%s%s\n", job->output_path ? ", " : "",
+                    job->output_path ? job->output_path : "");
+        } else {
+            fprintf(out, "%s\n", job->output_path ? job->output_path : "ok");
+        }
+    }
+}
+
+// Podpolecenie batch: wykonanie listy zadań podziału z pliku
+// Każdy różny graf wczytywany jest raz, po czym jego zadania wykonywane są równolegle
+// w puli -w wątków (każde z -j wątkami podziału); graf zwalniany jest przed wczytaniem
+// następnego, więc w pamięci przebywa jeden graf naraz. Opcje algorytmu są wspólne dla
+// wszystkich zadań. Na koniec wypisywana jest tabela przekroju, różnicy wag i czasu
+// każdego zadania (z opcją -o także do pliku)
+// Zwraca kod wyjścia programu
+int batch_command(int argc, char* argv[]) {
+    int num_workers = DEFAULT_JOB_WORKERS;
+    const char* summary_file = NULL;
+    DivisionFormat format = DIVISION_GROUPS;
+    bool binary_output = false;
+    PartitionOptions options;
+    partition_options_init(&options);
+
+    int opt;
+    bool valid = true;
+    while (valid && (opt = getopt(argc, argv, "w:j:o:r:I:MS:s:CF:b")) != -1) {
+        switch (opt) {
+            case 'w':
+                num_workers = atoi(optarg);
+                valid = num_workers > 0;
+                break;
+            case 'j':
+                options.num_threads = atoi(optarg);
+                valid = options.num_threads > 0;
+                break;
+            case 'o':
+                summary_file = optarg;
+                break;
+            case 'r':
+                if (strcmp(optarg, "kl") == 0) options.refinement = REFINE_KL;
+                else if (strcmp(optarg, "fm") == 0) options.refinement = REFINE_FM;
+                else if (strcmp(optarg, "kway") == 0) options.refinement = REFINE_KWAY;
+                else if (strcmp(optarg, "lp") == 0) options.refinement = REFINE_LP;
+                else if (strcmp(optarg, "none") == 0) options.refinement = REFINE_NONE;
+                else valid = false;
+                break;
+            case 'I':
+                if (strcmp(optarg, "contiguous") == 0) options.initial = INITIAL_CONTIGUOUS;
+                else if (strcmp(optarg, "geometric") == 0) options.initial = INITIAL_GEOMETRIC;
+                else valid = false;
+                break;
+            case 'M':
+                options.multilevel = true;
+                break;
+            case 'S':
+                options.seed = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                options.num_starts = atoi(optarg);
+                valid = options.num_starts > 0;
+                break;
+            case 'C':
+                options.components = true;
+                break;
+            case 'F':
+                if (strcmp(optarg, "groups") == 0) format = DIVISION_GROUPS;
+                else if (strcmp(optarg, "part") == 0) format = DIVISION_PART_VECTOR;
+                else if (strcmp(optarg, "varint") == 0) format = DIVISION_VARINT;
+                else valid = false;
+                break;
+            case 'b':
+                binary_output = true;
+                break;
+            default:
+                valid = false;
+                break;
+        }
+    }
+    if (!valid) {
+        fprintf(stderr, "Błąd: Nieprawidłowa opcja polecenia batch\n");
+        return 1;
+    }
+    if (argc - optind != 1) {
+        fprintf(stderr, "Błąd: Polecenie batch wymaga pliku zadań\n");
+        return 1;
+    }
+
+    BatchJob* jobs = NULL;
+    BatchGraph* graphs = NULL;
+    int num_jobs = 0;
+    int num_graphs = 0;
+    if (load_jobs(argv[optind], &jobs, &num_jobs, &graphs, &num_graphs) != 0) return 1;
+    if (num_workers > num_jobs) num_workers = num_jobs;
+
+    BatchContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.options = &options;
+    ctx.format = format;
+    ctx.binary_output = binary_output;
+    ctx.jobs = jobs;
+    ctx.scratch = (int**)calloc(num_workers, sizeof(int*));
+    ctx.free_slots = (int*)malloc(num_workers * sizeof(int));
+    ThreadPool* pool = num_workers > 1 ? thread_pool_create(num_workers) : NULL;
+    if (!ctx.scratch || !ctx.free_slots || (num_workers > 1 && !pool)) {
+        fprintf(stderr, "Błąd: Brak pamięci\n");
+        free(ctx.scratch);
+        free(ctx.free_slots);
+        thread_pool_destroy(pool);
+        free_jobs(jobs, num_jobs, graphs, num_graphs);
+        return 1;
+    }
+    for (int i = 0; i < num_workers; i++) ctx.free_slots[i] = i;
+    ctx.num_free = num_workers;
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    printf("Zadania: %d, różne grafy: %d, wątki zadań: %d, wątki podziału: %d\n",
+           num_jobs, num_graphs, num_workers, options.num_threads);
+    double total_start = now_ms();
+    int result = 0;
+    for (int g = 0; g < num_graphs && result == 0; g++) {
+        Graph* graph = NULL;
+        double start = now_ms();
+        if (load_graph_from_file_parallel(graphs[g].path, &graph, options.num_threads) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", graphs[g].path);
+            for (int i = 0; i < num_jobs; i++) {
+                if (jobs[i].graph == g) jobs[i].error = "nie udało się wczytać grafu";
+            }
+            continue;
+        }
+        graphs[g].load_ms = now_ms() - start;
+        printf("Wczytano graf z pliku: %s (%d węzłów, %.3f ms)\n", graphs[g].path, graph->total_vertices,
+               graphs[g].load_ms);
+        fflush(stdout);
+
+        ctx.graph = graph;
+        if (run_graph_jobs(&ctx, pool, num_workers, g, num_jobs) != 0) {
+            fprintf(stderr, "Błąd: Brak pamięci\n");
+            result = 1;
+        }
+        destroy_graph(graph);
+    }
+    double total_ms = now_ms() - total_start;
+
+    int failed = 0;
+    for (int i = 0; i < num_jobs; i++) {
+        if (jobs[i].error) failed++;
+    }
+    if (result == 0) {
+        printf("\n");
+        print_summary(stdout, jobs, num_jobs, graphs);
+        printf("\nWykonano zadań: %d z %d, łączny czas: %.3f ms\n", num_jobs - failed, num_jobs, total_ms);
+        if (summary_file) {
+            FILE* out = fopen(summary_file, "w");
+            if (out) {
+                print_summary(out, jobs, num_jobs, graphs);
+                if (fclose(out) != 0) out = NULL;
+            }
+            if (!out) {
+                fprintf(stderr, "Błąd: Nie udało się zapisać podsumowania do pliku: %s\n", summary_file);
+                result = 1;
+            }
+        }
+    }
+
+    pthread_mutex_destroy(&ctx.lock);
+    thread_pool_destroy(pool);
+    for (int i = 0; i < num_workers; i++) free(ctx.scratch[i]);
+    free(ctx.scratch);
+    free(ctx.free_slots);
+    free_jobs(jobs, num_jobs, graphs, num_graphs);
+    return (result != 0 || failed > 0) ? 1 : 0;
+}
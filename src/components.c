@@ -0,0 +1,281 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "../include/graph.h"
+
+// Spójna składowa grafu
+typedef struct {
+    int first;        // Pozycja pierwszego węzła składowej w tablicy vertices
+    int count;        // Liczba węzłów
+    long weight;      // Suma wag węzłów
+    int num_parts;    // Liczba części, na które składowa jest dzielona (0 - rozmieszczana w całości)
+    int first_part;   // Numer pierwszej części przydzielonej składowej
+} Component;
+
+// Wspólny stan podziału dużych składowych wykonywanego równolegle
+// Każde zadanie dzieli jedną składową; składowe są rozłączne, więc zadania zapisują
+// rozłączne fragmenty tablic local_index i part_of
+typedef struct {
+    const Graph* graph;               // Dzielony graf (tylko do odczytu)
+    const PartitionOptions* options;  // Opcje podziału
+    const Component* components;      // Składowe
+    const int* large;                 // Numery dzielonych składowych
+    const int* vertices;              // Węzły kolejnych składowych (rosnąco w każdej składowej)
+    int* local_index;                 // Indeksy węzłów w podgrafach (poza zadaniem -1)
+    int* part_of;                     // Wynikowe przypisanie węzłów do części
+    int num_threads;                  // Liczba wątków podziału jednej składowej
+    pthread_mutex_t lock;             // Ochrona pola failed
+    bool failed;                      // Czy podział którejś składowej się nie powiódł
+} ComponentContext;
+
+// Funkcja wyznaczająca spójne składowe grafu przeszukiwaniem wszerz w czasie O(V + E)
+// Składowe numerowane są w kolejności najmniejszych indeksów ich węzłów
+// Parametr component_of - tablica wynikowa rozmiaru graph->total_vertices
+// Zwraca liczbę składowych lub -1 w przypadku błędu alokacji
+int find_components(const Graph* graph, int* component_of) {
+    int n = graph->total_vertices;
+    int* queue = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!queue) return -1;
+
+    for (int v = 0; v < n; v++) component_of[v] = -1;
+    int count = 0;
+    for (int source = 0; source < n; source++) {
+        if (component_of[source] >= 0) continue;
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = source;
+        component_of[source] = count;
+        while (head < tail) {
+            int v = queue[head++];
+            FOR_EACH_NEIGHBOR(graph, v, it) {
+                if (component_of[it.neighbor] >= 0) continue;
+                component_of[it.neighbor] = count;
+                queue[tail++] = it.neighbor;
+            }
+        }
+        count++;
+    }
+    free(queue);
+    return count;
+}
+
+// Klucz sortowania składowych
+typedef struct {
+    long weight;
+    int component;
+} ComponentKey;
+
+// Porównanie składowych malejąco według wagi (remisy - rosnąco według numeru)
+static int compare_components(const void* a, const void* b) {
+    const ComponentKey* x = (const ComponentKey*)a;
+    const ComponentKey* y = (const ComponentKey*)b;
+    if (x->weight != y->weight) return (x->weight < y->weight) - (x->weight > y->weight);
+    return (x->component > y->component) - (x->component < y->component);
+}
+
+// Zadanie puli wątków: podział jednej dużej składowej na przydzielone jej części
+// Podgraf nie zawiera położeń węzłów, więc podział geometryczny zastępowany jest
+// podziałem na ciągłe zakresy (węzły podgrafu zachowują kolejność z grafu)
+static void component_task(void* arg, int index) {
+    ComponentContext* ctx = (ComponentContext*)arg;
+    const Component* component = &ctx->components[ctx->large[index]];
+    const int* vertices = ctx->vertices + component->first;
+
+    PartitionOptions local = *ctx->options;
+    local.num_parts = component->num_parts;
+    local.num_threads = ctx->num_threads;
+    local.initial = INITIAL_CONTIGUOUS;
+
+    Graph* sub = extract_subgraph(ctx->graph, vertices, component->count, ctx->local_index);
+    int* part_of = (int*)malloc((component->count > 0 ? component->count : 1) * sizeof(int));
+    bool failed = !sub || !part_of || partition_graph_direct(sub, &local, part_of) != 0;
+    if (!failed) {
+        for (int i = 0; i < component->count; i++) {
+            ctx->part_of[vertices[i]] = component->first_part + part_of[i];
+        }
+    }
+    free(part_of);
+    destroy_graph(sub);
+
+    if (failed) {
+        pthread_mutex_lock(&ctx->lock);
+        ctx->failed = true;
+        pthread_mutex_unlock(&ctx->lock);
+    }
+}
+
+// Funkcja przydzielająca części dużym składowym (cięższym od średniej części target)
+// Kolejne części otrzymuje składowa o największej wadze przypadającej na jedną swoją część
+// (metoda D'Hondta), dopóki ta waga przekracza średnią część, a wolne części pozostają.
+// Składowe z jedną częścią i wszystkie mniejsze rozmieszczane są w całości
+// Zwraca liczbę dzielonych składowych (ich numery trafiają do large)
+static int assign_component_parts(Component* components, const int* by_weight, int num_components,
+                                  int num_parts, double target, int* large) {
+    int num_candidates = 0;
+    int used_parts = 0;
+    for (int i = 0; i < num_components && used_parts < num_parts; i++) {
+        Component* component = &components[by_weight[i]];
+        if (component->weight <= target) break;
+        component->num_parts = 1;
+        large[num_candidates++] = by_weight[i];
+        used_parts++;
+    }
+
+    while (used_parts < num_parts) {
+        int best = -1;
+        double best_share = target;
+        for (int i = 0; i < num_candidates; i++) {
+            const Component* component = &components[large[i]];
+            double share = (double)component->weight / component->num_parts;
+            if (component->num_parts < component->count && share > best_share) {
+                best = i;
+                best_share = share;
+            }
+        }
+        if (best < 0) break;
+        components[large[best]].num_parts++;
+        used_parts++;
+    }
+
+    int next_part = 0;
+    int num_large = 0;
+    for (int i = 0; i < num_candidates; i++) {
+        Component* component = &components[large[i]];
+        if (component->num_parts < 2) {
+            component->num_parts = 0;
+            continue;
+        }
+        component->first_part = next_part;
+        next_part += component->num_parts;
+        large[num_large++] = large[i];
+    }
+    return num_large;
+}
+
+// Funkcja dzieląca graf niespójny niezależnie dla każdej spójnej składowej
+// Duże składowe dzielone są równolegle (options->num_threads wątków) na przydzielone im
+// części algorytmem wybranym w opcjach, a małe składowe rozmieszczane są w całości
+// w najlżejszych częściach (od najcięższej składowej), więc przekrój nie obejmuje
+// krawędzi, które nie mogą istnieć, a udoskonalanie nie przegląda granic między składowymi
+// Graf spójny, a także graf, którego składowych nie da się rozmieścić w granicach
+// marginesu, dzielony jest tak jak bez rozkładu na składowe
+// Parametr part_of - tablica wynikowa rozmiaru graph->total_vertices
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int partition_components(const Graph* graph, const PartitionOptions* options, int* part_of) {
+    int n = graph->total_vertices;
+    int num_parts = options->num_parts;
+    int* component_of = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!component_of) return -1;
+    int num_components = find_components(graph, component_of);
+    if (num_components <= 1) {
+        free(component_of);
+        return num_components < 0 ? -1 : partition_graph_direct(graph, options, part_of);
+    }
+
+    Component* components = (Component*)calloc(num_components, sizeof(Component));
+    int* vertices = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    ComponentKey* keys = (ComponentKey*)malloc(num_components * sizeof(ComponentKey));
+    int* by_weight = (int*)malloc(num_components * sizeof(int));
+    int* large = (int*)malloc(num_components * sizeof(int));
+    int* local_index = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    long* part_weight = (long*)calloc(num_parts, sizeof(long));
+    if (!components || !vertices || !keys || !by_weight || !large || !local_index || !part_weight) {
+        free(component_of);
+        free(components);
+        free(vertices);
+        free(keys);
+        free(by_weight);
+        free(large);
+        free(local_index);
+        free(part_weight);
+        return -1;
+    }
+
+    // Węzły każdej składowej zapisywane są kolejno i rosnąco (sortowanie przez zliczanie)
+    long total_weight = 0;
+    for (int v = 0; v < n; v++) {
+        Component* component = &components[component_of[v]];
+        component->count++;
+        component->weight += vertex_weight(graph, v);
+        total_weight += vertex_weight(graph, v);
+    }
+    int position = 0;
+    for (int c = 0; c < num_components; c++) {
+        components[c].first = position;
+        position += components[c].count;
+        components[c].count = 0;
+        keys[c].weight = components[c].weight;
+        keys[c].component = c;
+    }
+    for (int v = 0; v < n; v++) {
+        Component* component = &components[component_of[v]];
+        vertices[component->first + component->count++] = v;
+    }
+    for (int v = 0; v < n; v++) local_index[v] = -1;
+
+    qsort(keys, num_components, sizeof(ComponentKey), compare_components);
+    for (int i = 0; i < num_components; i++) by_weight[i] = keys[i].component;
+    free(keys);
+    double target = (double)total_weight / num_parts;
+    int num_large = assign_component_parts(components, by_weight, num_components, num_parts, target, large);
+
+    // Podział dużych składowych; wątki dzielone są między składowe, a pojedyncza
+    // duża składowa korzysta ze wszystkich wątków
+    ComponentContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.graph = graph;
+    ctx.options = options;
+    ctx.components = components;
+    ctx.large = large;
+    ctx.vertices = vertices;
+    ctx.local_index = local_index;
+    ctx.part_of = part_of;
+    int num_threads = options->num_threads < num_large ? options->num_threads : num_large;
+    ctx.num_threads = num_threads > 1 ? 1 : options->num_threads;
+    pthread_mutex_init(&ctx.lock, NULL);
+    ThreadPool* pool = (num_threads > 1) ? thread_pool_create(num_threads) : NULL;
+    thread_pool_run(pool, num_large, component_task, &ctx);
+    thread_pool_destroy(pool);
+    pthread_mutex_destroy(&ctx.lock);
+
+    // Rozmieszczenie pozostałych składowych (od najcięższej) w najlżejszych częściach
+    if (!ctx.failed) {
+        for (int c = 0; c < num_components; c++) {
+            if (components[c].num_parts == 0) continue;
+            for (int i = 0; i < components[c].count; i++) {
+                int v = vertices[components[c].first + i];
+                part_weight[part_of[v]] += vertex_weight(graph, v);
+            }
+        }
+        for (int i = 0; i < num_components; i++) {
+            const Component* component = &components[by_weight[i]];
+            if (component->num_parts > 0) continue;
+            int lightest = 0;
+            for (int p = 1; p < num_parts; p++) {
+                if (part_weight[p] < part_weight[lightest]) lightest = p;
+            }
+            for (int j = 0; j < component->count; j++) {
+                part_of[vertices[component->first + j]] = lightest;
+            }
+            part_weight[lightest] += component->weight;
+        }
+    }
+
+    free(component_of);
+    free(components);
+    free(vertices);
+    free(by_weight);
+    free(large);
+    free(local_index);
+    free(part_weight);
+    if (ctx.failed) return -1;
+
+    // Gdy niepodzielne składowe nie mieszczą się w marginesie, graf dzielony jest w całości
+    double difference = calculate_weight_difference(graph, part_of, num_parts);
+    if (difference < 0 || difference > options->margin_percentage) {
+        return partition_graph_direct(graph, options, part_of);
+    }
+    return 0;
+}
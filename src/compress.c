@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/graph.h"
+
+// Funkcja zapisująca liczbę w kodowaniu varint (7 bitów na bajt, najmłodsze najpierw)
+// Przy out == NULL tylko zlicza bajty
+// Zwraca liczbę bajtów kodu
+static size_t varint_encode(uint8_t* out, uint32_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        if (out) out[length] = (uint8_t)(value | 0x80);
+        value >>= 7;
+        length++;
+    }
+    if (out) out[length] = (uint8_t)value;
+    return length + 1;
+}
+
+// Funkcja kodująca listę sąsiadów węzła v (format opisany przy NeighborIterator)
+// Przy out == NULL tylko zlicza bajty
+// Zwraca liczbę bajtów listy
+static size_t encode_list(const Graph* graph, int v, uint8_t* out) {
+    size_t length = 0;
+    int previous = v;
+    for (int64_t j = graph->xadj[v]; j < graph->xadj[v + 1]; j++) {
+        int neighbor = graph_neighbor(graph, j);
+        int delta = neighbor - previous;
+        uint32_t code = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+        length += varint_encode(out ? out + length : NULL, code);
+        if (graph->adjwgt) {
+            length += varint_encode(out ? out + length : NULL, (uint32_t)graph->adjwgt[j]);
+        }
+        previous = neighbor;
+    }
+    return length;
+}
+
+// Funkcja zastępująca tablice CSR grafu (xadj, adjncy, adjwgt) strumieniem list
+// skompresowanych: sąsiedzi zapisywani są jako różnice kolejnych identyfikatorów
+// w kodowaniu varint, a wagi krawędzi (jeśli są) bezpośrednio po sąsiedzie. Listy są
+// posortowane, więc w grafach o lokalnej numeracji (siatki, grafy z CSRRG) różnice
+// mieszczą się zwykle w jednym-dwóch bajtach zamiast czterech, a 64-bitową tablicę
+// xadj zastępują 32-bitowe położenia list w blokach węzłów z 64-bitowym początkiem
+// każdego bloku (compressed_list_offset), więc rozmiar strumienia nie jest ograniczony
+// Listy dekodowane są w locie przez NeighborIterator, więc wszystkie algorytmy działają
+// bez zmian i dają identyczne wyniki; kosztem jest dłuższy czas przeglądania list
+// Graf odwzorowany z pliku .csrb nie jest kompresowany (jego tablice są tylko do odczytu)
+// Zwraca 0 w przypadku sukcesu, -1 gdy graf jest już skompresowany, odwzorowany,
+// listy jednego bloku węzłów przekroczyłyby 4 GiB lub w przypadku błędu alokacji
+int graph_compress(Graph* graph) {
+    if (!graph || graph->adj_offsets || graph->mapping || !graph->xadj) return -1;
+
+    int n = graph->total_vertices;
+    int num_blocks = (n >> ADJ_BLOCK_SHIFT) + 1;
+    uint32_t* offsets = (uint32_t*)malloc(((size_t)n + 1) * sizeof(uint32_t));
+    int64_t* block_offsets = (int64_t*)malloc((size_t)num_blocks * sizeof(int64_t));
+    if (!offsets || !block_offsets) {
+        free(offsets);
+        free(block_offsets);
+        return -1;
+    }
+
+    // Pierwszy przebieg wyznacza położenie każdej listy w strumieniu
+    int64_t total = 0;
+    for (int v = 0; v <= n; v++) {
+        if ((v & (ADJ_BLOCK_VERTICES - 1)) == 0) block_offsets[v >> ADJ_BLOCK_SHIFT] = total;
+        int64_t relative = total - block_offsets[v >> ADJ_BLOCK_SHIFT];
+        if (relative > UINT32_MAX) {
+            free(offsets);
+            free(block_offsets);
+            return -1;
+        }
+        offsets[v] = (uint32_t)relative;
+        if (v < n) total += (int64_t)encode_list(graph, v, NULL);
+    }
+
+    uint8_t* stream = (uint8_t*)malloc(total > 0 ? (size_t)total : 1);
+    if (!stream) {
+        free(offsets);
+        free(block_offsets);
+        return -1;
+    }
+    graph->adj_offsets = offsets;
+    graph->adj_block_offsets = block_offsets;
+    for (int v = 0; v < n; v++) {
+        encode_list(graph, v, stream + compressed_list_offset(graph, v));
+    }
+
+    graph->adj_inline_weights = graph->adjwgt != NULL;
+    free(graph->xadj);
+    free(graph->adjncy);
+    free(graph->adjwgt);
+    graph->xadj = NULL;
+    graph->adjncy = stream;
+    graph->adjwgt = NULL;
+    return 0;
+}
+
+// Funkcja obliczająca rozmiar pamięci zajmowanej przez listy sąsiadów grafu
+// (wraz z tablicą początków list i wagami krawędzi)
+size_t graph_adjacency_bytes(const Graph* graph) {
+    size_t n = (size_t)graph->total_vertices;
+    if (graph->adj_offsets) {
+        size_t num_blocks = (n >> ADJ_BLOCK_SHIFT) + 1;
+        return (n + 1) * sizeof(uint32_t) + num_blocks * sizeof(int64_t) +
+               (size_t)compressed_list_offset(graph, (int)n);
+    }
+    if (!graph->xadj) return 0;
+
+    size_t slots = (size_t)graph->xadj[n];
+    size_t index_size = (graph->index_width == INDEX_WIDTH_16) ? sizeof(uint16_t) : sizeof(int32_t);
+    return (n + 1) * sizeof(int64_t) + slots * index_size + (graph->adjwgt ? slots * sizeof(int) : 0);
+}
@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../include/graph.h"
+
+// Funkcja budująca symetryczną reprezentację CSR grafu z grup krawędzi CSRRG
+// Grupa zaczyna się od węzła, po którym następują jego sąsiedzi; grupa g obejmuje
+// elementy edges[group_pointers[g]] .. edges[group_pointers[g + 1] - 1], a ostatnia
+// grupa sięga do końca tablicy edges
+// Pętle własne są pomijane, a powtórzone krawędzie scalane. Całość działa w O(V + E):
+// pierwszy etap rozkłada krawędzie w obu kierunkach, drugi transponuje wynik, dzięki
+// czemu listy sąsiadów są posortowane, a duplikaty sąsiadują ze sobą
+// Wymaga ustawionego graph->total_vertices
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędnych danych lub błędu alokacji
+int build_graph_csr(Graph* graph, const int* edges, int64_t edge_count,
+                    const int64_t* group_pointers, int64_t group_count) {
+    int n = graph->total_vertices;
+    if (n <= 0 || edge_count < 0 || group_count < 0) return -1;
+
+    // Sprawdzenie poprawności wskaźników grup i indeksów węzłów
+    for (int64_t g = 0; g < group_count; g++) {
+        int64_t start = group_pointers[g];
+        int64_t end = (g + 1 < group_count) ? group_pointers[g + 1] : edge_count;
+        if (start < 0 || end > edge_count || start > end) return -1;
+    }
+    for (int64_t j = 0; j < edge_count; j++) {
+        if (edges[j] < 0 || edges[j] >= n) return -1;
+    }
+
+    int64_t* degree = (int64_t*)calloc(n + 1, sizeof(int64_t));
+    int* last = (int*)malloc(n * sizeof(int));
+    if (!degree || !last) {
+        free(degree);
+        free(last);
+        return -1;
+    }
+
+    // Zliczenie krawędzi skierowanych w obu kierunkach
+    int64_t total = 0;
+    for (int64_t g = 0; g < group_count; g++) {
+        int64_t start = group_pointers[g];
+        int64_t end = (g + 1 < group_count) ? group_pointers[g + 1] : edge_count;
+        if (start == end) continue;
+        int head = edges[start];
+        for (int64_t j = start + 1; j < end; j++) {
+            if (edges[j] == head) continue;
+            degree[head + 1]++;
+            degree[edges[j] + 1]++;
+            total += 2;
+        }
+    }
+
+    // Sumy prefiksowe wyznaczają początki tymczasowych list
+    for (int v = 0; v < n; v++) {
+        degree[v + 1] += degree[v];
+    }
+
+    int* tmp_adj = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+    int64_t* fill = (int64_t*)malloc(n * sizeof(int64_t));
+    if (!tmp_adj || !fill) {
+        free(tmp_adj);
+        free(fill);
+        free(degree);
+        free(last);
+        return -1;
+    }
+    memcpy(fill, degree, n * sizeof(int64_t));
+
+    // Rozłożenie krawędzi do tymczasowych (nieposortowanych) list
+    for (int64_t g = 0; g < group_count; g++) {
+        int64_t start = group_pointers[g];
+        int64_t end = (g + 1 < group_count) ? group_pointers[g + 1] : edge_count;
+        if (start == end) continue;
+        int head = edges[start];
+        for (int64_t j = start + 1; j < end; j++) {
+            int neighbor = edges[j];
+            if (neighbor == head) continue;
+            tmp_adj[fill[head]++] = neighbor;
+            tmp_adj[fill[neighbor]++] = head;
+        }
+    }
+
+    // Transpozycja: przeglądanie węzłów rosnąco daje posortowane listy docelowe,
+    // a znacznik last[u] pomija powtórzenia tej samej krawędzi
+    int64_t* xadj = (int64_t*)calloc(n + 1, sizeof(int64_t));
+    if (!xadj) {
+        free(tmp_adj);
+        free(fill);
+        free(degree);
+        free(last);
+        return -1;
+    }
+    for (int u = 0; u < n; u++) last[u] = -1;
+    for (int v = 0; v < n; v++) {
+        for (int64_t j = degree[v]; j < degree[v + 1]; j++) {
+            int u = tmp_adj[j];
+            if (last[u] != v) {
+                last[u] = v;
+                xadj[u + 1]++;
+            }
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        xadj[v + 1] += xadj[v];
+    }
+
+    int32_t* adjncy = (int32_t*)malloc((xadj[n] > 0 ? xadj[n] : 1) * sizeof(int32_t));
+    if (!adjncy) {
+        free(xadj);
+        free(tmp_adj);
+        free(fill);
+        free(degree);
+        free(last);
+        return -1;
+    }
+    memcpy(fill, xadj, n * sizeof(int64_t));
+    for (int u = 0; u < n; u++) last[u] = -1;
+    for (int v = 0; v < n; v++) {
+        for (int64_t j = degree[v]; j < degree[v + 1]; j++) {
+            int u = tmp_adj[j];
+            if (last[u] != v) {
+                last[u] = v;
+                adjncy[fill[u]++] = v;
+            }
+        }
+    }
+
+    free(tmp_adj);
+    free(fill);
+    free(degree);
+    free(last);
+
+    graph_set_adjacency(graph, xadj, adjncy);
+    return 0;
+}
+
+// Funkcja wybierająca najwęższą szerokość identyfikatorów dla grafu o num_vertices węzłach
+IndexWidth graph_index_width(int num_vertices) {
+    return num_vertices <= 65536 ? INDEX_WIDTH_16 : INDEX_WIDTH_32;
+}
+
+// Funkcja ustawiająca listy sąsiadów grafu (przejmuje na własność xadj i adjncy)
+// Identyfikatory sąsiadów zapisywane są w najwęższym typie mieszczącym wszystkie
+// węzły grafu: dla grafów do 65536 węzłów tablica adjncy zajmuje połowę pamięci,
+// co zmniejsza ruch w pamięci we wszystkich pętlach po sąsiadach
+// Jeśli alokacja zwężonej tablicy się nie powiedzie, pozostaje szerokość 32-bitowa
+// Wymaga ustawionego graph->total_vertices
+void graph_set_adjacency(Graph* graph, int64_t* xadj, int32_t* adjncy) {
+    int n = graph->total_vertices;
+    int64_t slots = xadj[n];
+
+    void* storage = adjncy;
+    IndexWidth width = INDEX_WIDTH_32;
+    if (graph_index_width(n) == INDEX_WIDTH_16) {
+        uint16_t* narrow = (uint16_t*)malloc((slots > 0 ? slots : 1) * sizeof(uint16_t));
+        if (narrow) {
+            for (int64_t j = 0; j < slots; j++) {
+                narrow[j] = (uint16_t)adjncy[j];
+            }
+            free(adjncy);
+            storage = narrow;
+            width = INDEX_WIDTH_16;
+        }
+    }
+
+    free(graph->xadj);
+    free(graph->adjncy);
+    graph->xadj = xadj;
+    graph->adjncy = storage;
+    graph->index_width = width;
+    graph->num_edges = slots / 2;
+}
+
+// Funkcja obliczająca łączną wagę węzłów grafu
+long total_vertex_weight(const Graph* graph) {
+    if (!graph->vwgt) return graph->total_vertices;
+
+    long total = 0;
+    for (int v = 0; v < graph->total_vertices; v++) {
+        total += graph->vwgt[v];
+    }
+    return total;
+}
+
+// Funkcja obliczająca największą sumę wag krawędzi incydentnych z jednym węzłem
+// Wartość ogranicza zakres zysków w kolejkach kubełkowych
+int max_weighted_degree(const Graph* graph) {
+    int max_degree = 0;
+    for (int v = 0; v < graph->total_vertices; v++) {
+        int degree = 0;
+        if (graph->adjwgt || graph->adj_inline_weights) {
+            FOR_EACH_NEIGHBOR(graph, v, it) {
+                degree += neighbor_weight(graph, &it);
+            }
+        } else {
+            degree = graph_degree(graph, v);
+        }
+        if (degree > max_degree) max_degree = degree;
+    }
+    return max_degree;
+}
+
+// Funkcja tworząca podgraf indukowany przez węzły vertices[0..count-1]
+// Węzeł vertices[i] otrzymuje w podgrafie indeks i; wagi węzłów i krawędzi są przenoszone,
+// a krawędzie do węzłów spoza zbioru pomijane
+// Parametr local_index - tablica pomocnicza o rozmiarze graph->total_vertices wypełniona
+// wartościami -1; po zakończeniu funkcji zawiera ponownie same -1
+// Zwraca wskaźnik do podgrafu lub NULL w przypadku błędu alokacji
+Graph* extract_subgraph(const Graph* graph, const int* vertices, int count, int* local_index) {
+    Graph* sub = create_graph(graph->max_vertices);
+    if (!sub) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        local_index[vertices[i]] = i;
+    }
+
+    // Zliczenie krawędzi wewnątrz zbioru
+    int64_t edges = 0;
+    for (int i = 0; i < count; i++) {
+        int v = vertices[i];
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            if (local_index[it.neighbor] >= 0) edges++;
+        }
+    }
+
+    sub->total_vertices = count;
+    int64_t* xadj = (int64_t*)malloc((count + 1) * sizeof(int64_t));
+    int32_t* adjncy = (int32_t*)malloc((edges > 0 ? edges : 1) * sizeof(int32_t));
+    sub->vwgt = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    sub->adjwgt = (int*)malloc((edges > 0 ? edges : 1) * sizeof(int));
+    if (!xadj || !adjncy || !sub->vwgt || !sub->adjwgt) {
+        for (int i = 0; i < count; i++) local_index[vertices[i]] = -1;
+        free(xadj);
+        free(adjncy);
+        destroy_graph(sub);
+        return NULL;
+    }
+
+    // Przepisanie list sąsiadów z zachowaniem kolejności
+    int64_t position = 0;
+    xadj[0] = 0;
+    for (int i = 0; i < count; i++) {
+        int v = vertices[i];
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            int local = local_index[it.neighbor];
+            if (local < 0) continue;
+            adjncy[position] = local;
+            sub->adjwgt[position] = neighbor_weight(graph, &it);
+            position++;
+        }
+        xadj[i + 1] = position;
+        sub->vwgt[i] = vertex_weight(graph, v);
+    }
+    graph_set_adjacency(sub, xadj, adjncy);
+
+    for (int i = 0; i < count; i++) {
+        local_index[vertices[i]] = -1;
+    }
+    return sub;
+}
@@ -0,0 +1,632 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <unistd.h>
+#include "../include/graph.h"
+
+// Generator syntetycznych grafów w formacie CSRRG
+// Plik zapisywany jest strumieniowo: każda linia powstaje w jednym przejściu po węzłach,
+// a krawędzie wyznaczane są deterministycznie z ziarna i położenia węzła, dzięki czemu
+// linia wskaźników grup powstaje przez powtórne wygenerowanie tych samych krawędzi.
+// Zużycie pamięci nie zależy od liczby węzłów (dla grafu geometrycznego rośnie jak
+// pierwiastek z liczby węzłów)
+
+// Maksymalna liczba wpisów w jednej linii krawędzi; większe grafy dzielone są na
+// kolejne pary linii (sekcje), tak aby wskaźniki grup mieściły się w int
+#define SECTION_MAX_ENTRIES (1 << 30)
+
+// Największa liczba sąsiadów zapisywana w jednej grupie
+#define MAX_GROUP_SIZE 1024
+
+// Rodzina generowanych grafów
+typedef enum {
+    FAMILY_GRID,      // Siatka 2D z prostokątnymi otworami
+    FAMILY_GEOMETRIC, // Losowy graf geometryczny na kwadracie
+    FAMILY_POWER_LAW  // Graf o potęgowym rozkładzie stopni
+} GraphFamily;
+
+// Parametry generatora
+typedef struct {
+    GraphFamily family;
+    uint64_t seed;
+    // Siatka
+    int rows;            // Liczba wierszy siatki
+    int cols;            // Liczba kolumn siatki
+    int hole;            // Bok kwadratowego otworu (0 - brak otworów)
+    int period;          // Odstęp między początkami kolejnych otworów
+    // Graf geometryczny i potęgowy
+    long target_vertices; // Docelowa liczba węzłów
+    double degree;       // Średni stopień węzła
+    double gamma;        // Wykładnik rozkładu stopni (graf potęgowy)
+    int row_width;       // Liczba węzłów w wierszu macierzy (graf potęgowy)
+    // Wielkości pochodne
+    int cells;           // Liczba komórek w wierszu i kolumnie (graf geometryczny)
+    int cell_capacity;   // Największa liczba punktów w komórce (graf geometryczny)
+    double cell_mean;    // Średnia liczba punktów w komórce (graf geometryczny)
+    int num_vertices;    // Liczba węzłów (graf potęgowy)
+} Generator;
+
+// Funkcja mieszająca liczbę (krok splitmix64) - ziarno dla danego położenia
+static uint64_t mix(uint64_t seed, uint64_t value) {
+    uint64_t state = seed ^ (value * 0x9E3779B97F4A7C15ULL);
+    random_next(&state);
+    return state;
+}
+
+// Funkcja zwracająca liczbę losową z przedziału [0, 1)
+static double random_unit(uint64_t* state) {
+    return random_next(state) / 4294967296.0;
+}
+
+// --- Siatka 2D z otworami ---
+// Węzeł (r, c) istnieje, jeśli nie leży w otworze; otwory mają bok hole i powtarzają
+// się co period wierszy i kolumn. Wiersz macierzy CSRRG odpowiada wierszowi siatki,
+// a indeks kolumny - kolumnie siatki
+
+// Funkcja sprawdzająca, czy współrzędna leży w pasie otworów
+static bool grid_in_band(const Generator* gen, int x) {
+    if (gen->hole <= 0) return false;
+    int offset = (gen->period - gen->hole) / 2;
+    int phase = x % gen->period;
+    return phase >= offset && phase < offset + gen->hole;
+}
+
+// Funkcja zliczająca współrzędne z przedziału [0, x) leżące w pasie otworów
+static int grid_band_count(const Generator* gen, int x) {
+    if (gen->hole <= 0) return 0;
+    int offset = (gen->period - gen->hole) / 2;
+    int full = x / gen->period;
+    int phase = x % gen->period;
+    int partial = phase - offset;
+    if (partial < 0) partial = 0;
+    if (partial > gen->hole) partial = gen->hole;
+    return full * gen->hole + partial;
+}
+
+static bool grid_exists(const Generator* gen, int r, int c) {
+    return !(grid_in_band(gen, r) && grid_in_band(gen, c));
+}
+
+// Funkcja zwracająca liczbę istniejących węzłów w wierszu r przed kolumną c
+static int grid_prefix(const Generator* gen, int r, int c) {
+    return grid_in_band(gen, r) ? c - grid_band_count(gen, c) : c;
+}
+
+// --- Losowy graf geometryczny ---
+// Kwadrat dzielony jest na cells x cells komórek o boku równym promieniowi połączeń;
+// liczba punktów w komórce i ich położenia wynikają z ziarna komórki. Wiersz macierzy
+// odpowiada wierszowi komórek, a indeks kolumny to cell_capacity * kolumna komórki
+// + numer punktu w komórce
+
+// Funkcja wyznaczająca punkty komórki (i, j); zwraca ich liczbę
+static int geometric_cell(const Generator* gen, int i, int j, double* x, double* y) {
+    if (i < 0 || j < 0 || i >= gen->cells || j >= gen->cells) return 0;
+    uint64_t state = mix(gen->seed, (uint64_t)i * gen->cells + j);
+    int count = (int)(random_unit(&state) * (gen->cell_capacity + 1));
+    if (x) {
+        for (int k = 0; k < count; k++) {
+            x[k] = j + random_unit(&state);
+            y[k] = i + random_unit(&state);
+        }
+    }
+    return count;
+}
+
+// --- Graf potęgowy ---
+// Węzeł v łączy się z węzłami o mniejszych indeksach wybieranymi z prawdopodobieństwem
+// proporcjonalnym do (u + 1)^(-1 / (gamma - 1)) (model Chunga-Lu w wersji sekwencyjnej),
+// więc węzły o małych indeksach stają się węzłami o dużym stopniu
+
+// Funkcja losująca sąsiadów węzła v; zwraca ich liczbę (bez powtórzeń, rosnąco)
+static int power_law_neighbors(const Generator* gen, int v, int* out) {
+    if (v == 0) return 0;
+    uint64_t state = mix(gen->seed, (uint64_t)v);
+    int wanted = (int)(gen->degree / 2.0 + random_unit(&state));
+    if (wanted > v) wanted = v;
+    if (wanted > MAX_GROUP_SIZE) wanted = MAX_GROUP_SIZE;
+
+    double exponent = 1.0 - 1.0 / (gen->gamma - 1.0);
+    double top = pow((double)v + 1.0, exponent);
+    int count = 0;
+    for (int k = 0; k < wanted; k++) {
+        // Odwrócenie dystrybuanty ciągłego rozkładu na przedziale [1, v + 1)
+        double u = random_unit(&state);
+        double value = (fabs(exponent) < 1e-9) ? exp(u * log((double)v + 1.0))
+                                              : pow(1.0 + u * (top - 1.0), 1.0 / exponent);
+        int target = (int)value - 1;
+        if (target < 0) target = 0;
+        if (target >= v) target = v - 1;
+        out[count++] = target;
+    }
+
+    // Usunięcie powtórzeń (sortowanie przez wstawianie - listy są krótkie)
+    for (int a = 1; a < count; a++) {
+        int value = out[a];
+        int b = a - 1;
+        while (b >= 0 && out[b] > value) {
+            out[b + 1] = out[b];
+            b--;
+        }
+        out[b + 1] = value;
+    }
+    int unique = 0;
+    for (int a = 0; a < count; a++) {
+        if (unique == 0 || out[unique - 1] != out[a]) out[unique++] = out[a];
+    }
+    return unique;
+}
+
+// --- Układ macierzy (linie 1-3) ---
+
+// Funkcja zwracająca liczbę wierszy macierzy
+static int layout_rows(const Generator* gen) {
+    switch (gen->family) {
+        case FAMILY_GRID: return gen->rows;
+        case FAMILY_GEOMETRIC: return gen->cells;
+        case FAMILY_POWER_LAW: return (gen->num_vertices + gen->row_width - 1) / gen->row_width;
+    }
+    return 0;
+}
+
+// Funkcja zwracająca maksymalną liczbę węzłów w wierszu (linia 1)
+static int layout_width(const Generator* gen) {
+    switch (gen->family) {
+        case FAMILY_GRID: return gen->cols;
+        case FAMILY_GEOMETRIC: return gen->cells * gen->cell_capacity;
+        case FAMILY_POWER_LAW: return gen->row_width;
+    }
+    return 0;
+}
+
+// Funkcja zapisująca indeksy kolumn węzłów wiersza r (fragment linii 2)
+// Zwraca liczbę węzłów w wierszu
+static int write_row_columns(const Generator* gen, int r, OutputBuffer* out, bool* first) {
+    int count = 0;
+    switch (gen->family) {
+        case FAMILY_GRID:
+            for (int c = 0; c < gen->cols; c++) {
+                if (!grid_exists(gen, r, c)) continue;
+                if (out) {
+                    if (!*first) output_char(out, ';');
+                    output_int(out, c);
+                    *first = false;
+                }
+                count++;
+            }
+            break;
+        case FAMILY_GEOMETRIC:
+            for (int j = 0; j < gen->cells; j++) {
+                int points = geometric_cell(gen, r, j, NULL, NULL);
+                for (int k = 0; k < points && out; k++) {
+                    if (!*first) output_char(out, ';');
+                    output_int(out, j * gen->cell_capacity + k);
+                    *first = false;
+                }
+                count += points;
+            }
+            break;
+        case FAMILY_POWER_LAW: {
+            int begin = r * gen->row_width;
+            int end = begin + gen->row_width;
+            if (end > gen->num_vertices) end = gen->num_vertices;
+            for (int v = begin; v < end && out; v++) {
+                if (!*first) output_char(out, ';');
+                output_int(out, v - begin);
+                *first = false;
+            }
+            count = end - begin;
+            break;
+        }
+    }
+    return count;
+}
+
+// --- Przechodzenie po grupach krawędzi (linie 4 i 5) ---
+
+// Stan przejścia po węzłach w kolejności indeksów
+// Każdy węzeł tworzy grupę z sąsiadami o większym indeksie (siatka, graf geometryczny)
+// lub mniejszym indeksie (graf potęgowy), więc każda krawędź zapisywana jest raz
+typedef struct {
+    const Generator* gen;
+    int vertex;              // Indeks bieżącego węzła
+    int row;                 // Wiersz bieżącego węzła (siatka, graf geometryczny)
+    int col;                 // Kolumna węzła (siatka) lub komórki (graf geometryczny)
+    int point;               // Numer punktu w komórce (graf geometryczny)
+    int row_start;           // Indeks pierwszego węzła bieżącego wiersza
+    int next_row_start;      // Indeks pierwszego węzła następnego wiersza
+    int* cur_prefix;         // Początki komórek bieżącego wiersza (cells + 1)
+    int* next_prefix;        // Początki komórek następnego wiersza (cells + 1)
+    double* px;              // Punkty bieżącej komórki i jej sąsiadów "w przód"
+    double* py;
+    int* pid;                // Indeksy węzłów tych punktów
+    int cell_points;         // Liczba punktów bieżącej komórki
+    int total_points;        // Liczba punktów wraz z komórkami sąsiednimi
+} GroupWalker;
+
+// Funkcja wyznaczająca początki komórek wiersza i (sumy prefiksowe liczności)
+static void geometric_row_prefix(const Generator* gen, int i, int start, int* prefix) {
+    prefix[0] = start;
+    for (int j = 0; j < gen->cells; j++) {
+        prefix[j + 1] = prefix[j] + geometric_cell(gen, i, j, NULL, NULL);
+    }
+}
+
+// Funkcja wczytująca punkty komórki (i, j) i jej sąsiadów w przód:
+// (i, j + 1), (i + 1, j - 1), (i + 1, j), (i + 1, j + 1)
+static void geometric_load_cell(GroupWalker* w) {
+    const Generator* gen = w->gen;
+    int i = w->row;
+    int j = w->col;
+    int neighbors[5][2] = { { i, j }, { i, j + 1 }, { i + 1, j - 1 }, { i + 1, j }, { i + 1, j + 1 } };
+    w->total_points = 0;
+    for (int c = 0; c < 5; c++) {
+        int ci = neighbors[c][0];
+        int cj = neighbors[c][1];
+        int count = geometric_cell(gen, ci, cj, w->px + w->total_points, w->py + w->total_points);
+        int first = 0;
+        if (count > 0) first = (ci == i) ? w->cur_prefix[cj] : w->next_prefix[cj];
+        for (int k = 0; k < count; k++) {
+            w->pid[w->total_points + k] = first + k;
+        }
+        if (c == 0) w->cell_points = count;
+        w->total_points += count;
+    }
+}
+
+// Funkcja przechodząca do pierwszej niepustej komórki, począwszy od bieżącej
+static void geometric_seek(GroupWalker* w) {
+    const Generator* gen = w->gen;
+    while (w->row < gen->cells) {
+        if (w->col >= gen->cells) {
+            w->row++;
+            w->col = 0;
+            int* swap = w->cur_prefix;
+            w->cur_prefix = w->next_prefix;
+            w->next_prefix = swap;
+            if (w->row + 1 < gen->cells) {
+                geometric_row_prefix(gen, w->row + 1, w->cur_prefix[gen->cells], w->next_prefix);
+            }
+            continue;
+        }
+        if (w->cur_prefix[w->col + 1] > w->cur_prefix[w->col]) {
+            geometric_load_cell(w);
+            w->point = 0;
+            return;
+        }
+        w->col++;
+    }
+}
+
+// Funkcja inicjalizująca przejście od węzła 0
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int walker_init(GroupWalker* w, const Generator* gen) {
+    memset(w, 0, sizeof(*w));
+    w->gen = gen;
+    if (gen->family == FAMILY_GRID) {
+        w->next_row_start = gen->cols - grid_band_count(gen, gen->cols) * grid_in_band(gen, 0);
+        return 0;
+    }
+    if (gen->family != FAMILY_GEOMETRIC) return 0;
+
+    w->cur_prefix = (int*)malloc((gen->cells + 1) * sizeof(int));
+    w->next_prefix = (int*)malloc((gen->cells + 1) * sizeof(int));
+    w->px = (double*)malloc(5 * (gen->cell_capacity + 1) * sizeof(double));
+    w->py = (double*)malloc(5 * (gen->cell_capacity + 1) * sizeof(double));
+    w->pid = (int*)malloc(5 * (gen->cell_capacity + 1) * sizeof(int));
+    if (!w->cur_prefix || !w->next_prefix || !w->px || !w->py || !w->pid) return -1;
+    geometric_row_prefix(gen, 0, 0, w->cur_prefix);
+    if (gen->cells > 1) geometric_row_prefix(gen, 1, w->cur_prefix[gen->cells], w->next_prefix);
+    geometric_seek(w);
+    return 0;
+}
+
+// Funkcja kopiująca stan przejścia (do powtórnego wygenerowania tej samej sekcji)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int walker_copy(GroupWalker* dst, const GroupWalker* src) {
+    *dst = *src;
+    if (src->gen->family != FAMILY_GEOMETRIC) return 0;
+
+    const Generator* gen = src->gen;
+    size_t prefix_size = (gen->cells + 1) * sizeof(int);
+    size_t point_count = 5 * (size_t)(gen->cell_capacity + 1);
+    dst->cur_prefix = (int*)malloc(prefix_size);
+    dst->next_prefix = (int*)malloc(prefix_size);
+    dst->px = (double*)malloc(point_count * sizeof(double));
+    dst->py = (double*)malloc(point_count * sizeof(double));
+    dst->pid = (int*)malloc(point_count * sizeof(int));
+    if (!dst->cur_prefix || !dst->next_prefix || !dst->px || !dst->py || !dst->pid) return -1;
+    memcpy(dst->cur_prefix, src->cur_prefix, prefix_size);
+    memcpy(dst->next_prefix, src->next_prefix, prefix_size);
+    memcpy(dst->px, src->px, point_count * sizeof(double));
+    memcpy(dst->py, src->py, point_count * sizeof(double));
+    memcpy(dst->pid, src->pid, point_count * sizeof(int));
+    return 0;
+}
+
+static void walker_free(GroupWalker* w) {
+    free(w->cur_prefix);
+    free(w->next_prefix);
+    free(w->px);
+    free(w->py);
+    free(w->pid);
+}
+
+// Funkcja wyznaczająca grupę bieżącego węzła i przechodząca do następnego
+// Parametr group - tablica o rozmiarze co najmniej MAX_GROUP_SIZE + 1; group[0] to węzeł
+// Zwraca rozmiar grupy (1 - węzeł bez krawędzi w przód) lub 0 po ostatnim węźle
+static int walker_next(GroupWalker* w, int* group) {
+    const Generator* gen = w->gen;
+    int size = 0;
+
+    switch (gen->family) {
+        case FAMILY_GRID: {
+            // Pominięcie otworów i przejście do następnego wiersza
+            while (w->row < gen->rows && (w->col >= gen->cols || !grid_exists(gen, w->row, w->col))) {
+                if (w->col >= gen->cols) {
+                    w->row++;
+                    w->col = 0;
+                    w->row_start = w->next_row_start;
+                    if (w->row < gen->rows) {
+                        w->next_row_start += gen->cols - (grid_in_band(gen, w->row) ? grid_band_count(gen, gen->cols) : 0);
+                    }
+                } else {
+                    w->col++;
+                }
+            }
+            if (w->row >= gen->rows) return 0;
+
+            int r = w->row;
+            int c = w->col;
+            group[size++] = w->vertex;
+            if (c + 1 < gen->cols && grid_exists(gen, r, c + 1)) group[size++] = w->vertex + 1;
+            if (r + 1 < gen->rows && grid_exists(gen, r + 1, c)) {
+                group[size++] = w->next_row_start + grid_prefix(gen, r + 1, c);
+            }
+            w->col++;
+            w->vertex++;
+            return size;
+        }
+        case FAMILY_GEOMETRIC: {
+            if (w->row >= gen->cells) return 0;
+            int k = w->point;
+            group[size++] = w->pid[k];
+            for (int t = k + 1; t < w->total_points && size <= MAX_GROUP_SIZE; t++) {
+                double dx = w->px[t] - w->px[k];
+                double dy = w->py[t] - w->py[k];
+                if (dx * dx + dy * dy <= 1.0) group[size++] = w->pid[t];
+            }
+            w->vertex++;
+            if (++w->point >= w->cell_points) {
+                w->col++;
+                geometric_seek(w);
+            }
+            return size;
+        }
+        case FAMILY_POWER_LAW: {
+            if (w->vertex >= gen->num_vertices) return 0;
+            group[size++] = w->vertex;
+            size += power_law_neighbors(gen, w->vertex, group + 1);
+            w->vertex++;
+            return size;
+        }
+    }
+    return 0;
+}
+
+// Funkcja zapisująca graf w formacie CSRRG
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int write_graph(const Generator* gen, OutputBuffer* out, long* vertex_total, long* edge_total) {
+    int rows = layout_rows(gen);
+
+    // Linia 1: maksymalna liczba węzłów w wierszu
+    output_int(out, layout_width(gen));
+    output_char(out, '\n');
+
+    // Linia 2: indeksy kolumn wszystkich węzłów
+    bool first = true;
+    long vertices = 0;
+    for (int r = 0; r < rows; r++) {
+        vertices += write_row_columns(gen, r, out, &first);
+    }
+    output_char(out, '\n');
+    if (vertices <= 0) return -1;
+
+    // Linia 3: wskaźniki na pierwsze węzły kolejnych wierszy
+    long start = 0;
+    output_int(out, 0);
+    for (int r = 0; r < rows; r++) {
+        start += write_row_columns(gen, r, NULL, NULL);
+        output_char(out, ';');
+        output_int(out, (int)start);
+    }
+    output_char(out, '\n');
+
+    // Linie 4 i 5 (kolejne sekcje): grupy krawędzi i wskaźniki grup
+    int* group = (int*)malloc((MAX_GROUP_SIZE + 2) * sizeof(int));
+    GroupWalker walker, replay;
+    if (!group || walker_init(&walker, gen) != 0) {
+        free(group);
+        walker_free(&walker);
+        return -1;
+    }
+
+    int status = 0;
+    long edges = 0;
+    bool done = false;
+    while (!done && status == 0) {
+        if (walker_copy(&replay, &walker) != 0) {
+            walker_free(&replay);
+            status = -1;
+            break;
+        }
+
+        // Linia grup; sekcja kończy się, gdy kolejna grupa przekroczyłaby limit wpisów
+        long entries = 0;
+        long groups_written = 0;
+        int size;
+        while (entries < SECTION_MAX_ENTRIES - MAX_GROUP_SIZE - 1) {
+            size = walker_next(&walker, group);
+            if (size == 0) {
+                done = true;
+                break;
+            }
+            if (size == 1) continue;
+            for (int k = 0; k < size; k++) {
+                if (entries + k > 0) output_char(out, ';');
+                output_int(out, group[k]);
+            }
+            entries += size;
+            edges += size - 1;
+            groups_written++;
+        }
+        if (groups_written == 0) {
+            walker_free(&replay);
+            break;
+        }
+        output_char(out, '\n');
+
+        // Linia wskaźników: powtórne wygenerowanie tych samych grup
+        long position = 0;
+        for (long g = 0; g < groups_written; ) {
+            size = walker_next(&replay, group);
+            if (size <= 1) continue;
+            if (g > 0) output_char(out, ';');
+            output_int(out, (int)position);
+            position += size;
+            g++;
+        }
+        output_char(out, '\n');
+        walker_free(&replay);
+    }
+
+    walker_free(&walker);
+    free(group);
+    *vertex_total = vertices;
+    *edge_total = edges;
+    return status;
+}
+
+// Funkcja wyświetlająca instrukcję użycia programu
+static void print_usage(const char* program_name) {
+    printf("Użycie: %s -t grid|geometric|powerlaw [opcje] [-o plik_wyjściowy.csrrg]\n\n", program_name);
+    printf("Opcje wspólne:\n");
+    printf("  -o plik          Plik wyjściowy (domyślnie: standardowe wyjście)\n");
+    printf("  -S ziarno        Ziarno generatora liczb losowych (domyślnie: 1)\n");
+    printf("Siatka (grid):\n");
+    printf("  -r wiersze       Liczba wierszy siatki (domyślnie: 1000)\n");
+    printf("  -c kolumny       Liczba kolumn siatki (domyślnie: 1000)\n");
+    printf("  -H bok           Bok kwadratowych otworów (domyślnie: 0 - brak otworów)\n");
+    printf("  -P okres         Odstęp między otworami (domyślnie: 4 * bok)\n");
+    printf("Graf geometryczny (geometric) i potęgowy (powerlaw):\n");
+    printf("  -n węzły         Docelowa liczba węzłów (domyślnie: 1000000)\n");
+    printf("  -d stopień       Średni stopień węzła (domyślnie: 8)\n");
+    printf("  -g wykładnik     Wykładnik rozkładu stopni grafu potęgowego (domyślnie: 2.5)\n");
+    printf("  -w szerokość     Liczba węzłów w wierszu macierzy grafu potęgowego (domyślnie: 1000)\n");
+}
+
+// Program generujący syntetyczne grafy w formacie CSRRG do testów skalowania
+int main(int argc, char* argv[]) {
+    Generator gen;
+    memset(&gen, 0, sizeof(gen));
+    gen.family = FAMILY_GRID;
+    gen.seed = 1;
+    gen.rows = 1000;
+    gen.cols = 1000;
+    gen.period = -1;
+    gen.target_vertices = 1000000;
+    gen.degree = 8.0;
+    gen.gamma = 2.5;
+    gen.row_width = 1000;
+    const char* output_file = NULL;
+    bool family_set = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "ht:o:S:r:c:H:P:n:d:g:w:")) != -1) {
+        switch (opt) {
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            case 't':
+                family_set = true;
+                if (strcmp(optarg, "grid") == 0) {
+                    gen.family = FAMILY_GRID;
+                } else if (strcmp(optarg, "geometric") == 0) {
+                    gen.family = FAMILY_GEOMETRIC;
+                } else if (strcmp(optarg, "powerlaw") == 0) {
+                    gen.family = FAMILY_POWER_LAW;
+                } else {
+                    fprintf(stderr, "Błąd: Nieznana rodzina grafów: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'o': output_file = optarg; break;
+            case 'S': gen.seed = strtoull(optarg, NULL, 10); break;
+            case 'r': gen.rows = atoi(optarg); break;
+            case 'c': gen.cols = atoi(optarg); break;
+            case 'H': gen.hole = atoi(optarg); break;
+            case 'P': gen.period = atoi(optarg); break;
+            case 'n': gen.target_vertices = atol(optarg); break;
+            case 'd': gen.degree = atof(optarg); break;
+            case 'g': gen.gamma = atof(optarg); break;
+            case 'w': gen.row_width = atoi(optarg); break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (!family_set) {
+        fprintf(stderr, "Błąd: Nie podano rodziny grafów (-t)\n");
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (gen.period < 0) gen.period = 4 * gen.hole;
+
+    // Sprawdzenie parametrów i wyznaczenie wielkości pochodnych
+    if (gen.family == FAMILY_GRID) {
+        if (gen.rows <= 0 || gen.cols <= 0 || (long)gen.rows * gen.cols > 2147483647L ||
+            gen.hole < 0 || (gen.hole > 0 && gen.period <= gen.hole)) {
+            fprintf(stderr, "Błąd: Nieprawidłowe wymiary siatki lub otworów\n");
+            return 1;
+        }
+    } else {
+        if (gen.target_vertices <= 0 || gen.target_vertices > 2147483647L || gen.degree <= 0 ||
+            (gen.family == FAMILY_POWER_LAW && (gen.gamma <= 1.0 || gen.row_width <= 0))) {
+            fprintf(stderr, "Błąd: Nieprawidłowe parametry grafu\n");
+            return 1;
+        }
+        if (gen.family == FAMILY_GEOMETRIC) {
+            // Komórka o boku równym promieniowi: oczekiwany stopień to pi * średnia liczność
+            // komórki; liczność losowana jest równomiernie z [0, cell_capacity]
+            gen.cell_capacity = (int)lround(2.0 * gen.degree / M_PI);
+            if (gen.cell_capacity < 1) gen.cell_capacity = 1;
+            gen.cell_mean = gen.cell_capacity / 2.0;
+            gen.cells = (int)ceil(sqrt(gen.target_vertices / gen.cell_mean));
+            if (gen.cell_capacity > MAX_GROUP_SIZE / 5 ||
+                (double)gen.cells * gen.cells * gen.cell_capacity > 2147483647.0) {
+                fprintf(stderr, "Błąd: Nieprawidłowe parametry grafu\n");
+                return 1;
+            }
+        } else {
+            gen.num_vertices = (int)gen.target_vertices;
+        }
+    }
+
+    OutputBuffer out;
+    if (output_open(&out, output_file) != 0) {
+        fprintf(stderr, "Błąd: Nie można otworzyć pliku wyjściowego: %s\n", output_file);
+        return 1;
+    }
+    long vertices = 0;
+    long edges = 0;
+    int result = write_graph(&gen, &out, &vertices, &edges);
+    if (output_close(&out) != 0) result = -1;
+    if (result != 0) {
+        fprintf(stderr, "Błąd: Nie udało się wygenerować grafu\n");
+        return 1;
+    }
+    fprintf(stderr, "Wygenerowano graf: %ld węzłów, %ld krawędzi\n", vertices, edges);
+    return 0;
+}
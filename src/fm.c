@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <math.h>
+#include "../include/graph.h"
+
+// Przestrzeń robocza algorytmu FM dla jednej pary grup
+// Węzły każdej grupy tworzą dwukierunkową listę, dzięki czemu przejście dla pary
+// przegląda tylko węzły tej pary, a nie cały graf
+typedef struct {
+    int* gain;             // Zysk przeniesienia węzła do drugiej grupy pary
+    bool* locked;          // Węzły przeniesione w bieżącym przejściu
+    int* moves;            // Kolejno przeniesione węzły
+    int* member_head;      // Pierwszy węzeł listy każdej grupy (-1 - lista pusta)
+    int* member_next;      // Następny węzeł tej samej grupy
+    int* member_prev;      // Poprzedni węzeł tej samej grupy
+    GainBuckets side[2];   // Kolejki zysków dla obu grup
+    Arena memory;          // Jeden blok, z którego pochodzą tablice przestrzeni roboczej
+} FMWorkspace;
+
+// Funkcja zwalniająca przestrzeń roboczą FM
+static void fm_workspace_free(FMWorkspace* ws) {
+    arena_destroy(&ws->memory);
+    gain_buckets_free(&ws->side[0]);
+    gain_buckets_free(&ws->side[1]);
+}
+
+// Funkcja alokująca przestrzeń roboczą FM dla grafu i budująca listy węzłów grup
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int fm_workspace_init(FMWorkspace* ws, const Graph* graph, const int* part_of, int num_parts) {
+    int n = graph->total_vertices;
+    int max_degree = max_weighted_degree(graph);
+
+    memset(ws, 0, sizeof(*ws));
+    arena_init(&ws->memory, (size_t)n * (4 * sizeof(int) + sizeof(bool)) + (size_t)num_parts * sizeof(int) +
+                            6 * ARENA_ALIGNMENT);
+    ws->gain = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->locked = (bool*)arena_calloc(&ws->memory, n, sizeof(bool));
+    ws->moves = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->member_head = (int*)arena_alloc(&ws->memory, num_parts, sizeof(int));
+    ws->member_next = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->member_prev = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    int status_a = gain_buckets_init(&ws->side[0], n, max_degree);
+    int status_b = gain_buckets_init(&ws->side[1], n, max_degree);
+    if (!ws->gain || !ws->locked || !ws->moves || !ws->member_head || !ws->member_next ||
+        !ws->member_prev || status_a != 0 || status_b != 0) {
+        fm_workspace_free(ws);
+        return -1;
+    }
+
+    for (int i = 0; i < num_parts; i++) ws->member_head[i] = -1;
+    for (int v = n - 1; v >= 0; v--) {
+        int head = ws->member_head[part_of[v]];
+        ws->member_next[v] = head;
+        ws->member_prev[v] = -1;
+        if (head >= 0) ws->member_prev[head] = v;
+        ws->member_head[part_of[v]] = v;
+    }
+    return 0;
+}
+
+// Funkcja przenosząca węzeł do grupy to wraz z aktualizacją list węzłów grup
+static void fm_move_vertex(FMWorkspace* ws, int* part_of, int vertex, int to) {
+    int next = ws->member_next[vertex];
+    int prev = ws->member_prev[vertex];
+    if (prev >= 0) {
+        ws->member_next[prev] = next;
+    } else {
+        ws->member_head[part_of[vertex]] = next;
+    }
+    if (next >= 0) ws->member_prev[next] = prev;
+
+    int head = ws->member_head[to];
+    ws->member_next[vertex] = head;
+    ws->member_prev[vertex] = -1;
+    if (head >= 0) ws->member_prev[head] = vertex;
+    ws->member_head[to] = vertex;
+    part_of[vertex] = to;
+}
+
+// Funkcja sprawdzająca, czy przeniesienie węzła o wadze weight z grupy from do grupy to
+// zachowuje ograniczenia wag obu grup
+// Z grupy przekraczającej swoje maksimum dozwolone jest każde przeniesienie,
+// które nie przepełnia grupy docelowej bardziej niż źródłowej
+static bool fm_move_allowed(const int* weights, const int* min_weight, const int* max_weight,
+                            int from, int to, int weight) {
+    if (weights[from] - weight >= min_weight[from] && weights[to] + weight <= max_weight[to]) return true;
+    return weights[from] > max_weight[from] &&
+           weights[to] + weight - max_weight[to] < weights[from] - max_weight[from];
+}
+
+// Funkcja obliczająca, o ile wagi dwóch grup wykraczają poza dopuszczalne zakresy
+static long fm_violation(const int* weights, const int* min_weight, const int* max_weight) {
+    long violation = 0;
+    for (int s = 0; s < 2; s++) {
+        if (weights[s] > max_weight[s]) violation += weights[s] - max_weight[s];
+        if (weights[s] < min_weight[s]) violation += min_weight[s] - weights[s];
+    }
+    return violation;
+}
+
+// Funkcja obliczająca odchylenie wag dwóch grup od środków ich dopuszczalnych zakresów
+static long fm_imbalance(const int* weights, const int* min_weight, const int* max_weight) {
+    long imbalance = 0;
+    for (int s = 0; s < 2; s++) {
+        long target = ((long)min_weight[s] + max_weight[s]) / 2;
+        imbalance += labs(weights[s] - target);
+    }
+    return imbalance;
+}
+
+// Funkcja wykonująca jedno przejście algorytmu Fiduccii-Mattheysesa dla pary grup
+// Do kolejek trafiają tylko węzły brzegowe; w każdym kroku wybierany jest dopuszczalny
+// ruch o największym zysku (wierzchołek kolejki kubełkowej w O(1)), węzeł jest
+// blokowany, a zyski jego sąsiadów aktualizowane - sąsiedzi, którzy stali się brzegowi,
+// dołączają do kolejek. Jak w klasycznym FM przejście trwa, dopóki istnieje dopuszczalny
+// ruch, także po serii ruchów o ujemnym zysku, co pozwala wyjść z lokalnego minimum;
+// na końcu cofane są ruchy wykonane po najlepszym prefiksie. Przebieg zajmuje czas
+// liniowy względem rozmiaru pary grup
+// Parametry min_weight i max_weight - dopuszczalne wagi grup part_a i part_b
+// Zwraca łączny zysk zachowanych ruchów (0, gdy przejście niczego nie poprawiło)
+static int fm_pass(const Graph* graph, int* part_of, int* part_weights, int part_a, int part_b,
+                   const int* min_weight, const int* max_weight, FMWorkspace* ws) {
+    int parts[2] = { part_a, part_b };
+    gain_buckets_clear(&ws->side[0]);
+    gain_buckets_clear(&ws->side[1]);
+
+    // Obliczenie zysków przeniesienia dla węzłów obu grup
+    // Gdy wagi pary są poza granicami (grupa przekracza maksimum albo druga grupa nie
+    // osiąga minimum), do kolejki trafiają wszystkie węzły grupy oddającej, aby
+    // wyrównanie było możliwe także między grupami, które ze sobą nie sąsiadują
+    bool overweight[2] = {
+        part_weights[part_a] > max_weight[0] || part_weights[part_b] < min_weight[1],
+        part_weights[part_b] > max_weight[1] || part_weights[part_a] < min_weight[0]
+    };
+    for (int side = 0; side < 2; side++) {
+        int part = parts[side];
+        int other = parts[1 - side];
+        for (int v = ws->member_head[part]; v >= 0; v = ws->member_next[v]) {
+            int to_part, to_other;
+            bool boundary = neighbor_pair_weights(graph, part_of, v, part, other, &to_part, &to_other) > 0;
+            int gain = to_other - to_part;
+            ws->gain[v] = gain;
+            ws->locked[v] = false;
+            if (boundary || overweight[side]) gain_buckets_insert(&ws->side[side], v, gain);
+        }
+    }
+
+    int weights[2] = { part_weights[part_a], part_weights[part_b] };
+    int total_gain = 0;
+    int best_total_gain = 0;
+    long best_violation = fm_violation(weights, min_weight, max_weight);
+    long best_imbalance = fm_imbalance(weights, min_weight, max_weight);
+    int best_k = 0;
+    int num_moves = 0;
+
+    for (;;) {
+        // Wybór dopuszczalnego ruchu o największym zysku
+        int from = -1;
+        int best_gain = INT_MIN;
+        for (int s = 0; s < 2; s++) {
+            int gain = gain_buckets_max_gain(&ws->side[s]);
+            if (gain == INT_MIN) continue;
+            int candidate = ws->side[s].head[gain_buckets_top(&ws->side[s])];
+            if (!fm_move_allowed(weights, min_weight, max_weight, s, 1 - s, vertex_weight(graph, candidate))) {
+                continue;
+            }
+            // Przy równych zyskach przenoszony jest węzeł z cięższej grupy
+            if (gain > best_gain || (gain == best_gain && weights[s] > weights[from])) {
+                best_gain = gain;
+                from = s;
+            }
+        }
+        if (from < 0) break;
+
+        GainBuckets* queue = &ws->side[from];
+        int vertex = queue->head[gain_buckets_top(queue)];
+        int to = 1 - from;
+        int weight = vertex_weight(graph, vertex);
+        int gain = ws->gain[vertex];
+
+        // Przeniesienie i zablokowanie węzła
+        gain_buckets_remove(queue, vertex);
+        ws->locked[vertex] = true;
+        fm_move_vertex(ws, part_of, vertex, parts[to]);
+        weights[from] -= weight;
+        weights[to] += weight;
+        ws->moves[num_moves++] = vertex;
+
+        // Aktualizacja zysków niezablokowanych sąsiadów
+        FOR_EACH_NEIGHBOR(graph, vertex, it) {
+            int neighbor = it.neighbor;
+            if (ws->locked[neighbor]) continue;
+
+            int side;
+            if (part_of[neighbor] == parts[from]) {
+                ws->gain[neighbor] += 2 * neighbor_weight(graph, &it);
+                side = from;
+            } else if (part_of[neighbor] == parts[to]) {
+                ws->gain[neighbor] -= 2 * neighbor_weight(graph, &it);
+                side = to;
+            } else {
+                continue;
+            }
+            if (ws->side[side].in_queue[neighbor]) {
+                gain_buckets_update(&ws->side[side], neighbor, ws->gain[neighbor]);
+            } else {
+                gain_buckets_insert(&ws->side[side], neighbor, ws->gain[neighbor]);
+            }
+        }
+
+        total_gain += gain;
+        // Najlepszy prefiks: najpierw najmniejsze przekroczenie granic, potem największy
+        // zysk, a przy równym zysku lepsze zrównoważenie
+        long violation = fm_violation(weights, min_weight, max_weight);
+        long imbalance = fm_imbalance(weights, min_weight, max_weight);
+        if (violation < best_violation ||
+            (violation == best_violation && (total_gain > best_total_gain ||
+             (total_gain == best_total_gain && imbalance < best_imbalance)))) {
+            best_violation = violation;
+            best_total_gain = total_gain;
+            best_imbalance = imbalance;
+            best_k = num_moves;
+        }
+    }
+
+    // Cofnięcie ruchów wykonanych po najlepszym prefiksie
+    for (int i = num_moves - 1; i >= best_k; i--) {
+        int vertex = ws->moves[i];
+        int from = (part_of[vertex] == part_a) ? 0 : 1;
+        int weight = vertex_weight(graph, vertex);
+        fm_move_vertex(ws, part_of, vertex, parts[1 - from]);
+        weights[from] -= weight;
+        weights[1 - from] += weight;
+    }
+    part_weights[part_a] = weights[0];
+    part_weights[part_b] = weights[1];
+
+    STATS_ADD(COUNTER_FM_PASSES, 1);
+    STATS_ADD(COUNTER_FM_MOVES, best_k);
+    STATS_ADD(COUNTER_FM_ROLLBACKS, num_moves - best_k);
+
+    // Przejście poprawiające wyłącznie zrównoważenie również jest postępem
+    return best_k > 0 ? (best_total_gain > 0 ? best_total_gain : 1) : 0;
+}
+
+// Funkcja udoskonalająca podział algorytmem Fiduccii-Mattheysesa z osobnymi
+// ograniczeniami wagi dla każdej części
+// Dla każdej pary grup wykonywane są przejścia FM, dopóki przynoszą poprawę
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int refine_fm_bounded(const Graph* graph, int* part_of, int num_parts,
+                      const int* min_weight, const int* max_weight) {
+    int n = graph->total_vertices;
+    int* part_weights = (int*)calloc(num_parts, sizeof(int));
+    if (!part_weights) return -1;
+    for (int v = 0; v < n; v++) {
+        part_weights[part_of[v]] += vertex_weight(graph, v);
+    }
+
+    FMWorkspace ws;
+    bool* changed = (bool*)malloc(num_parts * sizeof(bool));
+    bool* dirty = (bool*)malloc(num_parts * sizeof(bool));
+    bool* adjacent = (bool*)malloc((size_t)num_parts * num_parts * sizeof(bool));
+    if (!changed || !dirty || !adjacent || fm_workspace_init(&ws, graph, part_of, num_parts) != 0) {
+        free(changed);
+        free(dirty);
+        free(adjacent);
+        free(part_weights);
+        return -1;
+    }
+    for (int i = 0; i < num_parts; i++) dirty[i] = true;
+
+    // Iteracyjna optymalizacja podziału
+    // Każde przejście obejmuje wszystkie pary grup, tak aby nadmiar wagi mógł
+    // przepłynąć do dowolnej lżejszej grupy; pary, których żadna grupa nie zmieniła
+    // się w poprzednim przejściu, są pomijane, podobnie jak niesąsiadujące pary
+    // o wagach w granicach (przejście nie ma w nich żadnego ruchu do wykonania)
+    bool improved;
+    int max_passes = (int)(5 + log(n > 1 ? n : 2) / log(2)); // Dostosowanie liczby przejść do rozmiaru grafu
+    int pass = 0;
+
+    do {
+        improved = false;
+        pass++;
+        for (int i = 0; i < num_parts; i++) changed[i] = false;
+
+        // Wyznaczenie par grup połączonych co najmniej jedną krawędzią
+        memset(adjacent, 0, (size_t)num_parts * num_parts * sizeof(bool));
+        for (int v = 0; v < n; v++) {
+            FOR_EACH_NEIGHBOR(graph, v, it) {
+                adjacent[part_of[v] * num_parts + part_of[it.neighbor]] = true;
+            }
+        }
+
+        // Przetwarzanie każdej pary grup
+        for (int i = 0; i < num_parts; i++) {
+            for (int j = i + 1; j < num_parts; j++) {
+                if (!dirty[i] && !dirty[j]) continue;
+                if (!adjacent[i * num_parts + j] &&
+                    part_weights[i] >= min_weight[i] && part_weights[i] <= max_weight[i] &&
+                    part_weights[j] >= min_weight[j] && part_weights[j] <= max_weight[j]) {
+                    continue;
+                }
+                int pair_min[2] = { min_weight[i], min_weight[j] };
+                int pair_max[2] = { max_weight[i], max_weight[j] };
+                if (fm_pass(graph, part_of, part_weights, i, j, pair_min, pair_max, &ws) > 0) {
+                    improved = true;
+                    changed[i] = true;
+                    changed[j] = true;
+                }
+            }
+        }
+        bool* swap = dirty;
+        dirty = changed;
+        changed = swap;
+    } while (improved && pass < max_passes);
+
+    fm_workspace_free(&ws);
+    free(changed);
+    free(dirty);
+    free(adjacent);
+    free(part_weights);
+    return 0;
+}
+
+// Funkcja udoskonalająca podział algorytmem Fiduccii-Mattheysesa
+// Wagi grup mogą się różnić w granicach marginesu margin_percentage
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int refine_fm(const Graph* graph, int* part_of, int num_parts, double margin_percentage) {
+    int* min_weight = (int*)malloc(num_parts * sizeof(int));
+    int* max_weight = (int*)malloc(num_parts * sizeof(int));
+    if (!min_weight || !max_weight) {
+        free(min_weight);
+        free(max_weight);
+        return -1;
+    }
+
+    int min_size, max_size;
+    compute_part_bounds((int)total_vertex_weight(graph), num_parts, margin_percentage, &min_size, &max_size);
+    for (int i = 0; i < num_parts; i++) {
+        min_weight[i] = min_size;
+        max_weight[i] = max_size;
+    }
+
+    int result = refine_fm_bounded(graph, part_of, num_parts, min_weight, max_weight);
+    free(min_weight);
+    free(max_weight);
+    return result;
+}
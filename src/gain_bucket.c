@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "../include/graph.h"
+
+// Kolejka kubełkowa zysków: każdy kubełek to dwukierunkowa lista węzłów o tym
+// samym zysku, co daje wstawianie, usuwanie i zmianę zysku w czasie O(1),
+// a wyszukanie najlepszego węzła w czasie zamortyzowanym O(1)
+
+// Funkcja inicjalizująca kolejkę dla węzłów 0..num_vertices-1 i zysków z [-max_gain, max_gain]
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int gain_buckets_init(GainBuckets* buckets, int num_vertices, int max_gain) {
+    if (max_gain < 0) max_gain = 0;
+    buckets->max_gain = max_gain;
+    buckets->num_buckets = 2 * max_gain + 1;
+    buckets->num_vertices = num_vertices;
+    buckets->head = (int*)malloc(buckets->num_buckets * sizeof(int));
+    buckets->next = (int*)malloc(num_vertices * sizeof(int));
+    buckets->prev = (int*)malloc(num_vertices * sizeof(int));
+    buckets->gain = (int*)malloc(num_vertices * sizeof(int));
+    buckets->in_queue = (bool*)malloc(num_vertices * sizeof(bool));
+    if (!buckets->head || !buckets->next || !buckets->prev || !buckets->gain || !buckets->in_queue) {
+        gain_buckets_free(buckets);
+        return -1;
+    }
+    for (int b = 0; b < buckets->num_buckets; b++) buckets->head[b] = -1;
+    memset(buckets->in_queue, 0, num_vertices * sizeof(bool));
+    buckets->top = -1;
+    buckets->size = 0;
+    return 0;
+}
+
+// Funkcja zwalniająca pamięć kolejki
+void gain_buckets_free(GainBuckets* buckets) {
+    free(buckets->head);
+    free(buckets->next);
+    free(buckets->prev);
+    free(buckets->gain);
+    free(buckets->in_queue);
+    buckets->head = buckets->next = buckets->prev = buckets->gain = NULL;
+    buckets->in_queue = NULL;
+}
+
+// Funkcja opróżniająca kolejkę
+// Przegląda tylko kubełki do najwyższego używanego i węzły, które w nich pozostały
+void gain_buckets_clear(GainBuckets* buckets) {
+    for (int b = 0; b <= buckets->top && buckets->size > 0; b++) {
+        for (int v = buckets->head[b]; v != -1; v = buckets->next[v]) {
+            buckets->in_queue[v] = false;
+            buckets->size--;
+        }
+        buckets->head[b] = -1;
+    }
+    buckets->top = -1;
+    buckets->size = 0;
+}
+
+// Funkcja wstawiająca węzeł o podanym zysku
+// Zysk spoza zakresu kolejki jest przycinany do skrajnego kubełka
+void gain_buckets_insert(GainBuckets* buckets, int vertex, int gain) {
+    if (gain > buckets->max_gain) gain = buckets->max_gain;
+    if (gain < -buckets->max_gain) gain = -buckets->max_gain;
+
+    int b = gain + buckets->max_gain;
+    buckets->gain[vertex] = gain;
+    buckets->prev[vertex] = -1;
+    buckets->next[vertex] = buckets->head[b];
+    if (buckets->head[b] != -1) buckets->prev[buckets->head[b]] = vertex;
+    buckets->head[b] = vertex;
+    buckets->in_queue[vertex] = true;
+    buckets->size++;
+    if (b > buckets->top) buckets->top = b;
+}
+
+// Funkcja usuwająca węzeł z kolejki
+void gain_buckets_remove(GainBuckets* buckets, int vertex) {
+    if (!buckets->in_queue[vertex]) return;
+
+    int b = buckets->gain[vertex] + buckets->max_gain;
+    if (buckets->prev[vertex] != -1) {
+        buckets->next[buckets->prev[vertex]] = buckets->next[vertex];
+    } else {
+        buckets->head[b] = buckets->next[vertex];
+    }
+    if (buckets->next[vertex] != -1) {
+        buckets->prev[buckets->next[vertex]] = buckets->prev[vertex];
+    }
+    buckets->in_queue[vertex] = false;
+    buckets->size--;
+}
+
+// Funkcja zmieniająca zysk węzła znajdującego się w kolejce
+void gain_buckets_update(GainBuckets* buckets, int vertex, int gain) {
+    if (!buckets->in_queue[vertex]) return;
+    gain_buckets_remove(buckets, vertex);
+    gain_buckets_insert(buckets, vertex, gain);
+}
+
+// Funkcja zwracająca indeks najwyższego niepustego kubełka lub -1 dla pustej kolejki
+// Wskaźnik top jest przesuwany w dół leniwie, stąd koszt zamortyzowany O(1)
+int gain_buckets_top(GainBuckets* buckets) {
+    if (buckets->size == 0) {
+        buckets->top = -1;
+        return -1;
+    }
+    while (buckets->top >= 0 && buckets->head[buckets->top] == -1) {
+        buckets->top--;
+    }
+    return buckets->top;
+}
+
+// Funkcja zwracająca największy zysk w kolejce lub INT_MIN dla pustej kolejki
+int gain_buckets_max_gain(GainBuckets* buckets) {
+    int top = gain_buckets_top(buckets);
+    return top < 0 ? INT_MIN : top - buckets->max_gain;
+}
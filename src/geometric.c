@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/graph.h"
+
+// Stan podziału geometrycznego
+// Węzły dzielone są rekurencyjnie wzdłuż osi głównej bezwładności (bisekcja inercyjna);
+// współrzędne to kolumna węzła (druga linia CSRRG) i numer wiersza macierzy
+typedef struct {
+    const Graph* graph;
+    const int* row_of;     // Wiersz macierzy każdego węzła
+    int* order;            // Permutacja węzłów; każdy podzakres to jedna część w budowie
+    double* key;           // Rzut węzła order[i] na oś bieżącego podziału
+    int* part_of;          // Tablica wynikowa
+} GeometricState;
+
+// Funkcja zamieniająca miejscami dwa elementy podzakresu
+static void swap_entries(GeometricState* state, int i, int j) {
+    int vertex = state->order[i];
+    state->order[i] = state->order[j];
+    state->order[j] = vertex;
+    double key = state->key[i];
+    state->key[i] = state->key[j];
+    state->key[j] = key;
+}
+
+// Funkcja sumująca wagi węzłów order[begin..end)
+static long range_weight(const GeometricState* state, int begin, int end) {
+    long weight = 0;
+    for (int i = begin; i < end; i++) weight += vertex_weight(state->graph, state->order[i]);
+    return weight;
+}
+
+// Funkcja wyznaczająca rzuty węzłów podzakresu na oś główną bezwładności
+// Oś jest wektorem własnym największej wartości własnej macierzy kowariancji
+// współrzędnych (ważonych wagami węzłów); dla siatek prostokątnych pokrywa się
+// z dłuższym bokiem, więc bisekcja współrzędnościowa jest przypadkiem szczególnym
+static void project_on_principal_axis(GeometricState* state, int begin, int end) {
+    const Graph* graph = state->graph;
+    double sum_w = 0.0, sum_x = 0.0, sum_y = 0.0;
+    for (int i = begin; i < end; i++) {
+        int v = state->order[i];
+        double w = vertex_weight(graph, v);
+        sum_w += w;
+        sum_x += w * graph->vertex_cols[v];
+        sum_y += w * state->row_of[v];
+    }
+    double cx = sum_w > 0 ? sum_x / sum_w : 0.0;
+    double cy = sum_w > 0 ? sum_y / sum_w : 0.0;
+
+    double sxx = 0.0, syy = 0.0, sxy = 0.0;
+    for (int i = begin; i < end; i++) {
+        int v = state->order[i];
+        double w = vertex_weight(graph, v);
+        double dx = graph->vertex_cols[v] - cx;
+        double dy = state->row_of[v] - cy;
+        sxx += w * dx * dx;
+        syy += w * dy * dy;
+        sxy += w * dx * dy;
+    }
+    double angle = 0.5 * atan2(2.0 * sxy, sxx - syy);
+    double ax = cos(angle);
+    double ay = sin(angle);
+
+    for (int i = begin; i < end; i++) {
+        int v = state->order[i];
+        state->key[i] = ax * graph->vertex_cols[v] + ay * state->row_of[v];
+    }
+}
+
+// Funkcja porządkująca podzakres tak, aby węzły o najmniejszych rzutach i łącznej
+// wadze możliwie bliskiej target znalazły się na jego początku
+// Wybór ważonej mediany (quickselect z podziałem na trzy grupy) działa w oczekiwanym
+// czasie liniowym; pełne sortowanie nie jest potrzebne
+// Zwraca indeks pierwszego węzła drugiej połowy
+static int split_by_weight(GeometricState* state, int begin, int end, long target) {
+    int lo = begin;
+    int hi = end;
+    long before = 0;   // Waga węzłów order[begin..lo), które na pewno trafiają do pierwszej połowy
+
+    while (hi - lo > 1) {
+        double a = state->key[lo];
+        double b = state->key[lo + (hi - lo) / 2];
+        double c = state->key[hi - 1];
+        double pivot = (a < b) ? ((b < c) ? b : (a < c ? c : a)) : ((a < c) ? a : (b < c ? c : b));
+
+        int lt = lo;
+        int i = lo;
+        int gt = hi;
+        while (i < gt) {
+            if (state->key[i] < pivot) swap_entries(state, lt++, i++);
+            else if (state->key[i] > pivot) swap_entries(state, i, --gt);
+            else i++;
+        }
+
+        long less = range_weight(state, lo, lt);
+        if (before + less >= target) {
+            hi = lt;
+            continue;
+        }
+        long equal = range_weight(state, lt, gt);
+        before += less;
+        lo = lt;
+        if (before + equal >= target) {
+            hi = gt;
+            break;
+        }
+        before += equal;
+        lo = gt;
+    }
+
+    // Pozostałe węzły mają równe rzuty (lub jest co najwyżej jeden) - dobór liczby
+    // węzłów najbliższej docelowej wadze
+    int split = lo;
+    while (split < hi) {
+        long w = vertex_weight(state->graph, state->order[split]);
+        if (before + w > target && before + w - target > target - before) break;
+        before += w;
+        split++;
+    }
+    return split;
+}
+
+// Funkcja dzieląca węzły order[begin..end) na num_parts części o numerach od first_part
+// Wagi połówek są proporcjonalne do liczby przypadających na nie części
+static void bisect_recursive(GeometricState* state, int begin, int end, int first_part, int num_parts) {
+    if (num_parts == 1 || end - begin <= 1) {
+        for (int i = begin; i < end; i++) state->part_of[state->order[i]] = first_part;
+        return;
+    }
+
+    int left_parts = num_parts / 2;
+    long total = range_weight(state, begin, end);
+    long target = (long)((double)total * left_parts / num_parts + 0.5);
+
+    project_on_principal_axis(state, begin, end);
+    int split = split_by_weight(state, begin, end, target);
+
+    // Każda część powinna otrzymać co najmniej jeden węzeł
+    if (end - begin >= num_parts) {
+        if (split - begin < left_parts) split = begin + left_parts;
+        if (end - split < num_parts - left_parts) split = end - (num_parts - left_parts);
+    }
+
+    bisect_recursive(state, begin, split, first_part, left_parts);
+    bisect_recursive(state, split, end, first_part + left_parts, num_parts - left_parts);
+}
+
+// Funkcja wyznaczająca podział geometryczny na podstawie położenia węzłów w macierzy
+// (rekurencyjna bisekcja inercyjna); nie przegląda krawędzi grafu, a jej koszt to
+// O(n log num_parts). Wynik może być podziałem końcowym lub początkowym dla udoskonalania
+// Zwraca 0 w przypadku sukcesu, -1 gdy graf nie ma współrzędnych lub w przypadku błędu alokacji
+int initial_partition_geometric(const Graph* graph, int* part_of, int num_parts) {
+    if (!graph->vertex_cols || !graph->row_pointers || num_parts <= 0) return -1;
+
+    int n = graph->total_vertices;
+    int* row_of = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+    int* order = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    double* key = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+    if (!row_of || !order || !key) {
+        free(row_of);
+        free(order);
+        free(key);
+        return -1;
+    }
+
+    // Węzły zapisane są wierszami: row_pointers wskazuje pierwszy węzeł każdego wiersza
+    for (int r = 0; r < graph->num_rows; r++) {
+        int first = graph->row_pointers[r] > 0 ? graph->row_pointers[r] : 0;
+        int last = graph->row_pointers[r + 1] < n ? graph->row_pointers[r + 1] : n;
+        for (int v = first; v < last; v++) row_of[v] = r;
+    }
+    // Wiersze opisane są pierwotnymi indeksami; po przenumerowaniu (graph_reorder)
+    // wiersz węzła odczytywany jest przez jego pierwotny indeks
+    if (graph->vertex_indices && graph_is_reordered(graph)) {
+        for (int v = 0; v < n; v++) order[v] = row_of[graph->vertex_indices[v]];
+        int* swap = row_of;
+        row_of = order;
+        order = swap;
+    }
+    for (int v = 0; v < n; v++) order[v] = v;
+
+    GeometricState state = { graph, row_of, order, key, part_of };
+    bisect_recursive(&state, 0, n, 0, num_parts);
+
+    free(row_of);
+    free(order);
+    free(key);
+    return 0;
+}
@@ -2,275 +2,419 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <math.h>
 #include <ctype.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "../include/graph.h"
 
-// Stałe definiujące początkowe rozmiary i limity
-#define INITIAL_CAPACITY 16    // Początkowy rozmiar tablicy sąsiadów
-#define MAX_LINE_LENGTH 1024   // Maksymalna długość linii w pliku
+// Minimalny rozmiar pliku, od którego wczytywanie odbywa się wielowątkowo
+#define PARALLEL_LOAD_MIN_SIZE (256 * 1024)
+
+// Funkcja inicjalizująca pola pustego grafu
+static void init_graph(Graph* graph, int max_vertices) {
+    graph->max_vertices = max_vertices;  // Maksymalna liczba wierzchołków w wierszu
+    graph->total_vertices = 0;           // Aktualna liczba wierzchołków
+    graph->num_rows = 0;                 // Liczba wierszy w macierzy
+    graph->vertex_indices = NULL;        // Tablica indeksów wierzchołków
+    graph->row_pointers = NULL;          // Wskaźniki do wierszy macierzy
+    graph->vertex_cols = NULL;           // Kolumny wierzchołków w macierzy
+    graph->xadj = NULL;                  // Początki list sąsiadów (CSR)
+    graph->adjncy = NULL;                // Listy sąsiadów (CSR)
+    graph->adj_offsets = NULL;           // Brak kompresji list sąsiadów
+    graph->adj_block_offsets = NULL;
+    graph->adj_inline_weights = false;
+    graph->index_width = INDEX_WIDTH_32; // Szerokość identyfikatorów w adjncy
+    graph->num_edges = 0;                // Liczba krawędzi
+    graph->vwgt = NULL;                  // Wagi węzłów (jednostkowe)
+    graph->adjwgt = NULL;                // Wagi krawędzi (jednostkowe)
+    graph->mapping = NULL;               // Brak odwzorowanego pliku .csrb
+    graph->mapping_size = 0;
+}
 
 // Funkcja tworząca nowy graf o określonej maksymalnej liczbie wierzchołków
-// Parametr max_vertices określa maksymalną liczbę wierzchołków, które może zawierać graf
+// Parametr max_vertices określa maksymalną liczbę wierzchołków w wierszu macierzy
 // Zwraca wskaźnik do nowo utworzonego grafu lub NULL w przypadku błędu alokacji
 Graph* create_graph(int max_vertices) {
     Graph* graph = (Graph*)malloc(sizeof(Graph));
     if (!graph) return NULL;
+    init_graph(graph, max_vertices);
+    return graph;
+}
 
-    // Inicjalizacja pól struktury grafu
-    graph->max_vertices = max_vertices;  // Maksymalna liczba wierzchołków
-    graph->total_vertices = 0;           // Aktualna liczba wierzchołków
-    graph->num_rows = 0;                 // Liczba wierszy w macierzy sąsiedztwa
-    graph->vertex_indices = NULL;        // Tablica indeksów wierzchołków
-    graph->row_pointers = NULL;          // Wskaźniki do wierszy w formacie CSR
-    graph->adj_list = NULL;              // Listy sąsiedztwa dla każdego wierzchołka
-
+// Funkcja tworząca pusty graf w arenie
+// Struktura i tablice takiego grafu zwalniane są razem z areną, więc nie należy
+// wywoływać dla niego destroy_graph
+Graph* create_graph_in_arena(Arena* arena, int max_vertices) {
+    Graph* graph = (Graph*)arena_alloc(arena, 1, sizeof(Graph));
+    if (!graph) return NULL;
+    init_graph(graph, max_vertices);
     return graph;
 }
 
 // Funkcja zwalniająca pamięć zajmowaną przez graf
-// Rekurencyjnie zwalnia wszystkie struktury danych związane z grafem
+// Tablice grafu wczytanego z pliku .csrb wskazują do odwzorowania, więc zamiast
+// ich zwalniania odwzorowanie jest usuwane w całości
 void destroy_graph(Graph* graph) {
     if (!graph) return;
 
-    // Zwolnienie tablicy indeksów wierzchołków
-    if (graph->vertex_indices) free(graph->vertex_indices);
-    // Zwolnienie wskaźników do wierszy
-    if (graph->row_pointers) free(graph->row_pointers);
-    
-    // Zwolnienie list sąsiedztwa dla każdego wierzchołka
-    if (graph->adj_list) {
-        for (int i = 0; i < graph->total_vertices; i++) {
-            if (graph->adj_list[i].neighbors) {
-                free(graph->adj_list[i].neighbors);
+    if (graph->mapping) {
+        munmap(graph->mapping, graph->mapping_size);
+        free(graph);
+        return;
+    }
+    free(graph->vertex_indices);
+    free(graph->row_pointers);
+    free(graph->vertex_cols);
+    free(graph->xadj);
+    free(graph->adjncy);
+    free(graph->adj_offsets);
+    free(graph->adj_block_offsets);
+    free(graph->vwgt);
+    free(graph->adjwgt);
+    free(graph);
+}
+
+// Funkcja dopisująca sekcję krawędzi (linia grup i linia wskaźników grup) do
+// zbiorczych tablic; wskaźniki kolejnych sekcji są przesuwane o dotychczasową długość
+// Pojedyncza sekcja mieści się w int, ale łączna liczba wpisów wszystkich sekcji może
+// przekraczać INT_MAX, dlatego liczniki i wskaźniki zbiorcze są 64-bitowe
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędnych danych, przepełnienia rozmiaru
+// lub błędu alokacji
+static int append_edge_section(int** edges, int64_t* edge_count, int64_t** pointers, int64_t* pointer_count,
+                               const int* section_edges, int section_edge_count,
+                               const int* section_pointers, int section_pointer_count) {
+    if (section_edge_count < 0 || section_pointer_count < 0 ||
+        *edge_count > (int64_t)(SIZE_MAX / sizeof(int)) - section_edge_count - 1 ||
+        *pointer_count > (int64_t)(SIZE_MAX / sizeof(int64_t)) - section_pointer_count - 1) {
+        return -1;
+    }
+    int* new_edges = (int*)realloc(*edges, (size_t)(*edge_count + section_edge_count + 1) * sizeof(int));
+    if (!new_edges) return -1;
+    *edges = new_edges;
+    int64_t* new_pointers = (int64_t*)realloc(*pointers,
+                                              (size_t)(*pointer_count + section_pointer_count + 1) * sizeof(int64_t));
+    if (!new_pointers) return -1;
+    *pointers = new_pointers;
+
+    for (int i = 0; i < section_pointer_count; i++) {
+        if (section_pointers[i] < 0 || section_pointers[i] > section_edge_count ||
+            (i > 0 && section_pointers[i] < section_pointers[i - 1])) {
+            return -1;
+        }
+        (*pointers)[*pointer_count + i] = (int64_t)section_pointers[i] + *edge_count;
+    }
+    memcpy(*edges + *edge_count, section_edges, (size_t)section_edge_count * sizeof(int));
+    *edge_count += section_edge_count;
+    *pointer_count += section_pointer_count;
+    return 0;
+}
+
+// Funkcja wyznaczająca kolejną linię tekstu w buforze
+// Zwraca wskaźnik na początek linii i ustawia *line_end na jej koniec (bez '\n'),
+// a *cursor na początek następnej linii; zwraca NULL po osiągnięciu końca bufora
+static const char* next_line(const char** cursor, const char* end, const char** line_end) {
+    const char* begin = *cursor;
+    if (begin >= end) return NULL;
+
+    const char* newline = (const char*)memchr(begin, '\n', end - begin);
+    *line_end = newline ? newline : end;
+    *cursor = newline ? newline + 1 : end;
+    return begin;
+}
+
+// Źródło kolejnych linii bufora
+// W trybie potokowym granice linii wyznacza osobny wątek, który przeglądając
+// bufor wczytuje kolejne strony pliku, podczas gdy bieżąca linia jest parsowana
+typedef struct {
+    const char* cursor;       // Początek nieprzeczytanej części bufora
+    const char* end;          // Koniec bufora
+    bool pipelined;           // Czy linie wyznacza wątek czytający
+    pthread_t thread;         // Wątek czytający
+    pthread_mutex_t lock;     // Ochrona kolejki linii
+    pthread_cond_t ready;     // Sygnał nowej linii lub końca bufora
+    const char** spans;       // Pary (początek, koniec) wyznaczonych linii
+    int produced;             // Liczba wyznaczonych linii
+    int consumed;             // Liczba linii pobranych do parsowania
+    int capacity;             // Pojemność tablicy spans (w liniach)
+    bool finished;            // Czy wątek czytający zakończył pracę
+    bool stop;                // Żądanie przerwania pracy wątku czytającego
+} LineReader;
+
+// Główna pętla wątku czytającego
+static void* line_reader_main(void* arg) {
+    LineReader* reader = (LineReader*)arg;
+    const char* line_end;
+    const char* line;
+
+    while ((line = next_line(&reader->cursor, reader->end, &line_end))) {
+        pthread_mutex_lock(&reader->lock);
+        if (reader->stop) {
+            pthread_mutex_unlock(&reader->lock);
+            break;
+        }
+        if (reader->produced == reader->capacity) {
+            int new_capacity = reader->capacity * 2;
+            const char** spans = (const char**)realloc(reader->spans, 2 * new_capacity * sizeof(const char*));
+            if (!spans) {
+                pthread_mutex_unlock(&reader->lock);
+                break;
             }
+            reader->spans = spans;
+            reader->capacity = new_capacity;
         }
-        free(graph->adj_list);
+        reader->spans[2 * reader->produced] = line;
+        reader->spans[2 * reader->produced + 1] = line_end;
+        reader->produced++;
+        pthread_cond_signal(&reader->ready);
+        pthread_mutex_unlock(&reader->lock);
     }
 
-    // Zwolnienie struktury grafu
-    free(graph);
+    pthread_mutex_lock(&reader->lock);
+    reader->finished = true;
+    pthread_cond_signal(&reader->ready);
+    pthread_mutex_unlock(&reader->lock);
+    return NULL;
 }
 
-// Wczytywanie grafu z pliku w formacie CSRRG
-int load_graph_from_file(const char* filename, Graph** graph) {
-    FILE* file = fopen(filename, "r");
-    if (!file) return -1;
+// Funkcja inicjalizująca źródło linii; w trybie potokowym uruchamia wątek czytający
+// W razie niepowodzenia uruchomienia wątku źródło działa sekwencyjnie
+static void line_reader_init(LineReader* reader, const char* data, size_t size, bool pipelined) {
+    memset(reader, 0, sizeof(*reader));
+    reader->cursor = data;
+    reader->end = data + size;
+    if (!pipelined) return;
+
+    reader->capacity = 8;
+    reader->spans = (const char**)malloc(2 * reader->capacity * sizeof(const char*));
+    if (!reader->spans) return;
+    pthread_mutex_init(&reader->lock, NULL);
+    pthread_cond_init(&reader->ready, NULL);
+    if (pthread_create(&reader->thread, NULL, line_reader_main, reader) != 0) {
+        pthread_cond_destroy(&reader->ready);
+        pthread_mutex_destroy(&reader->lock);
+        free(reader->spans);
+        reader->spans = NULL;
+        return;
+    }
+    reader->pipelined = true;
+}
 
-    char* line = NULL;
-    size_t len = 0;
-    ssize_t read;
+// Funkcja pobierająca kolejną linię ze źródła
+static const char* line_reader_next(LineReader* reader, const char** line_end) {
+    if (!reader->pipelined) return next_line(&reader->cursor, reader->end, line_end);
 
-    // Wczytanie liczby wierzchołków z pierwszej linii pliku
-    int num_vertices = 0;
-    if ((read = getline(&line, &len, file)) != -1) {
-        num_vertices = atoi(line);
+    const char* line = NULL;
+    pthread_mutex_lock(&reader->lock);
+    while (reader->consumed == reader->produced && !reader->finished) {
+        pthread_cond_wait(&reader->ready, &reader->lock);
     }
-    if (num_vertices <= 0) {
-        free(line);
-        fclose(file);
-        return -1;
+    if (reader->consumed < reader->produced) {
+        line = reader->spans[2 * reader->consumed];
+        *line_end = reader->spans[2 * reader->consumed + 1];
+        reader->consumed++;
     }
+    pthread_mutex_unlock(&reader->lock);
+    return line;
+}
 
-    // Utworzenie nowego grafu o odpowiednim rozmiarze
-    *graph = create_graph(num_vertices);
-    if (!*graph) {
-        free(line);
-        fclose(file);
-        return -1;
-    }
+// Funkcja zatrzymująca wątek czytający i zwalniająca zasoby źródła linii
+static void line_reader_close(LineReader* reader) {
+    if (!reader->pipelined) return;
 
-    // Wczytanie indeksów kolumn z drugiej linii pliku
-    // Indeksy kolumn określają sąsiadów dla każdego wierzchołka
-    if ((read = getline(&line, &len, file)) == -1) {
-        free(line);
-        destroy_graph(*graph);
-        fclose(file);
+    pthread_mutex_lock(&reader->lock);
+    reader->stop = true;
+    pthread_mutex_unlock(&reader->lock);
+    pthread_join(reader->thread, NULL);
+
+    pthread_cond_destroy(&reader->ready);
+    pthread_mutex_destroy(&reader->lock);
+    free(reader->spans);
+    reader->pipelined = false;
+}
+
+// Wczytywanie grafu w formacie CSRRG z kolejnych linii źródła
+// Linia 1: maksymalna liczba węzłów w wierszu
+// Linia 2: indeksy kolumn kolejnych węzłów (liczba wpisów = liczba węzłów)
+// Linia 3: wskaźniki na pierwsze węzły kolejnych wierszy
+// Linie 4 i 5 (oraz kolejne pary): grupy krawędzi i wskaźniki na początki grup
+// Liczby są parsowane bezpośrednio z bufora, bez kopiowania linii; przy podanej
+// puli wątków długie linie są dzielone na fragmenty parsowane równolegle
+static int parse_graph_lines(LineReader* reader, ThreadPool* pool, Graph** graph) {
+    const char* line_end;
+    const char* line;
+    STATS_PHASE_BEGIN(parse_start);
+
+    // Wczytanie maksymalnej liczby węzłów w wierszu z pierwszej linii
+    int header[1];
+    line = line_reader_next(reader, &line_end);
+    if (!line || parse_numbers_into(line, line_end, header, 1) != 1 || header[0] <= 0) {
+        STATS_PHASE_END(PHASE_PARSE, parse_start);
         return -1;
     }
 
-    int col_count;
-    int* col_indices = read_semicolon_separated_numbers(line, &col_count);
-    if (!col_indices) {
-        free(line);
-        destroy_graph(*graph);
-        fclose(file);
+    *graph = create_graph(header[0]);
+    if (!*graph) {
+        STATS_PHASE_END(PHASE_PARSE, parse_start);
         return -1;
     }
 
-    // Wczytanie wskaźników wierszy z trzeciej linii pliku
-    // Wskaźniki określają początek i koniec listy sąsiadów dla każdego wierzchołka
-    if ((read = getline(&line, &len, file)) == -1) {
-        free(line);
+    // Wczytanie indeksów kolumn z drugiej linii
+    // Każdy wpis odpowiada jednemu węzłowi, więc ich liczba wyznacza rozmiar grafu;
+    // kolumny razem z wierszami są współrzędnymi węzłów podziału geometrycznego
+    int col_count = 0;
+    int* col_indices = NULL;
+    if ((line = line_reader_next(reader, &line_end))) {
+        col_indices = parse_number_list_parallel(pool, line, line_end, &col_count);
+    }
+    if (!col_indices || col_count <= 0) {
         free(col_indices);
         destroy_graph(*graph);
-        fclose(file);
+        *graph = NULL;
+        STATS_PHASE_END(PHASE_PARSE, parse_start);
         return -1;
     }
+    (*graph)->vertex_cols = col_indices;
 
-    int row_count;
-    (*graph)->row_pointers = read_semicolon_separated_numbers(line, &row_count);
-    if (!(*graph)->row_pointers || row_count != num_vertices + 1) {
-        free(line);
-        free(col_indices);
+    // Wczytanie wskaźników wierszy z trzeciej linii
+    int row_count = 0;
+    if ((line = line_reader_next(reader, &line_end))) {
+        (*graph)->row_pointers = parse_number_list_parallel(pool, line, line_end, &row_count);
+    }
+    if (!(*graph)->row_pointers || row_count < 2 ||
+        (*graph)->row_pointers[row_count - 1] != col_count) {
         destroy_graph(*graph);
-        fclose(file);
+        *graph = NULL;
+        STATS_PHASE_END(PHASE_PARSE, parse_start);
         return -1;
     }
+    (*graph)->num_rows = row_count - 1;
+    (*graph)->total_vertices = col_count;
+
+    // Wczytanie wszystkich sekcji krawędzi (pary linii: grupy i wskaźniki grup)
+    int* edges = NULL;
+    int64_t edge_count = 0;
+    int64_t* pointers = NULL;
+    int64_t pointer_count = 0;
+    int status = 0;
+    while (status == 0 && (line = line_reader_next(reader, &line_end))) {
+        int section_edge_count;
+        int* section_edges = parse_number_list_parallel(pool, line, line_end, &section_edge_count);
+        if (!section_edges) {
+            status = -1;
+            break;
+        }
+        if (section_edge_count == 0) {
+            // Pusta linia (np. na końcu pliku) nie rozpoczyna sekcji
+            free(section_edges);
+            continue;
+        }
 
-    // Opcjonalne wczytanie wartości (czwarta linia pliku)
-    // Wartości mogą reprezentować wagi krawędzi
-    if ((read = getline(&line, &len, file)) != -1) {
-        int val_count;
-        int* values = read_semicolon_separated_numbers(line, &val_count);
-        if (values) free(values);
+        int section_pointer_count = 0;
+        int* section_pointers = NULL;
+        if ((line = line_reader_next(reader, &line_end))) {
+            section_pointers = parse_number_list_parallel(pool, line, line_end, &section_pointer_count);
+        }
+        if (!section_pointers || section_pointer_count == 0 ||
+            append_edge_section(&edges, &edge_count, &pointers, &pointer_count,
+                                section_edges, section_edge_count,
+                                section_pointers, section_pointer_count) != 0) {
+            status = -1;
+        }
+        free(section_pointers);
+        free(section_edges);
     }
+    STATS_PHASE_END(PHASE_PARSE, parse_start);
 
-    // Inicjalizacja struktur grafu
-    (*graph)->total_vertices = num_vertices;
-    (*graph)->vertex_indices = (int*)malloc(num_vertices * sizeof(int));
-    (*graph)->adj_list = (AdjacencyList*)malloc(num_vertices * sizeof(AdjacencyList));
-    
-    if (!(*graph)->vertex_indices || !(*graph)->adj_list) {
-        free(line);
-        free(col_indices);
+    // Inicjalizacja indeksów wierzchołków
+    STATS_PHASE_BEGIN(build_start);
+    (*graph)->vertex_indices = (int*)malloc(col_count * sizeof(int));
+    if (status != 0 || !(*graph)->vertex_indices ||
+        build_graph_csr(*graph, edges, edge_count, pointers, pointer_count) != 0) {
+        free(edges);
+        free(pointers);
         destroy_graph(*graph);
-        fclose(file);
+        *graph = NULL;
+        STATS_PHASE_END(PHASE_BUILD_CSR, build_start);
         return -1;
     }
-
-    // Inicjalizacja indeksów wierzchołków
-    // Każdy wierzchołek otrzymuje unikalny indeks
-    for (int i = 0; i < num_vertices; i++) {
+    for (int i = 0; i < col_count; i++) {
         (*graph)->vertex_indices[i] = i;
     }
+    STATS_PHASE_END(PHASE_BUILD_CSR, build_start);
 
-    // Inicjalizacja list sąsiedztwa dla każdego wierzchołka
-    // Każdy wierzchołek otrzymuje pustą listę sąsiadów
-    for (int i = 0; i < num_vertices; i++) {
-        if (init_adjacency_list(&(*graph)->adj_list[i]) != 0) {
-            free(line);
-            free(col_indices);
-            destroy_graph(*graph);
-            fclose(file);
-            return -1;
-        }
-    }
-
-    // Konwersja formatu CSR na listy sąsiedztwa
-    // Dla każdego wierzchołka:
-    // 1. Określamy zakres jego sąsiadów w tablicy col_indices
-    // 2. Dodajemy każdego sąsiada do listy sąsiedztwa
-    for (int i = 0; i < num_vertices; i++) {
-        int start = (*graph)->row_pointers[i];
-        int end = (*graph)->row_pointers[i + 1];
-        for (int j = start; j < end; j++) {
-            if (j < col_count) {  // Zabezpieczenie przed wyjściem poza zakres
-                if (add_neighbor(&(*graph)->adj_list[i], col_indices[j]) != 0) {
-                    free(line);
-                    free(col_indices);
-                    destroy_graph(*graph);
-                    fclose(file);
-                    return -1;
-                }
-            }
-        }
-    }
-
-    free(line);
-    free(col_indices);
-    fclose(file);
+    free(edges);
+    free(pointers);
     return 0;
 }
 
-// Zapisywanie wyniku do pliku
-int save_graph_division(const char* filename, const Graph* graph,
-                       VertexGroup* groups, int num_groups, bool binary_output) {
-    FILE* file = fopen(filename, binary_output ? "wb" : "w");
-    if (!file) return -1;
-
-    if (binary_output) {
-        // Zapis w formacie binarnym
-        fwrite(&num_groups, sizeof(int), 1, file);
-        for (int i = 0; i < num_groups; i++) {
-            fwrite(&groups[i].count, sizeof(int), 1, file);
-            for (int j = 0; j < groups[i].count; j++) {
-                int vertex_index = graph->vertex_indices[groups[i].vertices[j]];
-                fwrite(&vertex_index, sizeof(int), 1, file);
-            }
-        }
-    } else {
-        // Zapis w formacie tekstowym
-        fprintf(file, "%d\n", num_groups);
-        for (int i = 0; i < num_groups; i++) {
-            fprintf(file, "Group %d (%d vertices):", i + 1, groups[i].count);
-            for (int j = 0; j < groups[i].count; j++) {
-                fprintf(file, " %d", graph->vertex_indices[groups[i].vertices[j]]);
-            }
-            fprintf(file, "\n");
-        }
+// Wczytywanie grafu w formacie CSRRG z bufora w pamięci
+int load_graph_from_buffer(const char* data, size_t size, Graph** graph) {
+    LineReader reader;
+    line_reader_init(&reader, data, size, false);
+    return parse_graph_lines(&reader, NULL, graph);
+}
+
+// Wczytywanie grafu w formacie CSRRG z bufora w pamięci z użyciem num_threads wątków
+// Wyznaczanie granic kolejnej linii odbywa się równolegle z parsowaniem bieżącej
+int load_graph_from_buffer_parallel(const char* data, size_t size, Graph** graph, int num_threads) {
+    // Dla małych plików koszt uruchomienia wątków przewyższa zysk
+    if (num_threads <= 1 || size < PARALLEL_LOAD_MIN_SIZE) {
+        return load_graph_from_buffer(data, size, graph);
     }
 
-    fclose(file);
-    return 0;
+    ThreadPool* pool = thread_pool_create(num_threads);
+    if (!pool) return -1;
+
+    LineReader reader;
+    line_reader_init(&reader, data, size, true);
+    int result = parse_graph_lines(&reader, pool, graph);
+    line_reader_close(&reader);
+    thread_pool_destroy(pool);
+    return result;
 }
 
-// Funkcja do odczytu podziału grafu z pliku binarnego
-int load_graph_division(const char* filename, VertexGroup** groups, int* num_groups) {
-    FILE* file = fopen(filename, "rb");
-    if (!file) {
-        fprintf(stderr, "Błąd: Nie można otworzyć pliku %s\n", filename);
-        return -1;
-    }
+// Wczytywanie grafu z pliku w formacie CSRRG
+// Plik jest odwzorowywany w pamięci (mmap) i parsowany bez kopiowania linii
+// Pliki w formacie binarnym .csrb (rozpoznawane po sygnaturze) są jedynie odwzorowywane
+static int load_graph_file(const char* filename, Graph** graph, int num_threads) {
+    if (is_graph_binary_file(filename)) return load_graph_binary(filename, graph);
 
-    // Odczytanie liczby grup z pliku
-    if (fread(num_groups, sizeof(int), 1, file) != 1) {
-        fprintf(stderr, "Błąd: Nie można odczytać liczby grup\n");
-        fclose(file);
-        return -1;
-    }
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return -1;
 
-    // Alokacja pamięci na grupy wierzchołków
-    *groups = (VertexGroup*)malloc(*num_groups * sizeof(VertexGroup));
-    if (!*groups) {
-        fprintf(stderr, "Błąd: Nie można zaalokować pamięci na grupy\n");
-        fclose(file);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
         return -1;
     }
 
-    // Odczytanie danych dla każdej grupy
-    for (int i = 0; i < *num_groups; i++) {
-        // Odczytanie liczby wierzchołków w grupie
-        if (fread(&(*groups)[i].count, sizeof(int), 1, file) != 1) {
-            fprintf(stderr, "Błąd: Nie można odczytać liczby wierzchołków w grupie %d\n", i);
-            for (int j = 0; j < i; j++) free((*groups)[j].vertices);
-            free(*groups);
-            fclose(file);
-            return -1;
-        }
+    size_t size = (size_t)st.st_size;
+    void* data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -1;
 
-        // Alokacja pamięci na wierzchołki grupy
-        (*groups)[i].vertices = (int*)malloc((*groups)[i].count * sizeof(int));
-        if (!(*groups)[i].vertices) {
-            fprintf(stderr, "Błąd: Nie można zaalokować pamięci na wierzchołki grupy %d\n", i);
-            for (int j = 0; j < i; j++) free((*groups)[j].vertices);
-            free(*groups);
-            fclose(file);
-            return -1;
-        }
-
-        // Odczytanie wierzchołków grupy
-        if (fread((*groups)[i].vertices, sizeof(int), (*groups)[i].count, file) != (*groups)[i].count) {
-            fprintf(stderr, "Błąd: Nie można odczytać wierzchołków grupy %d\n", i);
-            for (int j = 0; j <= i; j++) free((*groups)[j].vertices);
-            free(*groups);
-            fclose(file);
-            return -1;
-        }
-    }
+    // Plik czytany jest jednokrotnie od początku do końca
+    madvise(data, size, MADV_SEQUENTIAL);
 
-    fclose(file);
-    return 0;
+    int result = load_graph_from_buffer_parallel((const char*)data, size, graph, num_threads);
+    munmap(data, size);
+    return result;
 }
 
+// Wczytywanie grafu z pliku (CSRRG lub .csrb) z użyciem num_threads wątków
+int load_graph_from_file_parallel(const char* filename, Graph** graph, int num_threads) {
+    STATS_PHASE_BEGIN(start);
+    int result = load_graph_file(filename, graph, num_threads);
+    STATS_PHASE_END(PHASE_LOAD, start);
+    return result;
+}
 
+// Wczytywanie grafu z pliku w formacie CSRRG jednym wątkiem
+int load_graph_from_file(const char* filename, Graph** graph) {
+    return load_graph_from_file_parallel(filename, graph, 1);
+}
@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/graph.h"
+
+// Binarny format grafu .csrb
+// Plik zaczyna się nagłówkiem CsrbHeader, po którym następują sekcje z tablicami
+// grafu w kolejności CsrbSection. Każda sekcja zaczyna się od granicy strony, więc
+// po odwzorowaniu pliku w pamięci tablice grafu mogą wskazywać bezpośrednio do
+// odwzorowania - wczytanie nie wymaga parsowania ani kopiowania danych, a strony
+// pamięci podręcznej systemu są współdzielone przez równolegle działające procesy
+// Liczby zapisywane są w kolejności bajtów maszyny, która utworzyła plik; plik
+// z inną kolejnością bajtów jest odrzucany przy sprawdzaniu numeru wersji
+#define CSRB_MAGIC "CSRB"
+#define CSRB_VERSION 2
+#define CSRB_ALIGNMENT 4096
+
+// Flagi opcjonalnych sekcji
+#define CSRB_HAS_VWGT   0x1u
+#define CSRB_HAS_ADJWGT 0x2u
+#define CSRB_HAS_COLS   0x4u
+
+// Sekcje pliku
+typedef enum {
+    CSRB_XADJ,            // int64_t[num_vertices + 1]
+    CSRB_ADJNCY,          // uint16_t albo int32_t[2 * num_edges], zależnie od index_width
+    CSRB_ROW_POINTERS,    // int[num_rows + 1]
+    CSRB_VERTEX_INDICES,  // int[num_vertices]
+    CSRB_VWGT,            // int[num_vertices] (tylko z flagą CSRB_HAS_VWGT)
+    CSRB_ADJWGT,          // int[2 * num_edges] (tylko z flagą CSRB_HAS_ADJWGT)
+    CSRB_VERTEX_COLS,     // int[num_vertices] (tylko z flagą CSRB_HAS_COLS, od wersji 2)
+    CSRB_NUM_SECTIONS
+} CsrbSection;
+
+// Nagłówek pliku .csrb
+typedef struct {
+    char magic[4];                          // Sygnatura "CSRB"
+    uint32_t version;                       // Wersja formatu
+    uint32_t index_width;                   // Szerokość identyfikatorów w adjncy (16 lub 32)
+    uint32_t flags;                         // Obecne sekcje opcjonalne
+    int64_t num_vertices;                   // Liczba węzłów
+    int64_t num_edges;                      // Liczba krawędzi nieskierowanych
+    int64_t num_rows;                       // Liczba wierszy macierzy
+    int64_t max_vertices;                   // Maksymalna liczba węzłów w wierszu
+    uint64_t offsets[CSRB_NUM_SECTIONS];    // Położenia sekcji w pliku
+    uint64_t sizes[CSRB_NUM_SECTIONS];      // Rozmiary sekcji w bajtach
+    uint64_t file_size;                     // Rozmiar całego pliku
+    uint64_t data_checksum;                 // Suma kontrolna wszystkich sekcji
+    uint64_t header_checksum;               // Suma kontrolna poprzednich pól nagłówka
+} CsrbHeader;
+
+// Funkcja aktualizująca 64-bitową sumę kontrolną (FNV-1a na słowach 8-bajtowych)
+// Zwraca nową wartość sumy
+static uint64_t checksum_update(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, p + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3ULL;
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ p[i]) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+#define CHECKSUM_SEED 0xCBF29CE484222325ULL
+
+// Funkcja obliczająca sumę kontrolną nagłówka (bez pola header_checksum)
+static uint64_t header_checksum(const CsrbHeader* header) {
+    return checksum_update(CHECKSUM_SEED, header, offsetof(CsrbHeader, header_checksum));
+}
+
+// Funkcja zaokrąglająca położenie w pliku do granicy strony
+static uint64_t align_offset(uint64_t offset) {
+    return (offset + CSRB_ALIGNMENT - 1) / CSRB_ALIGNMENT * CSRB_ALIGNMENT;
+}
+
+// Funkcja sprawdzająca, czy plik zaczyna się sygnaturą formatu .csrb
+bool is_graph_binary_file(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return false;
+
+    char magic[4];
+    bool binary = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                  memcmp(magic, CSRB_MAGIC, sizeof(magic)) == 0;
+    fclose(file);
+    return binary;
+}
+
+// Funkcja zapisująca graf w formacie .csrb
+// Plik zapisywany jest pod nazwą tymczasową i przemianowywany dopiero po zapisaniu
+// całości, więc równolegle działające procesy nigdy nie odwzorują niepełnego pliku
+// Graf ze skompresowanymi listami sąsiadów nie może być zapisany (format przechowuje CSR)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int save_graph_binary(const char* filename, const Graph* graph) {
+    if (graph->adj_offsets) return -1;
+    int n = graph->total_vertices;
+    int64_t slots = graph->xadj[n];
+    size_t index_size = (graph->index_width == INDEX_WIDTH_16) ? sizeof(uint16_t) : sizeof(int32_t);
+
+    CsrbHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CSRB_MAGIC, sizeof(header.magic));
+    header.version = CSRB_VERSION;
+    header.index_width = graph->index_width;
+    header.flags = (graph->vwgt ? CSRB_HAS_VWGT : 0) | (graph->adjwgt ? CSRB_HAS_ADJWGT : 0) |
+                   (graph->vertex_cols ? CSRB_HAS_COLS : 0);
+    header.num_vertices = n;
+    header.num_edges = graph->num_edges;
+    header.num_rows = graph->num_rows;
+    header.max_vertices = graph->max_vertices;
+
+    const void* sections[CSRB_NUM_SECTIONS] = {
+        graph->xadj, graph->adjncy, graph->row_pointers, graph->vertex_indices,
+        graph->vwgt, graph->adjwgt, graph->vertex_cols
+    };
+    header.sizes[CSRB_XADJ] = (uint64_t)(n + 1) * sizeof(int64_t);
+    header.sizes[CSRB_ADJNCY] = (uint64_t)slots * index_size;
+    header.sizes[CSRB_ROW_POINTERS] = (uint64_t)(graph->num_rows + 1) * sizeof(int);
+    header.sizes[CSRB_VERTEX_INDICES] = (uint64_t)n * sizeof(int);
+    header.sizes[CSRB_VWGT] = graph->vwgt ? (uint64_t)n * sizeof(int) : 0;
+    header.sizes[CSRB_ADJWGT] = graph->adjwgt ? (uint64_t)slots * sizeof(int) : 0;
+    header.sizes[CSRB_VERTEX_COLS] = graph->vertex_cols ? (uint64_t)n * sizeof(int) : 0;
+
+    uint64_t offset = align_offset(sizeof(CsrbHeader));
+    header.data_checksum = CHECKSUM_SEED;
+    for (int s = 0; s < CSRB_NUM_SECTIONS; s++) {
+        header.offsets[s] = offset;
+        offset = align_offset(offset + header.sizes[s]);
+        if (header.sizes[s] > 0) {
+            header.data_checksum = checksum_update(header.data_checksum, sections[s], header.sizes[s]);
+        }
+    }
+    header.file_size = offset;
+    header.header_checksum = header_checksum(&header);
+
+    size_t name_length = strlen(filename);
+    char* temp_name = (char*)malloc(name_length + 5);
+    if (!temp_name) return -1;
+    memcpy(temp_name, filename, name_length);
+    memcpy(temp_name + name_length, ".tmp", 5);
+
+    FILE* file = fopen(temp_name, "wb");
+    if (!file) {
+        free(temp_name);
+        return -1;
+    }
+
+    // Sekcje rozdzielane są zerami do granicy strony
+    static const char padding[CSRB_ALIGNMENT];
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    uint64_t position = sizeof(header);
+    for (int s = 0; s < CSRB_NUM_SECTIONS && ok; s++) {
+        ok = fwrite(padding, 1, header.offsets[s] - position, file) == header.offsets[s] - position;
+        if (ok && header.sizes[s] > 0) {
+            ok = fwrite(sections[s], 1, header.sizes[s], file) == header.sizes[s];
+        }
+        position = header.offsets[s] + header.sizes[s];
+    }
+    if (ok) ok = fwrite(padding, 1, header.file_size - position, file) == header.file_size - position;
+    if (fclose(file) != 0) ok = false;
+
+    if (!ok || rename(temp_name, filename) != 0) {
+        remove(temp_name);
+        free(temp_name);
+        return -1;
+    }
+    free(temp_name);
+    return 0;
+}
+
+// Funkcja odwzorowująca plik .csrb w pamięci i sprawdzająca jego nagłówek
+// Sprawdzane są sygnatura, wersja, suma kontrolna nagłówka oraz zgodność rozmiarów
+// i położeń sekcji z liczbami węzłów i krawędzi; dane sekcji nie są odczytywane
+// Zwraca wskaźnik do odwzorowania lub NULL w przypadku błędu
+static const CsrbHeader* map_graph_binary(const char* filename, size_t* size) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CsrbHeader)) {
+        close(fd);
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+
+    // Odwzorowanie współdzielone tylko do odczytu - strony pliku pochodzą wprost
+    // z pamięci podręcznej systemu i nie są kopiowane do procesu
+    void* data = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    const CsrbHeader* header = (const CsrbHeader*)data;
+    bool valid = memcmp(header->magic, CSRB_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == CSRB_VERSION &&
+                 header->header_checksum == header_checksum(header) &&
+                 header->file_size == *size &&
+                 (header->index_width == INDEX_WIDTH_16 || header->index_width == INDEX_WIDTH_32) &&
+                 header->num_vertices > 0 && header->num_vertices <= INT_MAX &&
+                 header->num_rows > 0 && header->num_rows < INT_MAX &&
+                 header->max_vertices > 0 && header->max_vertices <= INT_MAX &&
+                 header->num_edges >= 0 && header->num_edges <= INT64_MAX / 8;
+
+    if (valid) {
+        uint64_t n = (uint64_t)header->num_vertices;
+        uint64_t slots = 2 * (uint64_t)header->num_edges;
+        uint64_t index_size = header->index_width / 8;
+        uint64_t expected[CSRB_NUM_SECTIONS] = {
+            (n + 1) * sizeof(int64_t),
+            slots * index_size,
+            ((uint64_t)header->num_rows + 1) * sizeof(int),
+            n * sizeof(int),
+            (header->flags & CSRB_HAS_VWGT) ? n * sizeof(int) : 0,
+            (header->flags & CSRB_HAS_ADJWGT) ? slots * sizeof(int) : 0,
+            (header->flags & CSRB_HAS_COLS) ? n * sizeof(int) : 0
+        };
+        for (int s = 0; s < CSRB_NUM_SECTIONS && valid; s++) {
+            valid = header->sizes[s] == expected[s] &&
+                    header->offsets[s] % CSRB_ALIGNMENT == 0 &&
+                    header->offsets[s] >= sizeof(CsrbHeader) &&
+                    header->offsets[s] <= *size &&
+                    header->sizes[s] <= *size - header->offsets[s];
+        }
+    }
+
+    if (!valid) {
+        munmap(data, *size);
+        return NULL;
+    }
+    return header;
+}
+
+// Funkcja sprawdzająca spójność tablic grafu odwzorowanego z pliku .csrb
+// Nagłówek opisuje tylko rozmiary sekcji, a algorytmy podziału indeksują tablice
+// wartościami z pliku bez sprawdzania granic, więc przed przekazaniem grafu dalej
+// sprawdzane są: monotoniczność xadj, zakres identyfikatorów sąsiadów,
+// monotoniczność row_pointers oraz zakres indeksów węzłów (jeden przebieg O(V+E))
+// Zwraca true, gdy tablice są spójne
+static bool check_graph_sections(const CsrbHeader* header) {
+    const char* base = (const char*)header;
+    int n = (int)header->num_vertices;
+    int num_rows = (int)header->num_rows;
+    const int64_t* xadj = (const int64_t*)(base + header->offsets[CSRB_XADJ]);
+    const int* row_pointers = (const int*)(base + header->offsets[CSRB_ROW_POINTERS]);
+    const int* vertex_indices = (const int*)(base + header->offsets[CSRB_VERTEX_INDICES]);
+
+    if (xadj[0] != 0 || xadj[n] != 2 * header->num_edges ||
+        row_pointers[0] != 0 || row_pointers[num_rows] != n) {
+        return false;
+    }
+    for (int v = 0; v < n; v++) {
+        if (xadj[v + 1] < xadj[v] || vertex_indices[v] < 0 || vertex_indices[v] >= n) return false;
+    }
+    for (int r = 0; r < num_rows; r++) {
+        if (row_pointers[r + 1] < row_pointers[r]) return false;
+    }
+
+    // Identyfikatory sąsiadów; przy szerokości 16 bitów wartości są bez znaku
+    int64_t slots = xadj[n];
+    if (header->index_width == INDEX_WIDTH_16) {
+        const uint16_t* adjncy = (const uint16_t*)(base + header->offsets[CSRB_ADJNCY]);
+        for (int64_t j = 0; j < slots; j++) {
+            if (adjncy[j] >= n) return false;
+        }
+    } else {
+        const int32_t* adjncy = (const int32_t*)(base + header->offsets[CSRB_ADJNCY]);
+        for (int64_t j = 0; j < slots; j++) {
+            if ((uint32_t)adjncy[j] >= (uint32_t)n) return false;
+        }
+    }
+    return true;
+}
+
+// Wczytywanie grafu z pliku w formacie .csrb
+// Tablice grafu wskazują bezpośrednio do odwzorowania pliku, bez parsowania ani
+// kopiowania; jedynym przebiegiem po danych jest sprawdzenie spójności tablic
+// (check_graph_sections), które odrzuca uszkodzone pliki przed podziałem
+// Graf należy zwolnić funkcją destroy_graph, która usuwa odwzorowanie
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int load_graph_binary(const char* filename, Graph** graph) {
+    size_t size;
+    const CsrbHeader* header = map_graph_binary(filename, &size);
+    if (!header) return -1;
+
+    const char* base = (const char*)header;
+    int n = (int)header->num_vertices;
+    int num_rows = (int)header->num_rows;
+    int64_t* xadj = (int64_t*)(base + header->offsets[CSRB_XADJ]);
+    int* row_pointers = (int*)(base + header->offsets[CSRB_ROW_POINTERS]);
+
+    if (!check_graph_sections(header)) {
+        munmap((void*)header, size);
+        return -1;
+    }
+
+    *graph = create_graph((int)header->max_vertices);
+    if (!*graph) {
+        munmap((void*)header, size);
+        return -1;
+    }
+    (*graph)->total_vertices = n;
+    (*graph)->num_rows = num_rows;
+    (*graph)->num_edges = header->num_edges;
+    (*graph)->index_width = (IndexWidth)header->index_width;
+    (*graph)->xadj = xadj;
+    (*graph)->adjncy = (void*)(base + header->offsets[CSRB_ADJNCY]);
+    (*graph)->row_pointers = row_pointers;
+    (*graph)->vertex_indices = (int*)(base + header->offsets[CSRB_VERTEX_INDICES]);
+    if (header->flags & CSRB_HAS_VWGT) (*graph)->vwgt = (int*)(base + header->offsets[CSRB_VWGT]);
+    if (header->flags & CSRB_HAS_ADJWGT) (*graph)->adjwgt = (int*)(base + header->offsets[CSRB_ADJWGT]);
+    if (header->flags & CSRB_HAS_COLS) (*graph)->vertex_cols = (int*)(base + header->offsets[CSRB_VERTEX_COLS]);
+    (*graph)->mapping = (void*)header;
+    (*graph)->mapping_size = size;
+    return 0;
+}
+
+// Funkcja sprawdzająca sumę kontrolną wszystkich sekcji pliku .csrb
+// Wymaga odczytania całego pliku, dlatego nie jest wykonywana przy zwykłym wczytywaniu
+// Zwraca 0, gdy plik jest poprawny, -1 w przeciwnym przypadku
+int verify_graph_binary(const char* filename) {
+    size_t size;
+    const CsrbHeader* header = map_graph_binary(filename, &size);
+    if (!header) return -1;
+
+    madvise((void*)header, size, MADV_SEQUENTIAL);
+    uint64_t checksum = CHECKSUM_SEED;
+    for (int s = 0; s < CSRB_NUM_SECTIONS; s++) {
+        if (header->sizes[s] > 0) {
+            checksum = checksum_update(checksum, (const char*)header + header->offsets[s], header->sizes[s]);
+        }
+    }
+    int result = (checksum == header->data_checksum) ? 0 : -1;
+    munmap((void*)header, size);
+    return result;
+}
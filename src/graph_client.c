@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../include/graph.h"
+
+// Funkcja wyświetlająca instrukcję użycia programu
+static void print_client_usage(const char* program_name) {
+    printf("Użycie: %s -u gniazdo -i plik_grafu [-p liczba_części] [-m margines] [-r kl|fm|kway|lp|none] [-I contiguous|geometric] [-M] [-S ziarno] [-s starty] [-o plik_wyjściowy [-F format] [-b]] [-l plik_części] [-n powtórzenia]\n", program_name);
+    printf("       %s -u gniazdo -x\n\n", program_name);
+    printf("Opcje:\n");
+    printf("  -u gniazdo          Ścieżka gniazda serwera (graph_divider serve)\n");
+    printf("  -i plik_grafu       Graf w formacie CSRRG lub .csrb wczytywany przez serwer\n");
+    printf("  -p, -m, -r, -I, -M, -S, -s, -F, -b  Jak w programie graph_divider\n");
+    printf("  -o plik_wyjściowy   Plik wynikowy zapisywany przez serwer\n");
+    printf("  -l plik_części      Zapisz otrzymany numer części każdego węzła (wynik w odpowiedzi)\n");
+    printf("  -n powtórzenia      Liczba żądań wysyłanych jednym połączeniem (domyślnie: 1)\n");
+    printf("  -x                  Zatrzymaj serwer\n");
+    printf("  -h                  Wyświetl tę pomoc\n");
+}
+
+// Funkcja łącząca z serwerem
+// Zwraca deskryptor gniazda lub -1 w przypadku błędu
+static int connect_server(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) return -1;
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Funkcja zamieniająca ścieżkę względną na bezwzględną (serwer ma inny katalog roboczy)
+// Zwraca 0 w przypadku sukcesu, -1 gdy ścieżka jest zbyt długa
+static int absolute_path(const char* path, char* result) {
+    if (path[0] == '/') {
+        if (strlen(path) >= PROTOCOL_MAX_PATH) return -1;
+        strcpy(result, path);
+        return 0;
+    }
+    char cwd[PATH_MAX];
+    if (!getcwd(cwd, sizeof(cwd))) return -1;
+    int length = snprintf(result, PROTOCOL_MAX_PATH, "%s/%s", cwd, path);
+    return (length < 0 || length >= PROTOCOL_MAX_PATH) ? -1 : 0;
+}
+
+// Funkcja zapisująca wektor części (jeden numer w wierszu, jak pliki .part METIS)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int save_part_vector(const char* filename, const int* part_of, int num_vertices) {
+    OutputBuffer out;
+    if (output_open(&out, filename) != 0) return -1;
+    for (int i = 0; i < num_vertices; i++) {
+        output_int(&out, part_of[i]);
+        output_char(&out, '\n');
+    }
+    return output_close(&out);
+}
+
+// Klient serwera podziału: wysyła żądania i wypisuje przekrój oraz czasy
+int main(int argc, char* argv[]) {
+    const char* socket_path = NULL;      // Ścieżka gniazda serwera
+    const char* graph_file = NULL;       // Graf do podziału
+    const char* output_file = NULL;      // Plik wynikowy zapisywany przez serwer
+    const char* parts_file = NULL;       // Lokalny plik z wektorem części
+    int repeats = 1;                     // Liczba żądań w jednym połączeniu
+    bool shutdown_server = false;        // Żądanie zatrzymania serwera
+
+    PartitionRequest* request = (PartitionRequest*)calloc(1, sizeof(PartitionRequest));
+    if (!request) {
+        fprintf(stderr, "Błąd: Brak pamięci\n");
+        return 1;
+    }
+    request->type = REQUEST_PARTITION;
+    partition_options_init(&request->options);
+    request->format = DIVISION_GROUPS;
+
+    int opt;
+    bool valid = true;
+    while (valid && (opt = getopt(argc, argv, "u:i:p:m:r:I:MS:s:o:F:bl:n:xh")) != -1) {
+        switch (opt) {
+            case 'u':
+                socket_path = optarg;
+                break;
+            case 'i':
+                graph_file = optarg;
+                break;
+            case 'p':
+                request->options.num_parts = atoi(optarg);
+                valid = request->options.num_parts > 0;
+                break;
+            case 'm':
+                request->options.margin_percentage = atof(optarg);
+                valid = request->options.margin_percentage >= 0;
+                break;
+            case 'r':
+                if (strcmp(optarg, "kl") == 0) request->options.refinement = REFINE_KL;
+                else if (strcmp(optarg, "fm") == 0) request->options.refinement = REFINE_FM;
+                else if (strcmp(optarg, "kway") == 0) request->options.refinement = REFINE_KWAY;
+                else if (strcmp(optarg, "lp") == 0) request->options.refinement = REFINE_LP;
+                else if (strcmp(optarg, "none") == 0) request->options.refinement = REFINE_NONE;
+                else valid = false;
+                break;
+            case 'I':
+                if (strcmp(optarg, "contiguous") == 0) request->options.initial = INITIAL_CONTIGUOUS;
+                else if (strcmp(optarg, "geometric") == 0) request->options.initial = INITIAL_GEOMETRIC;
+                else valid = false;
+                break;
+            case 'M':
+                request->options.multilevel = true;
+                break;
+            case 'S':
+                request->options.seed = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                request->options.num_starts = atoi(optarg);
+                valid = request->options.num_starts > 0;
+                break;
+            case 'o':
+                output_file = optarg;
+                break;
+            case 'F':
+                if (strcmp(optarg, "groups") == 0) request->format = DIVISION_GROUPS;
+                else if (strcmp(optarg, "part") == 0) request->format = DIVISION_PART_VECTOR;
+                else if (strcmp(optarg, "varint") == 0) request->format = DIVISION_VARINT;
+                else valid = false;
+                break;
+            case 'b':
+                request->binary_output = true;
+                break;
+            case 'l':
+                parts_file = optarg;
+                break;
+            case 'n':
+                repeats = atoi(optarg);
+                valid = repeats > 0;
+                break;
+            case 'x':
+                shutdown_server = true;
+                break;
+            case 'h':
+                print_client_usage(argv[0]);
+                free(request);
+                return 0;
+            default:
+                valid = false;
+                break;
+        }
+    }
+    if (!valid || !socket_path || (!shutdown_server && !graph_file) || (output_file && parts_file)) {
+        fprintf(stderr, "Błąd: Nieprawidłowe opcje\n");
+        print_client_usage(argv[0]);
+        free(request);
+        return 1;
+    }
+
+    if (shutdown_server) {
+        request->type = REQUEST_SHUTDOWN;
+        repeats = 1;
+    } else if (absolute_path(graph_file, request->graph_path) != 0 ||
+               (output_file && absolute_path(output_file, request->output_path) != 0)) {
+        fprintf(stderr, "Błąd: Zbyt długa ścieżka pliku\n");
+        free(request);
+        return 1;
+    }
+
+    int fd = connect_server(socket_path);
+    if (fd < 0) {
+        fprintf(stderr, "Błąd: Nie udało się połączyć z serwerem: %s\n", socket_path);
+        free(request);
+        return 1;
+    }
+
+    int result = 0;
+    for (int r = 0; r < repeats && result == 0; r++) {
+        PartitionResponse response;
+        if (protocol_send_request(fd, request) != 0 || protocol_recv_response(fd, &response) != 0) {
+            fprintf(stderr, "Błąd: Przerwana komunikacja z serwerem\n");
+            result = 1;
+            break;
+        }
+        if (response.status != 0) {
+            fprintf(stderr, "Błąd: %s\n", response.message);
+            result = 1;
+        } else if (shutdown_server) {
+            printf("%s\n", response.message);
+        } else {
+            printf("Żądanie %d: przekrój %ld, węzły %d, graf %s, wczytywanie %.3f ms, podział %.3f ms\n",
+                   r + 1, response.cut, response.num_vertices,
+                   response.cache_hit ? "w pamięci serwera" : "wczytany", response.load_ms, response.partition_ms);
+            if (parts_file && response.part_of &&
+                save_part_vector(parts_file, response.part_of, response.num_vertices) != 0) {
+                fprintf(stderr, "Błąd: Nie udało się zapisać wektora części do pliku: %s\n", parts_file);
+                result = 1;
+            }
+        }
+        free(response.part_of);
+    }
+
+    close(fd);
+    free(request);
+    return result;
+}
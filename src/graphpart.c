@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/graph.h"
+#include "../include/graphpart.h"
+
+// Kontekst biblioteki
+struct GraphPartContext {
+    Graph* graph;          // Wczytany graf (NULL - brak)
+    const char* error;     // Opis ostatniego błędu (napis statyczny)
+};
+
+// Funkcja zapamiętująca opis błędu w kontekście
+// Zwraca -1, aby można jej było użyć w instrukcji return
+static int set_error(GraphPartContext* context, const char* message) {
+    context->error = message;
+    return -1;
+}
+
+// Funkcja ustawiająca domyślne opcje podziału (jak w programie graph_divider)
+void graphpart_options_init(GraphPartOptions* options) {
+    PartitionOptions defaults;
+    partition_options_init(&defaults);
+    options->num_parts = defaults.num_parts;
+    options->margin_percentage = defaults.margin_percentage;
+    options->refinement = GRAPHPART_REFINE_KL;
+    options->multilevel = defaults.multilevel;
+    options->seed = defaults.seed;
+    options->num_starts = defaults.num_starts;
+    options->num_threads = defaults.num_threads;
+}
+
+// Funkcja tworząca pusty kontekst
+// Zwraca kontekst lub NULL w przypadku błędu alokacji
+GraphPartContext* graphpart_context_create(void) {
+    GraphPartContext* context = (GraphPartContext*)malloc(sizeof(GraphPartContext));
+    if (!context) return NULL;
+    context->graph = NULL;
+    context->error = "";
+    return context;
+}
+
+// Funkcja zwalniająca kontekst wraz z wczytanym grafem
+void graphpart_context_destroy(GraphPartContext* context) {
+    if (!context) return;
+    destroy_graph(context->graph);
+    free(context);
+}
+
+// Funkcja zastępująca graf kontekstu nowo wczytanym
+static int replace_graph(GraphPartContext* context, int status, Graph* graph, const char* message) {
+    if (status != 0) {
+        destroy_graph(graph);
+        return set_error(context, message);
+    }
+    destroy_graph(context->graph);
+    context->graph = graph;
+    context->error = "";
+    return 0;
+}
+
+// Funkcja wczytująca graf w formacie CSRRG z bufora w pamięci
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int graphpart_load_buffer(GraphPartContext* context, const char* data, size_t size, int num_threads) {
+    if (!context) return -1;
+    if (!data || num_threads <= 0) return set_error(context, "niepoprawne argumenty");
+
+    Graph* graph = NULL;
+    int status = load_graph_from_buffer_parallel(data, size, &graph, num_threads);
+    return replace_graph(context, status, graph, "niepoprawny format CSRRG lub brak pamięci");
+}
+
+// Funkcja wczytująca graf z pliku w formacie CSRRG lub .csrb
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int graphpart_load_file(GraphPartContext* context, const char* filename, int num_threads) {
+    if (!context) return -1;
+    if (!filename || num_threads <= 0) return set_error(context, "niepoprawne argumenty");
+
+    Graph* graph = NULL;
+    int status = load_graph_from_file_parallel(filename, &graph, num_threads);
+    return replace_graph(context, status, graph, "nie udało się wczytać grafu z pliku");
+}
+
+// Funkcja kompresująca listy sąsiadów wczytanego grafu
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int graphpart_compress(GraphPartContext* context) {
+    if (!context) return -1;
+    if (!context->graph) return set_error(context, "kontekst nie zawiera grafu");
+    if (context->graph->adj_offsets) return 0;
+    if (graph_compress(context->graph) != 0) {
+        return set_error(context, "nie udało się skompresować list sąsiadów");
+    }
+    context->error = "";
+    return 0;
+}
+
+// Funkcja przenumerowująca węzły wczytanego grafu
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int graphpart_reorder(GraphPartContext* context, GraphPartOrdering ordering) {
+    if (!context) return -1;
+    if (!context->graph) return set_error(context, "kontekst nie zawiera grafu");
+    VertexOrdering internal;
+    switch (ordering) {
+        case GRAPHPART_ORDER_NONE:
+            internal = ORDER_NONE;
+            break;
+        case GRAPHPART_ORDER_BFS:
+            internal = ORDER_BFS;
+            break;
+        case GRAPHPART_ORDER_RCM:
+            internal = ORDER_RCM;
+            break;
+        default:
+            return set_error(context, "nieznana kolejność węzłów");
+    }
+    if (graph_reorder(context->graph, internal) != 0) {
+        return set_error(context, "nie udało się przenumerować węzłów grafu");
+    }
+    context->error = "";
+    return 0;
+}
+
+// Funkcja zwracająca liczbę węzłów wczytanego grafu
+int graphpart_num_vertices(const GraphPartContext* context) {
+    return (context && context->graph) ? context->graph->total_vertices : 0;
+}
+
+// Funkcja zwracająca liczbę krawędzi wczytanego grafu
+long graphpart_num_edges(const GraphPartContext* context) {
+    return (context && context->graph) ? (long)context->graph->num_edges : 0;
+}
+
+// Funkcja dzieląca wczytany graf; wynik zapisywany jest do tablicy wywołującego
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int graphpart_partition(GraphPartContext* context, const GraphPartOptions* options, int* part_of) {
+    if (!context) return -1;
+    if (!context->graph) return set_error(context, "kontekst nie zawiera grafu");
+    if (!options || !part_of) return set_error(context, "niepoprawne argumenty");
+    if (options->num_parts <= 0 || options->num_parts > context->graph->total_vertices ||
+        !(options->margin_percentage >= 0) || isinf(options->margin_percentage) || options->num_starts <= 0 || options->num_threads <= 0) {
+        return set_error(context, "niepoprawne opcje podziału");
+    }
+
+    PartitionOptions internal;
+    partition_options_init(&internal);
+    internal.num_parts = options->num_parts;
+    internal.margin_percentage = options->margin_percentage;
+    internal.multilevel = options->multilevel;
+    internal.seed = options->seed;
+    internal.num_starts = options->num_starts;
+    internal.num_threads = options->num_threads;
+    switch (options->refinement) {
+        case GRAPHPART_REFINE_KL:
+            internal.refinement = REFINE_KL;
+            break;
+        case GRAPHPART_REFINE_FM:
+            internal.refinement = REFINE_FM;
+            break;
+        case GRAPHPART_REFINE_KWAY:
+            internal.refinement = REFINE_KWAY;
+            break;
+        case GRAPHPART_REFINE_LP:
+            internal.refinement = REFINE_LP;
+            break;
+        default:
+            return set_error(context, "nieznany algorytm udoskonalania");
+    }
+
+    // Graf przenumerowany: wynik przepisywany jest do pierwotnej numeracji węzłów
+    const Graph* graph = context->graph;
+    bool reordered = graph_is_reordered(graph);
+    int* result = reordered ? (int*)malloc((size_t)graph->total_vertices * sizeof(int)) : part_of;
+    if (!result || partition_graph(graph, &internal, result) != 0) {
+        if (reordered) free(result);
+        return set_error(context, "podział nie powiódł się (brak pamięci)");
+    }
+    if (reordered) {
+        for (int v = 0; v < graph->total_vertices; v++) part_of[graph->vertex_indices[v]] = result[v];
+        free(result);
+    }
+    context->error = "";
+    return 0;
+}
+
+// Funkcja obliczająca przekrój podziału part_of wczytanego grafu
+// Zwraca sumę wag krawędzi między częściami lub -1 w przypadku błędu
+long graphpart_edge_cut(GraphPartContext* context, const int* part_of) {
+    if (!context) return -1;
+    if (!context->graph) return set_error(context, "kontekst nie zawiera grafu");
+    if (!part_of) return set_error(context, "niepoprawne argumenty");
+    const Graph* graph = context->graph;
+    if (!graph_is_reordered(graph)) return calculate_cut_from_parts(graph, part_of);
+
+    int* internal = (int*)malloc((graph->total_vertices > 0 ? graph->total_vertices : 1) * sizeof(int));
+    if (!internal) return set_error(context, "brak pamięci");
+    for (int v = 0; v < graph->total_vertices; v++) internal[v] = part_of[graph->vertex_indices[v]];
+    long cut = calculate_cut_from_parts(graph, internal);
+    free(internal);
+    return cut;
+}
+
+// Funkcja zwracająca opis ostatniego błędu kontekstu
+const char* graphpart_error(const GraphPartContext* context) {
+    return context ? context->error : "brak kontekstu";
+}
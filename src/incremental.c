@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../include/graph.h"
+
+// Funkcja przenosząca poprzedni podział na nowy graf
+// Poprzedni podział zawiera pierwotne indeksy węzłów, więc dla grafu przenumerowanego
+// (graph_reorder) przepisywany jest do numeracji wewnętrznej. Węzły spoza zakresu
+// nowego grafu są pomijane, a węzły nieobecne w poprzednim podziale otrzymują -1
+// Zwraca 0 w przypadku sukcesu, -1 gdy poprzedni podział zawiera ujemny numer węzła
+// lub w przypadku błędu alokacji
+static int map_previous_groups(const Graph* graph, const VertexGroup* previous, int num_previous, int* prior) {
+    int n = graph->total_vertices;
+    for (int v = 0; v < n; v++) prior[v] = -1;
+    for (int i = 0; i < num_previous; i++) {
+        for (int j = 0; j < previous[i].count; j++) {
+            int v = previous[i].vertices[j];
+            if (v < 0) return -1;
+            if (v < n) prior[v] = i;
+        }
+    }
+    if (!graph_is_reordered(graph)) return 0;
+
+    int* by_index = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!by_index) return -1;
+    memcpy(by_index, prior, (size_t)n * sizeof(int));
+    for (int v = 0; v < n; v++) prior[v] = by_index[graph->vertex_indices[v]];
+    free(by_index);
+    return 0;
+}
+
+// Funkcja wybierająca część, z którą węzeł ma najcięższe połączenia
+// Parametr weight - tablica num_parts wyzerowanych liczników (po powrocie znów wyzerowana)
+// Zwraca numer części lub -1, gdy żaden sąsiad nie ma jeszcze przypisanej części
+static int majority_part(const Graph* graph, const int* part_of, int vertex, long* weight) {
+    int best = -1;
+    FOR_EACH_NEIGHBOR(graph, vertex, it) {
+        int part = part_of[it.neighbor];
+        if (part < 0) continue;
+        weight[part] += neighbor_weight(graph, &it);
+        if (best < 0 || weight[part] > weight[best] || (weight[part] == weight[best] && part < best)) {
+            best = part;
+        }
+    }
+    FOR_EACH_NEIGHBOR(graph, vertex, it) {
+        int part = part_of[it.neighbor];
+        if (part >= 0) weight[part] = 0;
+    }
+    return best;
+}
+
+// Funkcja przypisująca części nowym węzłom (part_of[v] == -1)
+// Węzły przypisywane są wszerz od granicy z węzłami poprzedniego podziału: każdy
+// otrzymuje część, z którą łączy go największa waga krawędzi do już przypisanych
+// sąsiadów. Spójne składowe złożone wyłącznie z nowych węzłów trafiają w całości do
+// najlżejszej części. Poza przeglądem tablicy koszt jest proporcjonalny do sumy stopni
+// nowych węzłów
+// Zwraca liczbę nowych węzłów lub -1 w przypadku błędu alokacji
+static int assign_new_vertices(const Graph* graph, int* part_of, int num_parts) {
+    int n = graph->total_vertices;
+    int* queue = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    long* weight = (long*)calloc(num_parts, sizeof(long));
+    long* part_weight = (long*)calloc(num_parts, sizeof(long));
+    if (!queue || !weight || !part_weight) {
+        free(queue);
+        free(weight);
+        free(part_weight);
+        return -1;
+    }
+
+    // Węzły w kolejce oznaczane są wartością -2
+    int head = 0;
+    int tail = 0;
+    int added = 0;
+    for (int v = 0; v < n; v++) {
+        if (part_of[v] >= 0) {
+            part_weight[part_of[v]] += vertex_weight(graph, v);
+            continue;
+        }
+        added++;
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            if (part_of[it.neighbor] >= 0) {
+                part_of[v] = -2;
+                queue[tail++] = v;
+                break;
+            }
+        }
+    }
+
+    for (int seed = 0; seed <= n; seed++) {
+        // Przypisanie wszerz od węzłów z kolejki
+        while (head < tail) {
+            int v = queue[head++];
+            if (part_of[v] == -2) {
+                int part = majority_part(graph, part_of, v, weight);
+                part_of[v] = part;
+                part_weight[part] += vertex_weight(graph, v);
+            }
+            FOR_EACH_NEIGHBOR(graph, v, it) {
+                int u = it.neighbor;
+                if (part_of[u] != -1) continue;
+                part_of[u] = -2;
+                queue[tail++] = u;
+            }
+        }
+
+        // Składowa bez węzłów poprzedniego podziału
+        while (seed < n && part_of[seed] != -1) seed++;
+        if (seed == n) break;
+        int lightest = 0;
+        for (int i = 1; i < num_parts; i++) {
+            if (part_weight[i] < part_weight[lightest]) lightest = i;
+        }
+        part_of[seed] = lightest;
+        part_weight[lightest] += vertex_weight(graph, seed);
+        queue[tail++] = seed;
+    }
+
+    free(queue);
+    free(weight);
+    free(part_weight);
+    return added;
+}
+
+// Funkcja wyznaczająca podział nowej wersji grafu na podstawie poprzedniego podziału
+// Węzły zachowują poprzednie części, nowe węzły otrzymują część większości sąsiadów,
+// a następnie wykonywane jest wyłącznie lokalne udoskonalanie węzłów brzegowych:
+// k-drożne albo, dla options->refinement == REFINE_LP, propagacja etykiet
+// Udoskonalanie k-drożne samo przywraca zrównoważenie w granicach marginesu; propagacja
+// etykiet przenosi węzły tylko do sąsiednich części, więc przed nią wagi części
+// wyrównywane są krokiem balance_kway (np. nowe, puste części przy zwiększeniu ich
+// liczby). REFINE_NONE pomija udoskonalanie
+// Liczba części to options->num_parts; poprzedni podział nie może mieć więcej grup
+// Parametry migrated i added - liczba węzłów poprzedniego podziału, które zmieniły
+// część, oraz liczba nowych węzłów (mogą być NULL)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int repartition_incremental(const Graph* graph, const VertexGroup* previous, int num_previous,
+                            const PartitionOptions* options, int* part_of, int* migrated, int* added) {
+    if (!graph || !previous || !options || !part_of || options->num_parts <= 0 ||
+        num_previous > options->num_parts ||
+        !(options->margin_percentage >= 0) || isinf(options->margin_percentage)) {
+        return -1;
+    }
+
+    int n = graph->total_vertices;
+    int* prior = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!prior) return -1;
+    if (map_previous_groups(graph, previous, num_previous, prior) != 0) {
+        free(prior);
+        return -1;
+    }
+
+    STATS_PHASE_BEGIN(start);
+    memcpy(part_of, prior, (size_t)n * sizeof(int));
+    int new_vertices = assign_new_vertices(graph, part_of, options->num_parts);
+    int status = new_vertices < 0 ? -1 : 0;
+    if (status == 0) {
+        STATS_PHASE_BEGIN(refine_start);
+        if (options->refinement == REFINE_LP) {
+            // Niepełne wyrównanie (status 1) nie przerywa udoskonalania
+            status = balance_kway(graph, part_of, options->num_parts, options->margin_percentage);
+            if (status >= 0) {
+                status = refine_lp(graph, part_of, options->num_parts, options->margin_percentage,
+                                   options->num_threads);
+            }
+        } else if (options->refinement != REFINE_NONE) {
+            status = refine_kway(graph, part_of, options->num_parts, options->margin_percentage);
+        }
+        STATS_PHASE_END(PHASE_REFINE, refine_start);
+    }
+    STATS_PHASE_END(PHASE_PARTITION, start);
+
+    if (status == 0) {
+        int moved = 0;
+        for (int v = 0; v < n; v++) {
+            if (prior[v] >= 0 && prior[v] != part_of[v]) moved++;
+        }
+        if (migrated) *migrated = moved;
+        if (added) *added = new_vertices;
+    }
+    free(prior);
+    return status;
+}
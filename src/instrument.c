@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include "../include/graph.h"
+
+#if INSTRUMENT
+
+// Największa liczba zapamiętywanych wartości przekroju po przejściach KL
+#define STATS_MAX_CUTS 1024
+
+// Nazwy faz i liczników w pliku JSON (w kolejności StatsPhase i StatsCounter)
+static const char* phase_names[PHASE_COUNT] = {
+    "load", "parse", "build_csr", "reorder", "partition", "refine", "cut", "save"
+};
+static const char* counter_names[COUNTER_COUNT] = {
+    "kl_passes", "kl_pair_passes", "kl_gain_evaluations", "kl_swaps", "kl_rollbacks",
+    "fm_passes", "fm_moves", "fm_rollbacks",
+    "kway_passes", "kway_moves", "kway_unbalanced",
+    "lp_iterations", "lp_moves"
+};
+
+// Stan instrumentacji wspólny dla wszystkich wątków
+// Czasy i liczniki aktualizowane są atomowo, ponieważ fazy mogą być wykonywane
+// równolegle (np. udoskonalanie w wielu startach); czas fazy jest wtedy sumą czasów
+// wszystkich wywołań
+static atomic_bool enabled;
+static atomic_long phase_ns[PHASE_COUNT];
+static atomic_long phase_calls[PHASE_COUNT];
+static atomic_long counters[COUNTER_COUNT];
+static pthread_mutex_t cuts_lock = PTHREAD_MUTEX_INITIALIZER;
+static long cuts[STATS_MAX_CUTS];
+static int num_cuts;
+
+// Funkcja włączająca zbieranie pomiarów (domyślnie wyłączone)
+void stats_enable(void) {
+    atomic_store(&enabled, true);
+}
+
+// Funkcja sprawdzająca, czy pomiary są zbierane
+bool stats_enabled(void) {
+    return atomic_load_explicit(&enabled, memory_order_relaxed);
+}
+
+// Funkcja zwracająca czas monotoniczny w nanosekundach
+static long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// Funkcja rozpoczynająca pomiar fazy
+// Zwraca znacznik czasu przekazywany do stats_phase_end (0 przy wyłączonych pomiarach)
+long stats_phase_begin(void) {
+    return stats_enabled() ? now_ns() : 0;
+}
+
+// Funkcja kończąca pomiar fazy rozpoczęty w chwili start
+void stats_phase_end(StatsPhase phase, long start) {
+    if (!stats_enabled()) return;
+    atomic_fetch_add_explicit(&phase_ns[phase], now_ns() - start, memory_order_relaxed);
+    atomic_fetch_add_explicit(&phase_calls[phase], 1, memory_order_relaxed);
+}
+
+// Funkcja zwiększająca licznik o value
+void stats_add(StatsCounter counter, long value) {
+    if (!stats_enabled()) return;
+    atomic_fetch_add_explicit(&counters[counter], value, memory_order_relaxed);
+}
+
+// Funkcja zapamiętująca przekrój po przejściu KL
+// Przy równoległych startach wartości kolejnych startów przeplatają się
+void stats_record_cut(long cut) {
+    if (!stats_enabled()) return;
+    pthread_mutex_lock(&cuts_lock);
+    if (num_cuts < STATS_MAX_CUTS) cuts[num_cuts++] = cut;
+    pthread_mutex_unlock(&cuts_lock);
+}
+
+// Funkcja zapisująca zebrane pomiary do pliku w formacie JSON
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int stats_write_json(const char* filename) {
+    OutputBuffer out;
+    if (output_open(&out, filename) != 0) return -1;
+
+    char text[256];
+    output_string(&out, "{\n  \"instrumented\": true,\n  \"phases\": {\n");
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        snprintf(text, sizeof(text), "    \"%s\": {\"calls\": %ld, \"total_ms\": %.4f}%s\n", phase_names[p],
+                 atomic_load(&phase_calls[p]), atomic_load(&phase_ns[p]) / 1e6,
+                 p + 1 < PHASE_COUNT ? "," : "");
+        output_string(&out, text);
+    }
+    output_string(&out, "  },\n  \"counters\": {\n");
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        snprintf(text, sizeof(text), "    \"%s\": %ld%s\n", counter_names[c], atomic_load(&counters[c]),
+                 c + 1 < COUNTER_COUNT ? "," : "");
+        output_string(&out, text);
+    }
+    output_string(&out, "  },\n  \"kl_pass_cuts\": [");
+    pthread_mutex_lock(&cuts_lock);
+    for (int i = 0; i < num_cuts; i++) {
+        snprintf(text, sizeof(text), "%s%ld", i > 0 ? ", " : "", cuts[i]);
+        output_string(&out, text);
+    }
+    pthread_mutex_unlock(&cuts_lock);
+    output_string(&out, "]\n}\n");
+
+    return output_close(&out);
+}
+
+#else
+
+// Wersja bez instrumentacji: pomiary nie są dostępne
+int stats_write_json(const char* filename) {
+    (void)filename;
+    return -1;
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "../include/graph.h"
+
+// Wersje wektorowe kompilowane są atrybutem target, więc program uruchamia się także
+// na procesorach bez AVX2; wybór wersji następuje w czasie działania (kernels_select)
+#if defined(__x86_64__) && defined(__GNUC__)
+#define KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define KERNELS_X86 0
+#endif
+
+// Wersje pętli dla identyfikatorów 16-bitowych
+#define INDEX_TYPE uint16_t
+#define KERNEL(name) name##_16
+#include "kernels.inc"
+#undef INDEX_TYPE
+#undef KERNEL
+
+// Wersje pętli dla identyfikatorów 32-bitowych
+#define INDEX_TYPE int32_t
+#define KERNEL(name) name##_32
+#include "kernels.inc"
+#undef INDEX_TYPE
+#undef KERNEL
+
+#if KERNELS_X86
+#define INDEX_TYPE uint16_t
+#define KERNEL(name) name##_16
+#define LOAD_INDICES_8(ptr) _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(ptr)))
+#define LOAD_INDICES_16(mask, ptr) _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, ptr))
+#include "kernels_simd.inc"
+#undef INDEX_TYPE
+#undef KERNEL
+#undef LOAD_INDICES_8
+#undef LOAD_INDICES_16
+
+#define INDEX_TYPE int32_t
+#define KERNEL(name) name##_32
+#define LOAD_INDICES_8(ptr) _mm256_loadu_si256((const __m256i*)(ptr))
+#define LOAD_INDICES_16(mask, ptr) _mm512_maskz_loadu_epi32(mask, ptr)
+#include "kernels_simd.inc"
+#undef INDEX_TYPE
+#undef KERNEL
+#undef LOAD_INDICES_8
+#undef LOAD_INDICES_16
+#endif
+
+// Wersje pętli dla list skompresowanych (graph_compress), dekodowanych w locie
+static long cut_from_parts_compressed(const Graph* graph, const int* part_of) {
+    long cut = 0;
+    for (int v = 0; v < graph->total_vertices; v++) {
+        int own = part_of[v];
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            if (it.neighbor > v && part_of[it.neighbor] != own) cut += neighbor_weight(graph, &it);
+        }
+    }
+    return cut;
+}
+
+static void part_degrees_compressed(const Graph* graph, const int* part_of, int* internal, int* external) {
+    for (int v = 0; v < graph->total_vertices; v++) {
+        int own = part_of[v];
+        int inside = 0;
+        int outside = 0;
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            if (part_of[it.neighbor] == own) inside += neighbor_weight(graph, &it);
+            else outside += neighbor_weight(graph, &it);
+        }
+        internal[v] = inside;
+        external[v] = outside;
+    }
+}
+
+static int pair_weights_compressed(const Graph* graph, const int* part_of, int vertex, int part, int other,
+                                   int* to_part, int* to_other) {
+    int inside = 0;
+    int outside = 0;
+    int count = 0;
+    FOR_EACH_NEIGHBOR(graph, vertex, it) {
+        int neighbor_part = part_of[it.neighbor];
+        if (neighbor_part == part) inside += neighbor_weight(graph, &it);
+        if (neighbor_part == other) {
+            outside += neighbor_weight(graph, &it);
+            count++;
+        }
+    }
+    *to_part = inside;
+    *to_other = outside;
+    return count;
+}
+
+// Wybrana wersja pętli (-1 - jeszcze nie wybrano)
+static atomic_int selected_isa = -1;
+
+// Funkcja zwracająca najszerszą wersję pętli obsługiwaną przez procesor
+KernelIsa kernels_supported(void) {
+#if KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("popcnt")) {
+        return KERNEL_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return KERNEL_AVX2;
+#endif
+    return KERNEL_SCALAR;
+}
+
+// Funkcja wybierająca wersję pętli; wersja nieobsługiwana przez procesor zastępowana
+// jest najszerszą obsługiwaną
+// Zwraca faktycznie wybraną wersję
+KernelIsa kernels_select(KernelIsa isa) {
+    KernelIsa supported = kernels_supported();
+    if (isa > supported) isa = supported;
+    atomic_store(&selected_isa, (int)isa);
+    return isa;
+}
+
+// Funkcja zwracająca bieżącą wersję pętli
+// Domyślnie jest to AVX2 (o ile procesor ją obsługuje): listy sąsiadów mają zwykle
+// kilka pozycji, więc 16-pozycyjne wektory AVX-512 są w większości puste i w pomiarach
+// (bench_kernels) wypadają wolniej niż AVX2; AVX-512 można wybrać przez kernels_select
+KernelIsa kernels_selected(void) {
+    int isa = atomic_load_explicit(&selected_isa, memory_order_relaxed);
+    if (isa < 0) isa = (int)kernels_select(KERNEL_AVX2);
+    return (KernelIsa)isa;
+}
+
+// Funkcja zwracająca nazwę wersji pętli
+const char* kernels_name(KernelIsa isa) {
+    switch (isa) {
+        case KERNEL_AVX2: return "avx2";
+        case KERNEL_AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+// Funkcja obliczająca liczbę (sumę wag) krawędzi łączących różne części dla przypisania part_of
+// Wybiera wersję pętli odpowiadającą reprezentacji list, szerokości identyfikatorów grafu
+// i wybranej wersji wektorowej
+long calculate_cut_from_parts(const Graph* graph, const int* part_of) {
+    if (graph->adj_offsets) return cut_from_parts_compressed(graph, part_of);
+    bool narrow = graph->index_width == INDEX_WIDTH_16;
+#if KERNELS_X86
+    switch (kernels_selected()) {
+        case KERNEL_AVX512:
+            return narrow ? cut_from_parts_avx512_16(graph, part_of) : cut_from_parts_avx512_32(graph, part_of);
+        case KERNEL_AVX2:
+            return narrow ? cut_from_parts_avx2_16(graph, part_of) : cut_from_parts_avx2_32(graph, part_of);
+        default:
+            break;
+    }
+#endif
+    return narrow ? cut_from_parts_16(graph, part_of) : cut_from_parts_32(graph, part_of);
+}
+
+// Funkcja obliczająca wagi krawędzi każdego węzła do własnej i do pozostałych części
+// Tablice internal i external muszą mieć rozmiar graph->total_vertices
+void compute_part_degrees(const Graph* graph, const int* part_of, int* internal, int* external) {
+    if (graph->adj_offsets) {
+        part_degrees_compressed(graph, part_of, internal, external);
+        return;
+    }
+    bool narrow = graph->index_width == INDEX_WIDTH_16;
+#if KERNELS_X86
+    switch (kernels_selected()) {
+        case KERNEL_AVX512:
+            if (narrow) part_degrees_avx512_16(graph, part_of, internal, external);
+            else part_degrees_avx512_32(graph, part_of, internal, external);
+            return;
+        case KERNEL_AVX2:
+            if (narrow) part_degrees_avx2_16(graph, part_of, internal, external);
+            else part_degrees_avx2_32(graph, part_of, internal, external);
+            return;
+        default:
+            break;
+    }
+#endif
+    if (narrow) part_degrees_16(graph, part_of, internal, external);
+    else part_degrees_32(graph, part_of, internal, external);
+}
+
+// Funkcja obliczająca wagi krawędzi węzła vertex do części part i do części other
+// (wartość D algorytmu Kernighana-Lina i zysk FM to *to_other - *to_part)
+// Zwraca liczbę sąsiadów w części other (węzeł jest brzegowy, gdy jest dodatnia)
+int neighbor_pair_weights(const Graph* graph, const int* part_of, int vertex, int part, int other,
+                          int* to_part, int* to_other) {
+    if (graph->adj_offsets) return pair_weights_compressed(graph, part_of, vertex, part, other, to_part, to_other);
+    bool narrow = graph->index_width == INDEX_WIDTH_16;
+#if KERNELS_X86
+    switch (kernels_selected()) {
+        case KERNEL_AVX512:
+            return narrow ? pair_weights_avx512_16(graph, part_of, vertex, part, other, to_part, to_other)
+                          : pair_weights_avx512_32(graph, part_of, vertex, part, other, to_part, to_other);
+        case KERNEL_AVX2:
+            return narrow ? pair_weights_avx2_16(graph, part_of, vertex, part, other, to_part, to_other)
+                          : pair_weights_avx2_32(graph, part_of, vertex, part, other, to_part, to_other);
+        default:
+            break;
+    }
+#endif
+    return narrow ? pair_weights_16(graph, part_of, vertex, part, other, to_part, to_other)
+                  : pair_weights_32(graph, part_of, vertex, part, other, to_part, to_other);
+}
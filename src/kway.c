@@ -0,0 +1,375 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "../include/graph.h"
+
+// Maksymalna liczba przejść udoskonalania k-drożnego
+#define KWAY_MAX_PASSES 10
+
+// Przestrzeń robocza udoskonalania k-drożnego
+// Dla każdego węzła utrzymywana jest waga krawędzi do własnej grupy (internal)
+// i do pozostałych grup (external); węzły z external > 0 tworzą zbiór brzegowy
+typedef struct {
+    int* internal;         // Waga krawędzi do węzłów tej samej grupy
+    int* external;         // Waga krawędzi do węzłów innych grup
+    int* boundary;         // Węzły brzegowe (kolejność dowolna)
+    int* boundary_pos;     // Pozycja węzła w tablicy boundary (-1 - węzeł wewnętrzny)
+    int boundary_size;     // Liczba węzłów brzegowych
+    int* snapshot;         // Kopia zbioru brzegowego przeglądana w bieżącym przejściu
+    int* connectivity;     // Waga krawędzi węzła do każdej grupy (zerowana po użyciu)
+    int* touched;          // Grupy z niezerową wartością connectivity
+    int* part_weights;     // Wagi grup
+    int* part_head;        // Pierwszy węzeł listy każdej grupy (NULL - listy nieutworzone)
+    int* part_next;        // Następny węzeł tej samej grupy (-1 - koniec listy)
+    int* part_prev;        // Poprzedni węzeł tej samej grupy (-1 - początek listy)
+    Arena memory;          // Jeden blok, z którego pochodzą tablice przestrzeni roboczej
+} KWayWorkspace;
+
+// Funkcja zwalniająca przestrzeń roboczą
+static void kway_workspace_free(KWayWorkspace* ws) {
+    arena_destroy(&ws->memory);
+}
+
+// Funkcja dodająca węzeł do zbioru brzegowego lub usuwająca go z niego
+// zgodnie z bieżącą wartością external
+static void kway_update_boundary(KWayWorkspace* ws, int vertex) {
+    bool is_boundary = ws->external[vertex] > 0;
+    int pos = ws->boundary_pos[vertex];
+    if (is_boundary && pos < 0) {
+        ws->boundary_pos[vertex] = ws->boundary_size;
+        ws->boundary[ws->boundary_size++] = vertex;
+    } else if (!is_boundary && pos >= 0) {
+        int last = ws->boundary[--ws->boundary_size];
+        ws->boundary[pos] = last;
+        ws->boundary_pos[last] = pos;
+        ws->boundary_pos[vertex] = -1;
+    }
+}
+
+// Funkcja alokująca przestrzeń roboczą i obliczająca wagi krawędzi oraz zbiór brzegowy
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int kway_workspace_init(KWayWorkspace* ws, const Graph* graph, const int* part_of, int num_parts) {
+    int n = graph->total_vertices;
+
+    memset(ws, 0, sizeof(*ws));
+    arena_init(&ws->memory, ((size_t)5 * n + (size_t)3 * num_parts) * sizeof(int) + 8 * ARENA_ALIGNMENT);
+    ws->internal = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->external = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->boundary = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->boundary_pos = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->snapshot = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->connectivity = (int*)arena_calloc(&ws->memory, num_parts, sizeof(int));
+    ws->touched = (int*)arena_alloc(&ws->memory, num_parts, sizeof(int));
+    ws->part_weights = (int*)arena_calloc(&ws->memory, num_parts, sizeof(int));
+    if (!ws->internal || !ws->external || !ws->boundary || !ws->boundary_pos || !ws->snapshot ||
+        !ws->connectivity || !ws->touched || !ws->part_weights) {
+        kway_workspace_free(ws);
+        return -1;
+    }
+
+    compute_part_degrees(graph, part_of, ws->internal, ws->external);
+    for (int v = 0; v < n; v++) {
+        ws->boundary_pos[v] = -1;
+        kway_update_boundary(ws, v);
+        ws->part_weights[part_of[v]] += vertex_weight(graph, v);
+    }
+    return 0;
+}
+
+// Funkcja wybierająca najlepszą grupę docelową dla węzła brzegowego
+// Rozważane są tylko grupy sąsiednie, do których przeniesienie zachowuje granice wag;
+// z grupy przekraczającej maksimum dozwolony jest także ruch o ujemnym zysku
+// Przy równym zysku wybierana jest lżejsza grupa, a ruch o zerowym zysku wykonywany
+// jest tylko wtedy, gdy poprawia zrównoważenie
+// Zwraca numer grupy docelowej lub -1, gdy żaden ruch nie jest korzystny
+static int kway_best_target(const Graph* graph, const int* part_of, KWayWorkspace* ws, int vertex,
+                            const int* min_weight, const int* max_weight) {
+    int from = part_of[vertex];
+    int weight = vertex_weight(graph, vertex);
+    int num_touched = 0;
+
+    // Połączenia węzła z sąsiednimi grupami
+    FOR_EACH_NEIGHBOR(graph, vertex, it) {
+        int part = part_of[it.neighbor];
+        if (part == from) continue;
+        if (ws->connectivity[part] == 0) ws->touched[num_touched++] = part;
+        ws->connectivity[part] += neighbor_weight(graph, &it);
+    }
+
+    bool overweight = ws->part_weights[from] > max_weight[from];
+    bool can_leave = overweight || ws->part_weights[from] - weight >= min_weight[from];
+    int target = -1;
+    int target_gain = 0;
+    for (int t = 0; t < num_touched; t++) {
+        int part = ws->touched[t];
+        int gain = ws->connectivity[part] - ws->internal[vertex];
+        ws->connectivity[part] = 0;
+
+        if (!can_leave || ws->part_weights[part] + weight > max_weight[part]) continue;
+        if (target >= 0 && (gain < target_gain ||
+                            (gain == target_gain && ws->part_weights[part] >= ws->part_weights[target]))) {
+            continue;
+        }
+        if (gain > 0 || overweight ||
+            (gain == 0 && ws->part_weights[part] + weight < ws->part_weights[from])) {
+            target = part;
+            target_gain = gain;
+        }
+    }
+
+    return target;
+}
+
+// Funkcja przenosząca węzeł do grupy to i aktualizująca wagi krawędzi sąsiadów
+static void kway_move(const Graph* graph, int* part_of, KWayWorkspace* ws, int vertex, int to) {
+    int from = part_of[vertex];
+    int weight = vertex_weight(graph, vertex);
+    part_of[vertex] = to;
+    ws->part_weights[from] -= weight;
+    ws->part_weights[to] += weight;
+
+    int internal = 0;
+    int external = 0;
+    FOR_EACH_NEIGHBOR(graph, vertex, it) {
+        int neighbor = it.neighbor;
+        int w = neighbor_weight(graph, &it);
+        int part = part_of[neighbor];
+        if (part == to) {
+            internal += w;
+            ws->internal[neighbor] += w;
+            ws->external[neighbor] -= w;
+        } else {
+            external += w;
+            if (part == from) {
+                ws->internal[neighbor] -= w;
+                ws->external[neighbor] += w;
+            }
+        }
+        kway_update_boundary(ws, neighbor);
+    }
+    ws->internal[vertex] = internal;
+    ws->external[vertex] = external;
+    kway_update_boundary(ws, vertex);
+}
+
+// Funkcja tworząca listy węzłów poszczególnych grup; węzły każdej grupy ułożone są
+// rosnąco według numeru
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int kway_part_lists_init(KWayWorkspace* ws, const int* part_of, int n, int num_parts) {
+    ws->part_head = (int*)arena_alloc(&ws->memory, num_parts, sizeof(int));
+    ws->part_next = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->part_prev = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    if (!ws->part_head || !ws->part_next || !ws->part_prev) {
+        ws->part_head = NULL;
+        return -1;
+    }
+
+    for (int p = 0; p < num_parts; p++) ws->part_head[p] = -1;
+    for (int v = n - 1; v >= 0; v--) {
+        int head = ws->part_head[part_of[v]];
+        ws->part_prev[v] = -1;
+        ws->part_next[v] = head;
+        if (head >= 0) ws->part_prev[head] = v;
+        ws->part_head[part_of[v]] = v;
+    }
+    return 0;
+}
+
+// Funkcja przenosząca węzeł do grupy to z aktualizacją list węzłów grup
+static void kway_balance_move(const Graph* graph, int* part_of, KWayWorkspace* ws, int vertex, int to) {
+    int from = part_of[vertex];
+    int prev = ws->part_prev[vertex];
+    int next = ws->part_next[vertex];
+    if (prev >= 0) ws->part_next[prev] = next;
+    else ws->part_head[from] = next;
+    if (next >= 0) ws->part_prev[next] = prev;
+
+    int head = ws->part_head[to];
+    ws->part_prev[vertex] = -1;
+    ws->part_next[vertex] = head;
+    if (head >= 0) ws->part_prev[head] = vertex;
+    ws->part_head[to] = vertex;
+
+    kway_move(graph, part_of, ws, vertex, to);
+}
+
+// Funkcja doprowadzająca wagi grup do dopuszczalnych zakresów
+// W każdej rundzie wybierana jest grupa o największym nadmiarze (lub, gdy żadna nie
+// przekracza maksimum, grupa z największym zapasem ponad minimum) oraz grupa
+// o największym niedoborze (lub największym wolnym miejscu). Węzły przenoszone są
+// najpierw spośród węzłów brzegowych sąsiadujących z grupą docelową, a w razie
+// potrzeby dowolne, dzięki czemu wyrównanie działa także między grupami, które ze
+// sobą nie sąsiadują. Runda przegląda tylko listę węzłów grupy oddającej, a listy
+// tworzone są dopiero wtedy, gdy któraś grupa narusza granice
+// Zwraca 0, gdy wagi wszystkich grup mieszczą się w granicach, 1, gdy granic nie udało
+// się osiągnąć w 2 * num_parts rundach, -1 w przypadku błędu alokacji
+static int kway_balance(const Graph* graph, int* part_of, KWayWorkspace* ws, int num_parts,
+                        const int* min_weight, const int* max_weight) {
+    int n = graph->total_vertices;
+
+    for (int round = 0; round < 2 * num_parts; round++) {
+        int heavy = 0;
+        int light = 0;
+        for (int p = 1; p < num_parts; p++) {
+            if (ws->part_weights[p] - max_weight[p] > ws->part_weights[heavy] - max_weight[heavy]) heavy = p;
+            if (min_weight[p] - ws->part_weights[p] > min_weight[light] - ws->part_weights[light]) light = p;
+        }
+        bool excess = ws->part_weights[heavy] > max_weight[heavy];
+        bool deficit = ws->part_weights[light] < min_weight[light];
+        if (!excess && !deficit) return 0;
+
+        // Uzupełnienie brakującej strony ruchu
+        for (int p = 0; p < num_parts; p++) {
+            if (!excess && ws->part_weights[p] - min_weight[p] > ws->part_weights[heavy] - min_weight[heavy]) {
+                heavy = p;
+            }
+            if (!deficit && max_weight[p] - ws->part_weights[p] > max_weight[light] - ws->part_weights[light]) {
+                light = p;
+            }
+        }
+        if (heavy == light) break;
+        if (!ws->part_head && kway_part_lists_init(ws, part_of, n, num_parts) != 0) return -1;
+
+        int moves = 0;
+        for (int phase = 0; phase < 2; phase++) {
+            int v = ws->part_head[heavy];
+            while (v >= 0) {
+                if (ws->part_weights[heavy] <= max_weight[heavy] && ws->part_weights[light] >= min_weight[light]) {
+                    break;
+                }
+                int next = ws->part_next[v];
+
+                int weight = vertex_weight(graph, v);
+                bool allowed = ws->part_weights[light] + weight <= max_weight[light] &&
+                               (ws->part_weights[heavy] > max_weight[heavy] ||
+                                ws->part_weights[heavy] - weight >= min_weight[heavy]);
+                if (allowed && phase == 0) {
+                    allowed = false;
+                    if (ws->external[v] > 0) {
+                        FOR_EACH_NEIGHBOR(graph, v, it) {
+                            if (part_of[it.neighbor] == light) {
+                                allowed = true;
+                                break;
+                            }
+                        }
+                    }
+                }
+                if (allowed) {
+                    kway_balance_move(graph, part_of, ws, v, light);
+                    moves++;
+                }
+                v = next;
+            }
+        }
+        if (moves == 0) break;
+    }
+
+    for (int p = 0; p < num_parts; p++) {
+        if (ws->part_weights[p] > max_weight[p] || ws->part_weights[p] < min_weight[p]) {
+            STATS_ADD(COUNTER_KWAY_UNBALANCED, 1);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Funkcja udoskonalająca podział k-drożnie z osobnymi ograniczeniami wagi dla każdej części
+// Najpierw wagi grup doprowadzane są do dopuszczalnych zakresów (kway_balance); gdy
+// się to nie uda, przejścia i tak są wykonywane, a zdarzenie liczy COUNTER_KWAY_UNBALANCED.
+// W jednym przejściu każdy węzeł brzegowy przenoszony jest do najlepszej dopuszczalnej
+// grupy sąsiedniej, o ile ruch zmniejsza przekrój lub poprawia zrównoważenie. Koszt
+// przejścia jest proporcjonalny do sumy stopni węzłów brzegowych, niezależnie od liczby
+// par grup. Przejścia powtarzane są, dopóki przynoszą zmiany (najwyżej KWAY_MAX_PASSES)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int refine_kway_bounded(const Graph* graph, int* part_of, int num_parts,
+                        const int* min_weight, const int* max_weight) {
+    KWayWorkspace ws;
+    if (kway_workspace_init(&ws, graph, part_of, num_parts) != 0) return -1;
+
+    // Wyrównanie wag przed przejściami, które zachowują granice
+    if (kway_balance(graph, part_of, &ws, num_parts, min_weight, max_weight) < 0) {
+        kway_workspace_free(&ws);
+        return -1;
+    }
+
+    for (int pass = 0; pass < KWAY_MAX_PASSES; pass++) {
+        // Zbiór brzegowy zmienia się w trakcie przejścia, dlatego przeglądana jest jego kopia
+        int count = ws.boundary_size;
+        memcpy(ws.snapshot, ws.boundary, count * sizeof(int));
+
+        int moves = 0;
+        for (int i = 0; i < count; i++) {
+            int vertex = ws.snapshot[i];
+            if (ws.external[vertex] == 0) continue;
+
+            int target = kway_best_target(graph, part_of, &ws, vertex, min_weight, max_weight);
+            if (target < 0) continue;
+            kway_move(graph, part_of, &ws, vertex, target);
+            moves++;
+        }
+        STATS_ADD(COUNTER_KWAY_PASSES, 1);
+        STATS_ADD(COUNTER_KWAY_MOVES, moves);
+        if (moves == 0) break;
+    }
+
+    kway_workspace_free(&ws);
+    return 0;
+}
+
+// Funkcja wyznaczająca jednakowe granice wag wszystkich grup dla marginesu margin_percentage
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int kway_uniform_bounds(const Graph* graph, int num_parts, double margin_percentage,
+                               int** min_weight, int** max_weight) {
+    *min_weight = (int*)malloc(num_parts * sizeof(int));
+    *max_weight = (int*)malloc(num_parts * sizeof(int));
+    if (!*min_weight || !*max_weight) {
+        free(*min_weight);
+        free(*max_weight);
+        return -1;
+    }
+
+    int min_size, max_size;
+    compute_part_bounds((int)total_vertex_weight(graph), num_parts, margin_percentage, &min_size, &max_size);
+    for (int i = 0; i < num_parts; i++) {
+        (*min_weight)[i] = min_size;
+        (*max_weight)[i] = max_size;
+    }
+    return 0;
+}
+
+// Funkcja udoskonalająca podział k-drożnie
+// Wagi grup mogą się różnić w granicach marginesu margin_percentage
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int refine_kway(const Graph* graph, int* part_of, int num_parts, double margin_percentage) {
+    int* min_weight;
+    int* max_weight;
+    if (kway_uniform_bounds(graph, num_parts, margin_percentage, &min_weight, &max_weight) != 0) return -1;
+
+    int result = refine_kway_bounded(graph, part_of, num_parts, min_weight, max_weight);
+    free(min_weight);
+    free(max_weight);
+    return result;
+}
+
+// Funkcja doprowadzająca wagi grup do granic marginesu bez przejść udoskonalających
+// (sam krok kway_balance). Służy do wyrównania podziału przed udoskonalaniem, które
+// przenosi węzły tylko do grup sąsiednich, np. propagacją etykiet, i dlatego nie
+// zapełni grup pustych ani nie przesunie wagi między grupami niesąsiadującymi
+// Zwraca 0 w przypadku sukcesu, 1, gdy nie udało się doprowadzić wszystkich grup do
+// granic marginesu (podział pozostaje poprawny), -1 w przypadku błędu alokacji
+int balance_kway(const Graph* graph, int* part_of, int num_parts, double margin_percentage) {
+    int* min_weight;
+    int* max_weight;
+    if (kway_uniform_bounds(graph, num_parts, margin_percentage, &min_weight, &max_weight) != 0) return -1;
+
+    KWayWorkspace ws;
+    int result = kway_workspace_init(&ws, graph, part_of, num_parts);
+    if (result == 0) {
+        result = kway_balance(graph, part_of, &ws, num_parts, min_weight, max_weight);
+        kway_workspace_free(&ws);
+    }
+    free(min_weight);
+    free(max_weight);
+    return result;
+}
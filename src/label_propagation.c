@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "../include/graph.h"
+
+// Parametry równoległej propagacji etykiet
+#define LP_MAX_ITERATIONS 20       // Maksymalna liczba iteracji
+#define LP_CHUNK_VERTICES 4096     // Minimalna liczba węzłów w jednym zadaniu puli
+
+// Wspólny stan iteracji propagacji etykiet
+// Każda faza odczytuje tablice wypełnione w fazie poprzedniej i zapisuje wyłącznie
+// pola węzłów własnego zakresu, więc wątki nie współdzielą danych do zapisu
+// (poza atomowymi wagami części)
+typedef struct {
+    const Graph* graph;
+    int* part_of;               // Bieżące przypisanie węzłów
+    int num_parts;
+    const int* min_weight;      // Dolne ograniczenia wag części
+    const int* max_weight;      // Górne ograniczenia wag części
+    atomic_long* part_weights;  // Wagi części aktualizowane atomowo
+    int* target;                // Proponowana część docelowa (-1 - brak ruchu)
+    int* gain;                  // Zysk proponowanego ruchu
+    bool* approved;             // Ruch zaakceptowany po rozstrzygnięciu konfliktów
+    int* connectivity;          // Bufory połączeń z częściami, num_parts na zadanie
+    int* touched;               // Bufory list części z niezerowym połączeniem
+    long* moves;                // Liczba wykonanych ruchów w każdym zadaniu
+    int num_tasks;              // Liczba zadań (zakresów węzłów)
+} LPContext;
+
+// Funkcja wyznaczająca zakres węzłów zadania o numerze index
+static void lp_task_range(const LPContext* ctx, int index, int* begin, int* end) {
+    int n = ctx->graph->total_vertices;
+    *begin = (int)((long)n * index / ctx->num_tasks);
+    *end = (int)((long)n * (index + 1) / ctx->num_tasks);
+}
+
+// Faza 1: każdy węzeł brzegowy proponuje przeniesienie do sąsiedniej części
+// o największej wadze połączeń, jeśli zmniejsza to przekrój i część ma miejsce
+static void lp_propose_task(void* arg, int index) {
+    LPContext* ctx = (LPContext*)arg;
+    const Graph* graph = ctx->graph;
+    int* connectivity = ctx->connectivity + (size_t)index * ctx->num_parts;
+    int* touched = ctx->touched + (size_t)index * ctx->num_parts;
+    int begin, end;
+    lp_task_range(ctx, index, &begin, &end);
+
+    for (int v = begin; v < end; v++) {
+        int own = ctx->part_of[v];
+        int num_touched = 0;
+        bool boundary = false;
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            int part = ctx->part_of[it.neighbor];
+            if (part != own) boundary = true;
+            if (connectivity[part] == 0) touched[num_touched++] = part;
+            connectivity[part] += neighbor_weight(graph, &it);
+        }
+
+        int target = -1;
+        int best = connectivity[own];
+        if (boundary) {
+            long weight = vertex_weight(graph, v);
+            for (int t = 0; t < num_touched; t++) {
+                int part = touched[t];
+                if (part == own || connectivity[part] <= best) continue;
+                if (atomic_load_explicit(&ctx->part_weights[part], memory_order_relaxed) + weight >
+                    ctx->max_weight[part]) {
+                    continue;
+                }
+                target = part;
+                best = connectivity[part];
+            }
+        }
+        ctx->target[v] = target;
+        ctx->gain[v] = (target >= 0) ? best - connectivity[own] : 0;
+
+        for (int t = 0; t < num_touched; t++) {
+            connectivity[touched[t]] = 0;
+        }
+    }
+}
+
+// Faza 2: rozstrzyganie konfliktów (w stylu algorytmu Jet)
+// Zysk ruchu obliczany jest ponownie przy założeniu, że sąsiedzi o wyższym
+// priorytecie (większy zysk, przy remisie mniejszy indeks) wykonali już swoje ruchy;
+// zachowywane są tylko ruchy, których zysk pozostaje dodatni. Dzięki temu dwa
+// sąsiednie węzły nie zamieniają się częściami jednocześnie, pogarszając przekrój
+static void lp_filter_task(void* arg, int index) {
+    LPContext* ctx = (LPContext*)arg;
+    const Graph* graph = ctx->graph;
+    int begin, end;
+    lp_task_range(ctx, index, &begin, &end);
+
+    for (int v = begin; v < end; v++) {
+        ctx->approved[v] = false;
+        int target = ctx->target[v];
+        if (target < 0) continue;
+
+        int own = ctx->part_of[v];
+        int gain = 0;
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            int u = it.neighbor;
+            int part = ctx->part_of[u];
+            if (ctx->target[u] >= 0 &&
+                (ctx->gain[u] > ctx->gain[v] || (ctx->gain[u] == ctx->gain[v] && u < v))) {
+                part = ctx->target[u];
+            }
+            if (part == target) {
+                gain += neighbor_weight(graph, &it);
+            } else if (part == own) {
+                gain -= neighbor_weight(graph, &it);
+            }
+        }
+        ctx->approved[v] = gain > 0;
+    }
+}
+
+// Faza 3: wykonanie zaakceptowanych ruchów
+// Miejsce w części docelowej rezerwowane jest atomowo; ruch, który przekroczyłby
+// granice wag którejkolwiek z części, jest wycofywany
+static void lp_apply_task(void* arg, int index) {
+    LPContext* ctx = (LPContext*)arg;
+    int begin, end;
+    lp_task_range(ctx, index, &begin, &end);
+
+    long moves = 0;
+    for (int v = begin; v < end; v++) {
+        if (!ctx->approved[v]) continue;
+
+        int own = ctx->part_of[v];
+        int target = ctx->target[v];
+        long weight = vertex_weight(ctx->graph, v);
+        long target_weight = atomic_fetch_add(&ctx->part_weights[target], weight) + weight;
+        if (target_weight > ctx->max_weight[target]) {
+            atomic_fetch_sub(&ctx->part_weights[target], weight);
+            continue;
+        }
+        long own_weight = atomic_fetch_sub(&ctx->part_weights[own], weight) - weight;
+        if (own_weight < ctx->min_weight[own]) {
+            atomic_fetch_add(&ctx->part_weights[own], weight);
+            atomic_fetch_sub(&ctx->part_weights[target], weight);
+            continue;
+        }
+        ctx->part_of[v] = target;
+        moves++;
+    }
+    ctx->moves[index] = moves;
+}
+
+// Funkcja udoskonalająca podział równoległą propagacją etykiet z osobnymi
+// ograniczeniami wagi dla każdej części
+// Każda iteracja składa się z trzech faz wykonywanych równolegle na zakresach węzłów:
+// propozycji ruchów, rozstrzygania konfliktów i wykonania ruchów z atomową kontrolą
+// wag części. Iteracje kończą się, gdy żaden ruch nie został wykonany
+// Parametr num_threads - liczba wątków (1 - wykonanie sekwencyjne)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int refine_lp_bounded(const Graph* graph, int* part_of, int num_parts,
+                      const int* min_weight, const int* max_weight, int num_threads) {
+    int n = graph->total_vertices;
+    if (n == 0) return 0;
+
+    LPContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.graph = graph;
+    ctx.part_of = part_of;
+    ctx.num_parts = num_parts;
+    ctx.min_weight = min_weight;
+    ctx.max_weight = max_weight;
+    ctx.num_tasks = (n + LP_CHUNK_VERTICES - 1) / LP_CHUNK_VERTICES;
+    if (ctx.num_tasks > 4 * num_threads) ctx.num_tasks = 4 * num_threads;
+    if (ctx.num_tasks < 1) ctx.num_tasks = 1;
+
+    ctx.part_weights = (atomic_long*)malloc(num_parts * sizeof(atomic_long));
+    ctx.target = (int*)malloc(n * sizeof(int));
+    ctx.gain = (int*)malloc(n * sizeof(int));
+    ctx.approved = (bool*)malloc(n * sizeof(bool));
+    ctx.connectivity = (int*)calloc((size_t)ctx.num_tasks * num_parts, sizeof(int));
+    ctx.touched = (int*)malloc((size_t)ctx.num_tasks * num_parts * sizeof(int));
+    ctx.moves = (long*)malloc(ctx.num_tasks * sizeof(long));
+    if (!ctx.part_weights || !ctx.target || !ctx.gain || !ctx.approved || !ctx.connectivity ||
+        !ctx.touched || !ctx.moves) {
+        free(ctx.part_weights);
+        free(ctx.target);
+        free(ctx.gain);
+        free(ctx.approved);
+        free(ctx.connectivity);
+        free(ctx.touched);
+        free(ctx.moves);
+        return -1;
+    }
+
+    for (int i = 0; i < num_parts; i++) atomic_init(&ctx.part_weights[i], 0);
+    for (int v = 0; v < n; v++) {
+        atomic_fetch_add_explicit(&ctx.part_weights[part_of[v]], vertex_weight(graph, v), memory_order_relaxed);
+    }
+
+    ThreadPool* pool = (num_threads > 1 && ctx.num_tasks > 1) ? thread_pool_create(num_threads) : NULL;
+    for (int iteration = 0; iteration < LP_MAX_ITERATIONS; iteration++) {
+        thread_pool_run(pool, ctx.num_tasks, lp_propose_task, &ctx);
+        thread_pool_run(pool, ctx.num_tasks, lp_filter_task, &ctx);
+        thread_pool_run(pool, ctx.num_tasks, lp_apply_task, &ctx);
+
+        long moves = 0;
+        for (int i = 0; i < ctx.num_tasks; i++) moves += ctx.moves[i];
+        STATS_ADD(COUNTER_LP_ITERATIONS, 1);
+        STATS_ADD(COUNTER_LP_MOVES, moves);
+        if (moves == 0) break;
+    }
+    thread_pool_destroy(pool);
+
+    free(ctx.part_weights);
+    free(ctx.target);
+    free(ctx.gain);
+    free(ctx.approved);
+    free(ctx.connectivity);
+    free(ctx.touched);
+    free(ctx.moves);
+    return 0;
+}
+
+// Funkcja udoskonalająca podział równoległą propagacją etykiet
+// Wagi grup mogą się różnić w granicach marginesu margin_percentage
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int refine_lp(const Graph* graph, int* part_of, int num_parts, double margin_percentage, int num_threads) {
+    int* min_weight = (int*)malloc(num_parts * sizeof(int));
+    int* max_weight = (int*)malloc(num_parts * sizeof(int));
+    if (!min_weight || !max_weight) {
+        free(min_weight);
+        free(max_weight);
+        return -1;
+    }
+
+    int min_size, max_size;
+    compute_part_bounds((int)total_vertex_weight(graph), num_parts, margin_percentage, &min_size, &max_size);
+    for (int i = 0; i < num_parts; i++) {
+        min_weight[i] = min_size;
+        max_weight[i] = max_size;
+    }
+
+    int result = refine_lp_bounded(graph, part_of, num_parts, min_weight, max_weight, num_threads);
+    free(min_weight);
+    free(max_weight);
+    return result;
+}
@@ -1,32 +1,181 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <unistd.h>
+#include <getopt.h>
 #include "../include/graph.h"
 
+// Wartość zwracana przez getopt_long dla opcji --stats-json (bez krótkiego odpowiednika)
+#define OPT_STATS_JSON 256
+
 // Funkcja wyświetlająca instrukcję użycia programu
 void print_usage(const char* program_name) {
-    printf("Użycie: %s -i plik_wejściowy.csrrg -o plik_wyjściowy.txt -p liczba_części -m margines [-b]\n\n", program_name);
+    printf("Użycie: %s -i plik_wejściowy.csrrg -o plik_wyjściowy.txt -p liczba_części -m margines [-b] [-F format] [-j wątki] [-r kl|fm|kway|lp|none] [-I contiguous|geometric] [-M] [-S ziarno] [-s starty] [-C] [-P poprzedni_podział] [-O rcm|bfs] [-z] [--stats-json plik]\n\n", program_name);
     printf("Opcje:\n");
-    printf("  -i plik_wejściowy   Ścieżka do pliku wejściowego w formacie CSRRG\n");
+    printf("  -i plik_wejściowy   Ścieżka do pliku wejściowego w formacie CSRRG lub .csrb\n");
     printf("  -o plik_wyjściowy   Ścieżka do pliku wyjściowego (domyślnie: output.txt)\n");
     printf("  -p liczba_części    Liczba części na które podzielić graf (domyślnie: 2)\n");
     printf("  -m margines         Maksymalna dozwolona różnica wielkości między częściami w %% (domyślnie: 20)\n");
     printf("  -b                  Zapisz wynik w formacie binarnym\n");
-    printf("  -h                  Wyświetl tę pomoc\n");
+    printf("  -F format           Format pliku wynikowego (domyślnie: groups):\n");
+    printf("                        groups - listy węzłów kolejnych grup\n");
+    printf("                        part - numer części każdego węzła (jak pliki .part METIS)\n");
+    printf("                        varint - skompresowane listy grup (zawsze binarnie)\n");
+    printf("  -j wątki            Liczba wątków używanych do wczytywania grafu, wykonywania startów\n");
+    printf("                      i udoskonalania lp (domyślnie: 1)\n");
+    printf("  -r algorytm         Algorytm udoskonalania podziału (domyślnie: kl):\n");
+    printf("                        kl - zamiany par węzłów, części o równych rozmiarach\n");
+    printf("                        fm - przenoszenie węzłów w granicach marginesu\n");
+    printf("                        kway - przenoszenie węzłów brzegowych do najlepszej sąsiedniej części\n");
+    printf("                        lp - równoległa propagacja etykiet (liczba wątków: -j)\n");
+    printf("                        none - bez udoskonalania (wynikiem jest podział początkowy)\n");
+    printf("  -I podział          Podział początkowy trybu jednopoziomowego (domyślnie: contiguous):\n");
+    printf("                        contiguous - równe, ciągłe zakresy indeksów węzłów\n");
+    printf("                        geometric - rekurencyjna bisekcja inercyjna według wiersza i kolumny\n");
+    printf("                        węzła w macierzy; z -r none najszybszy tryb podziału\n");
+    printf("  -M                  Podział wielopoziomowy (zgrubianie grafu, podział, udoskonalanie)\n");
+    printf("  -S ziarno           Ziarno generatora liczb losowych trybu wielopoziomowego (domyślnie: 1)\n");
+    printf("  -s starty           Liczba niezależnych startów podziału; zachowywany jest najlepszy (domyślnie: 1)\n");
+    printf("  -C                  Dziel osobno każdą spójną składową grafu: duże składowe dzielone są\n");
+    printf("                      równolegle (liczba wątków: -j), małe trafiają w całości do najlżejszych części\n");
+    printf("  -P plik_podziału    Podział przyrostowy: przenieś poprzedni podział (plik binarny) na graf,\n");
+    printf("                      przypisz nowe węzły do części większości sąsiadów i udoskonal tylko\n");
+    printf("                      węzły brzegowe (kway, a dla -r lp propagacja etykiet); liczba części\n");
+    printf("                      domyślnie jak w poprzednim podziale, opcje -M i -s są pomijane\n");
+    printf("  -O kolejność        Przenumeruj węzły po wczytaniu dla lokalności odwołań do pamięci:\n");
+    printf("                        rcm - odwrócona kolejność Cuthilla-McKee\n");
+    printf("                        bfs - przeszukiwanie wszerz\n");
+    printf("                      pliki wynikowe i poprzedni podział (-P) używają pierwotnych indeksów węzłów\n");
+    printf("  -z                  Przechowuj listy sąsiadów w postaci skompresowanej (różnice varint),\n");
+    printf("                      dekodowanej w locie: mniej pamięci kosztem czasu podziału; wynik bez zmian\n");
+    printf("                      (nie dotyczy plików .csrb, które są odwzorowywane bez kopiowania)\n");
+    printf("  --stats-json plik   Zapisz czasy faz i liczniki udoskonalania w formacie JSON\n");
+    printf("  -h                  Wyświetl tę pomoc\n\n");
+    printf("Plik wejściowy może być także w formacie binarnym .csrb, który jest wczytywany\n");
+    printf("bez parsowania (odwzorowanie pliku w pamięci). Konwersja z formatu CSRRG:\n");
+    printf("  %s convert plik_wejściowy.csrrg plik_wyjściowy.csrb [-j wątki] [-O rcm|bfs]\n", program_name);
+    printf("Serwer podziału utrzymujący wczytane grafy w pamięci (klient: graph_client):\n");
+    printf("  %s serve ścieżka_gniazda [-w wątki_obsługi] [-j wątki_podziału] [-c liczba_grafów] [-z]\n", program_name);
+    printf("Wsadowe wykonanie zadań z pliku (wiersz: plik_grafu liczba_części margines [plik_wyjściowy]);\n");
+    printf("każdy graf wczytywany jest raz, a jego zadania wykonywane równolegle (-w), z tabelą wyników:\n");
+    printf("  %s batch plik_zadań [-w wątki_zadań] [-j wątki_podziału] [-o plik_podsumowania]\n", program_name);
+    printf("        [-r kl|fm|kway|lp|none] [-I contiguous|geometric] [-M] [-S ziarno] [-s starty] [-C] [-F format] [-b]\n");
+}
+
+// Funkcja odczytująca nazwę kolejności węzłów (opcja -O)
+// Zwraca 0 w przypadku sukcesu, -1 dla nieznanej nazwy
+static int parse_ordering(const char* name, VertexOrdering* ordering) {
+    if (strcmp(name, "rcm") == 0) {
+        *ordering = ORDER_RCM;
+    } else if (strcmp(name, "bfs") == 0) {
+        *ordering = ORDER_BFS;
+    } else {
+        fprintf(stderr, "Błąd: Nieznana kolejność węzłów: %s\n", name);
+        return -1;
+    }
+    return 0;
+}
+
+// Podpolecenie convert: zapis grafu CSRRG w formacie binarnym .csrb
+// Z opcją -O zapisywany jest graf przenumerowany (wraz z pierwotnymi indeksami węzłów)
+// Po zapisaniu plik jest wczytywany ponownie w celu sprawdzenia sumy kontrolnej
+// Zwraca kod wyjścia programu
+static int convert_command(int argc, char* argv[]) {
+    int num_threads = 1;
+    VertexOrdering ordering = ORDER_NONE;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:O:")) != -1) {
+        if (opt == 'O') {
+            if (parse_ordering(optarg, &ordering) != 0) return 1;
+        } else if (opt != 'j' || (num_threads = atoi(optarg)) <= 0) {
+            fprintf(stderr, "Błąd: Nieprawidłowa opcja polecenia convert\n");
+            return 1;
+        }
+    }
+    if (argc - optind != 2) {
+        fprintf(stderr, "Błąd: Polecenie convert wymaga pliku wejściowego i wyjściowego\n");
+        return 1;
+    }
+    const char* input_file = argv[optind];
+    const char* output_file = argv[optind + 1];
+
+    Graph* graph = NULL;
+    if (load_graph_from_file_parallel(input_file, &graph, num_threads) != 0) {
+        fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", input_file);
+        return 1;
+    }
+    if (graph_reorder(graph, ordering) != 0) {
+        fprintf(stderr, "Błąd: Nie udało się przenumerować węzłów grafu\n");
+        destroy_graph(graph);
+        return 1;
+    }
+    int result = save_graph_binary(output_file, graph);
+    destroy_graph(graph);
+    if (result != 0) {
+        fprintf(stderr, "Błąd: Nie udało się zapisać grafu do pliku: %s\n", output_file);
+        return 1;
+    }
+    if (verify_graph_binary(output_file) != 0) {
+        fprintf(stderr, "Błąd: Niepoprawna suma kontrolna zapisanego pliku: %s\n", output_file);
+        return 1;
+    }
+    printf("Graf zapisano w formacie binarnym do pliku: %s\n", output_file);
+    return 0;
+}
+
+// Funkcja wyznaczająca podział przyrostowy na podstawie poprzedniego podziału
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int divide_graph_incremental(const Graph* graph, const VertexGroup* previous, int num_previous,
+                                    const PartitionOptions* options, VertexGroup** groups,
+                                    int* migrated, int* added) {
+    int n = graph->total_vertices;
+    int* part_of = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!part_of) return -1;
+    int result = repartition_incremental(graph, previous, num_previous, options, part_of, migrated, added);
+    if (result == 0) result = partition_to_groups(part_of, n, options->num_parts, groups);
+    free(part_of);
+    return result;
 }
 
 int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "convert") == 0) {
+        return convert_command(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "serve") == 0) {
+        return serve_command(argc - 1, argv + 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "batch") == 0) {
+        return batch_command(argc - 1, argv + 1);
+    }
+
     // Inicjalizacja zmiennych z wartościami domyślnymi
     const char* input_file = NULL;        // Ścieżka do pliku wejściowego
     const char* output_file = "output.txt"; // Domyślna ścieżka do pliku wyjściowego
     int num_parts = 2;                    // Domyślna liczba części grafu
     double margin_percentage = 20.0;      // Domyślny margines procentowy
     bool binary_output = false;           // Flaga określająca format wyjściowy
+    DivisionFormat output_format = DIVISION_GROUPS; // Układ danych w pliku wyjściowym
+    int num_threads = 1;                  // Liczba wątków roboczych
+    RefinementMode refinement = REFINE_KL; // Algorytm udoskonalania podziału
+    InitialPartition initial = INITIAL_CONTIGUOUS; // Podział początkowy
+    bool multilevel = false;              // Flaga podziału wielopoziomowego
+    unsigned int seed = 1;                // Ziarno generatora liczb losowych
+    int num_starts = 1;                   // Liczba niezależnych startów podziału
+    const char* stats_file = NULL;        // Plik JSON z pomiarami (--stats-json)
+    const char* previous_file = NULL;     // Poprzedni podział dla podziału przyrostowego
+    bool parts_given = false;             // Czy liczbę części podano jawnie (-p)
+    bool compress = false;                // Kompresja list sąsiadów po wczytaniu
+    VertexOrdering ordering = ORDER_NONE; // Przenumerowanie węzłów po wczytaniu
+    bool components = false;              // Osobny podział spójnych składowych
     
     // Parsowanie argumentów wiersza poleceń
+    static const struct option long_options[] = {
+        {"stats-json", required_argument, NULL, OPT_STATS_JSON},
+        {NULL, 0, NULL, 0}
+    };
     int opt;
-    while ((opt = getopt(argc, argv, "hi:o:p:m:b")) != -1) {
+    while ((opt = getopt_long(argc, argv, "hi:o:p:m:bF:j:r:I:MS:s:CP:O:z", long_options, NULL)) != -1) {
         switch (opt) {
             case 'h':
                 print_usage(argv[0]);
@@ -43,17 +192,91 @@ int main(int argc, char *argv[]) {
                     fprintf(stderr, "Błąd: Liczba części musi być większa od 0\n");
                     return 1;
                 }
+                parts_given = true;
                 break;
             case 'm':
                 margin_percentage = atof(optarg);
-                if (margin_percentage < 0) {
-                    fprintf(stderr, "Błąd: Margines procentowy nie może być ujemny\n");
+                if (!(margin_percentage >= 0) || isinf(margin_percentage)) {
+                    fprintf(stderr, "Błąd: Margines procentowy musi być skończoną liczbą nieujemną\n");
                     return 1;
                 }
                 break;
             case 'b':
                 binary_output = true;
                 break;
+            case 'F':
+                if (strcmp(optarg, "groups") == 0) {
+                    output_format = DIVISION_GROUPS;
+                } else if (strcmp(optarg, "part") == 0) {
+                    output_format = DIVISION_PART_VECTOR;
+                } else if (strcmp(optarg, "varint") == 0) {
+                    output_format = DIVISION_VARINT;
+                } else {
+                    fprintf(stderr, "Błąd: Nieznany format pliku wynikowego: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'j':
+                num_threads = atoi(optarg);
+                if (num_threads <= 0) {
+                    fprintf(stderr, "Błąd: Liczba wątków musi być większa od 0\n");
+                    return 1;
+                }
+                break;
+            case 'r':
+                if (strcmp(optarg, "kl") == 0) {
+                    refinement = REFINE_KL;
+                } else if (strcmp(optarg, "fm") == 0) {
+                    refinement = REFINE_FM;
+                } else if (strcmp(optarg, "kway") == 0) {
+                    refinement = REFINE_KWAY;
+                } else if (strcmp(optarg, "lp") == 0) {
+                    refinement = REFINE_LP;
+                } else if (strcmp(optarg, "none") == 0) {
+                    refinement = REFINE_NONE;
+                } else {
+                    fprintf(stderr, "Błąd: Nieznany algorytm udoskonalania: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'I':
+                if (strcmp(optarg, "contiguous") == 0) {
+                    initial = INITIAL_CONTIGUOUS;
+                } else if (strcmp(optarg, "geometric") == 0) {
+                    initial = INITIAL_GEOMETRIC;
+                } else {
+                    fprintf(stderr, "Błąd: Nieznany podział początkowy: %s\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'M':
+                multilevel = true;
+                break;
+            case 'S':
+                seed = (unsigned int)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                num_starts = atoi(optarg);
+                if (num_starts <= 0) {
+                    fprintf(stderr, "Błąd: Liczba startów musi być większa od 0\n");
+                    return 1;
+                }
+                break;
+            case 'C':
+                components = true;
+                break;
+            case 'P':
+                previous_file = optarg;
+                break;
+            case 'O':
+                if (parse_ordering(optarg, &ordering) != 0) return 1;
+                break;
+            case 'z':
+                compress = true;
+                break;
+            case OPT_STATS_JSON:
+                stats_file = optarg;
+                break;
             default:
                 print_usage(argv[0]);
                 return 1;
@@ -67,9 +290,19 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    // Włączenie pomiarów faz i liczników
+    if (stats_file) {
+#if INSTRUMENT
+        stats_enable();
+#else
+        fprintf(stderr, "Błąd: Program zbudowano bez instrumentacji (INSTRUMENT=0), opcja --stats-json jest niedostępna\n");
+        return 1;
+#endif
+    }
+
     // Wczytanie grafu z pliku
     Graph* graph = NULL;
-    if (load_graph_from_file(input_file, &graph) != 0) {
+    if (load_graph_from_file_parallel(input_file, &graph, num_threads) != 0) {
         fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", input_file);
         return 1;
     }
@@ -78,14 +311,89 @@ int main(int argc, char *argv[]) {
     printf("Wczytano graf z pliku: %s\n", input_file);
     print_graph_info(graph);
 
+    // Przenumerowanie musi poprzedzać kompresję, która zależy od kolejności węzłów
+    if (ordering != ORDER_NONE) {
+        double gap = graph_average_gap(graph);
+        if (graph_reorder(graph, ordering) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się przenumerować węzłów grafu%s\n",
+                    graph->mapping ? " (plik .csrb należy przenumerować poleceniem convert -O)" : "");
+            destroy_graph(graph);
+            return 1;
+        }
+        printf("\nWęzły przenumerowano (%s): średnia odległość numerów sąsiadów %.1f -> %.1f\n",
+               ordering == ORDER_RCM ? "rcm" : "bfs", gap, graph_average_gap(graph));
+    }
+
+    if (compress) {
+        size_t csr_bytes = graph_adjacency_bytes(graph);
+        if (graph_compress(graph) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się skompresować list sąsiadów grafu\n");
+            destroy_graph(graph);
+            return 1;
+        }
+        printf("\nListy sąsiadów skompresowano: %zu -> %zu bajtów\n", csr_bytes, graph_adjacency_bytes(graph));
+    }
+
+    if (components) {
+        int* component_of = (int*)malloc((graph->total_vertices > 0 ? graph->total_vertices : 1) * sizeof(int));
+        int num_components = component_of ? find_components(graph, component_of) : -1;
+        free(component_of);
+        if (num_components < 0) {
+            fprintf(stderr, "Błąd: Nie udało się wyznaczyć spójnych składowych grafu\n");
+            destroy_graph(graph);
+            return 1;
+        }
+        printf("\nLiczba spójnych składowych: %d\n", num_components);
+    }
+
+    if (initial == INITIAL_GEOMETRIC && !graph->vertex_cols) {
+        fprintf(stderr, "Błąd: Graf nie zawiera położeń węzłów wymaganych przez podział geometryczny\n");
+        destroy_graph(graph);
+        return 1;
+    }
+
+    // Wczytanie poprzedniego podziału (podział przyrostowy)
+    VertexGroup* previous = NULL;
+    int num_previous = 0;
+    if (previous_file) {
+        if (load_graph_division(previous_file, &previous, &num_previous) != 0) {
+            fprintf(stderr, "Błąd: Nie udało się wczytać poprzedniego podziału z pliku: %s\n", previous_file);
+            destroy_graph(graph);
+            return 1;
+        }
+        if (!parts_given) num_parts = num_previous;
+        if (num_previous > num_parts || num_parts <= 0) {
+            fprintf(stderr, "Błąd: Poprzedni podział ma %d grup, a żądana liczba części to %d\n",
+                    num_previous, num_parts);
+            for (int i = 0; i < num_previous; i++) free(previous[i].vertices);
+            free(previous);
+            destroy_graph(graph);
+            return 1;
+        }
+    }
+
     // Podział grafu na określoną liczbę części
     VertexGroup* groups = NULL;
-    if (graph->total_vertices > 1000) {
-        printf("\nRozpoczynam podział dużego grafu (%d wierzchołków)...\n", graph->total_vertices);
-        printf("To może potrwać kilka minut. Proszę czekać...\n\n");
-    }
-    
-    if (divide_graph(graph, num_parts, margin_percentage, &groups) != 0) {
+    PartitionOptions options;
+    partition_options_init(&options);
+    options.num_parts = num_parts;
+    options.margin_percentage = margin_percentage;
+    options.refinement = refinement;
+    options.initial = initial;
+    options.multilevel = multilevel;
+    options.seed = seed;
+    options.num_starts = num_starts;
+    options.num_threads = num_threads;
+    options.components = components;
+
+    int migrated = 0;                     // Węzły, które zmieniły część względem poprzedniego podziału
+    int added = 0;                        // Węzły nieobecne w poprzednim podziale
+    int status = previous
+        ? divide_graph_incremental(graph, previous, num_previous, &options, &groups, &migrated, &added)
+        : divide_graph_with_options(graph, &options, &groups);
+    for (int i = 0; i < num_previous; i++) free(previous[i].vertices);
+    free(previous);
+    if (status != 0) {
         fprintf(stderr, "Błąd: Nie udało się podzielić grafu\n");
         destroy_graph(graph);
         return 1;
@@ -99,20 +407,29 @@ int main(int argc, char *argv[]) {
     }
 
     // Obliczenie liczby krawędzi między grupami
-    int cross_edges = calculate_edges_between_groups(graph, groups, num_parts);
+    long cross_edges = calculate_edges_between_groups(graph, groups, num_parts);
 
     // Wyświetlenie informacji o podziale
-    print_division_info(groups, num_parts);
-    printf("Liczba krawędzi między grupami: %d\n", cross_edges);
+    print_division_info(graph, groups, num_parts);
+    printf("Liczba krawędzi między grupami: %ld\n", cross_edges);
     printf("Różnica wielkości między grupami: %.2f%%\n", size_diff);
+    if (previous_file) {
+        printf("Nowe węzły (brak w poprzednim podziale): %d\n", added);
+        printf("Węzły przeniesione do innej części (migracja): %d\n", migrated);
+    }
 
     // Zapisanie wyniku podziału do pliku
-    if (save_graph_division(output_file, graph, groups, num_parts, binary_output) != 0) {
+    if (save_graph_division_format(output_file, graph, groups, num_parts, output_format, binary_output) != 0) {
         fprintf(stderr, "Błąd: Nie udało się zapisać podziału do pliku: %s\n", output_file);
     } else {
         printf("\nPodział zapisano do pliku: %s\n", output_file);
     }
 
+    // Zapisanie pomiarów
+    if (stats_file && stats_write_json(stats_file) != 0) {
+        fprintf(stderr, "Błąd: Nie udało się zapisać pomiarów do pliku: %s\n", stats_file);
+    }
+
     // Zwolnienie zaalokowanej pamięci
     for (int i = 0; i < num_parts; i++) {
         free(groups[i].vertices);
@@ -0,0 +1,469 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <math.h>
+#include "../include/graph.h"
+
+// Parametry zgrubiania
+#define COARSEN_VERTICES_PER_PART 20   // Docelowa liczba węzłów najgrubszego grafu na część
+#define COARSEN_MIN_VERTICES 100       // Minimalna liczba węzłów najgrubszego grafu
+#define COARSEN_MIN_REDUCTION 0.95     // Zgrubianie kończy się, gdy poziom zmniejsza graf o mniej niż 5%
+#define INITIAL_PARTITION_TRIALS 4     // Liczba prób podziału początkowego każdej bisekcji
+
+// Poziom hierarchii grafów: graf i odwzorowanie jego węzłów na węzły poziomu grubszego
+// Grafy grubsze i odwzorowania leżą w arenie hierarchii kontekstu podziału
+typedef struct {
+    Graph* graph;   // Graf poziomu (poziom 0 to graf wejściowy należący do wywołującego)
+    int* cmap;      // Węzeł tego poziomu -> węzeł poziomu następnego
+} Level;
+
+// Funkcja tasująca tablicę indeksów 0..n-1 (algorytm Fishera-Yatesa)
+static void random_permutation(int* order, int n, uint64_t* rng) {
+    for (int i = 0; i < n; i++) order[i] = i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(random_next(rng) % (uint32_t)(i + 1));
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+}
+
+// Funkcja tworząca graf grubszy przez skojarzenie krawędzi o największych wagach
+// Węzły odwiedzane są w losowej kolejności; każdy nieskojarzony węzeł łączony jest z
+// nieskojarzonym sąsiadem połączonym najcięższą krawędzią (heavy-edge matching),
+// o ile łączna waga pary nie przekracza max_vertex_weight. Pary stają się węzłami
+// grafu grubszego, a równoległe krawędzie są scalane z sumowaniem wag
+// Graf grubszy tworzony jest w arenie hierarchii, a tablice pomocnicze w arenie roboczej,
+// która po zgrubieniu wraca do stanu sprzed wywołania
+// Parametr cmap - tablica wynikowa odwzorowania węzłów (rozmiar graph->total_vertices)
+// Zwraca graf grubszy lub NULL w przypadku błędu alokacji
+static Graph* coarsen_graph(PartitionContext* context, const Graph* graph, int* cmap, int max_vertex_weight,
+                            uint64_t* rng) {
+    int n = graph->total_vertices;
+    Arena* scratch = &context->scratch;
+    ArenaMark mark = arena_mark(scratch);
+    int* match = (int*)arena_alloc(scratch, n, sizeof(int));
+    int* order = (int*)arena_alloc(scratch, n, sizeof(int));
+    if (!match || !order) {
+        arena_release(scratch, mark);
+        return NULL;
+    }
+
+    // Skojarzenie węzłów
+    for (int v = 0; v < n; v++) match[v] = -1;
+    random_permutation(order, n, rng);
+    for (int i = 0; i < n; i++) {
+        int v = order[i];
+        if (match[v] != -1) continue;
+
+        int best = -1;
+        int best_weight = 0;
+        int v_weight = vertex_weight(graph, v);
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            int u = it.neighbor;
+            if (match[u] != -1 || v_weight + vertex_weight(graph, u) > max_vertex_weight) continue;
+            int w = neighbor_weight(graph, &it);
+            if (w > best_weight || (w == best_weight && best >= 0 && vertex_weight(graph, u) < vertex_weight(graph, best))) {
+                best = u;
+                best_weight = w;
+            }
+        }
+        if (best >= 0) {
+            match[v] = best;
+            match[best] = v;
+        } else {
+            match[v] = v;
+        }
+    }
+
+    // Numeracja węzłów grafu grubszego
+    int coarse_n = 0;
+    for (int v = 0; v < n; v++) {
+        if (v <= match[v]) {
+            cmap[v] = coarse_n;
+            cmap[match[v]] = coarse_n;
+            coarse_n++;
+        }
+    }
+
+    // Listy sąsiadów budowane są w arenie roboczej z zapasem (fine_edges pozycji)
+    // i dopiero potem kopiowane do hierarchii w dokładnym rozmiarze
+    int64_t fine_edges = 2 * graph->num_edges;
+    int64_t* slot = (int64_t*)arena_alloc(scratch, coarse_n, sizeof(int64_t));
+    int32_t* adjncy = (int32_t*)arena_alloc(scratch, fine_edges, sizeof(int32_t));
+    int* adjwgt = (int*)arena_alloc(scratch, fine_edges, sizeof(int));
+    Graph* coarse = create_graph_in_arena(&context->hierarchy, graph->max_vertices);
+    int64_t* xadj = (int64_t*)arena_alloc(&context->hierarchy, coarse_n + 1, sizeof(int64_t));
+    int* vwgt = (int*)arena_alloc(&context->hierarchy, coarse_n, sizeof(int));
+    if (!slot || !adjncy || !adjwgt || !coarse || !xadj || !vwgt) {
+        arena_release(scratch, mark);
+        return NULL;
+    }
+
+    // Scalanie list sąsiadów par; slot[c] wskazuje pozycję krawędzi do węzła c
+    for (int c = 0; c < coarse_n; c++) slot[c] = -1;
+    int64_t position = 0;
+    xadj[0] = 0;
+    for (int v = 0; v < n; v++) {
+        if (v > match[v]) continue;
+
+        int c = cmap[v];
+        int64_t start = position;
+        int members[2] = { v, match[v] };
+        int member_count = (match[v] == v) ? 1 : 2;
+        vwgt[c] = 0;
+        for (int m = 0; m < member_count; m++) {
+            int member = members[m];
+            vwgt[c] += vertex_weight(graph, member);
+            FOR_EACH_NEIGHBOR(graph, member, it) {
+                int target = cmap[it.neighbor];
+                if (target == c) continue;
+                if (slot[target] == -1) {
+                    slot[target] = position;
+                    adjncy[position] = target;
+                    adjwgt[position] = neighbor_weight(graph, &it);
+                    position++;
+                } else {
+                    adjwgt[slot[target]] += neighbor_weight(graph, &it);
+                }
+            }
+        }
+        for (int64_t j = start; j < position; j++) {
+            slot[adjncy[j]] = -1;
+        }
+        xadj[c + 1] = position;
+    }
+
+    coarse->total_vertices = coarse_n;
+    coarse->xadj = xadj;
+    coarse->vwgt = vwgt;
+    coarse->index_width = graph_index_width(coarse_n);
+    coarse->num_edges = position / 2;
+    coarse->adjncy = arena_alloc(&context->hierarchy, position, coarse->index_width / 8);
+    coarse->adjwgt = (int*)arena_alloc(&context->hierarchy, position, sizeof(int));
+    if (!coarse->adjncy || !coarse->adjwgt) {
+        arena_release(scratch, mark);
+        return NULL;
+    }
+    if (coarse->index_width == INDEX_WIDTH_16) {
+        uint16_t* narrow = (uint16_t*)coarse->adjncy;
+        for (int64_t j = 0; j < position; j++) narrow[j] = (uint16_t)adjncy[j];
+    } else {
+        memcpy(coarse->adjncy, adjncy, position * sizeof(int32_t));
+    }
+    memcpy(coarse->adjwgt, adjwgt, position * sizeof(int));
+
+    arena_release(scratch, mark);
+    return coarse;
+}
+
+// Funkcja dzieląca graf na dwie części metodą zachłannego rozrostu (greedy graph growing)
+// Strona 0 rośnie od losowego węzła, przyłączając w każdym kroku węzeł brzegowy
+// o największym zysku, aż osiągnie docelową wagę; wynik jest poprawiany algorytmem FM
+// Spośród kilku prób zachowywany jest podział o najmniejszym przekroju
+// Parametry min_weight i max_weight - dopuszczalne wagi obu stron
+// Parametr scratch - arena robocza, zwracana do stanu sprzed wywołania
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int grow_bisection(const Graph* graph, int* side, const int* min_weight, const int* max_weight,
+                          uint64_t* rng, Arena* scratch) {
+    int n = graph->total_vertices;
+    int target = (min_weight[0] + max_weight[0]) / 2;
+    ArenaMark mark = arena_mark(scratch);
+    int* trial = (int*)arena_alloc(scratch, n, sizeof(int));
+    int* gain = (int*)arena_alloc(scratch, n, sizeof(int));
+    GainBuckets frontier;
+    if (!trial || !gain || gain_buckets_init(&frontier, n, max_weighted_degree(graph)) != 0) {
+        arena_release(scratch, mark);
+        return -1;
+    }
+
+    long best_cut = LONG_MAX;
+    for (int attempt = 0; attempt < INITIAL_PARTITION_TRIALS; attempt++) {
+        for (int v = 0; v < n; v++) trial[v] = 1;
+        gain_buckets_clear(&frontier);
+
+        int grown = 0;
+        while (grown < target) {
+            int v;
+            if (gain_buckets_top(&frontier) >= 0) {
+                v = frontier.head[gain_buckets_top(&frontier)];
+                gain_buckets_remove(&frontier, v);
+            } else {
+                // Pusty brzeg (graf niespójny) - nowy losowy węzeł początkowy
+                v = (int)(random_next(rng) % (uint32_t)n);
+                int tries = 0;
+                while (trial[v] == 0 && tries++ < n) v = (v + 1) % n;
+                if (trial[v] == 0) break;
+            }
+            if (grown > 0 && grown + vertex_weight(graph, v) > max_weight[0] && grown >= min_weight[0]) break;
+
+            trial[v] = 0;
+            grown += vertex_weight(graph, v);
+
+            // Aktualizacja zysków sąsiadów pozostających po stronie 1
+            FOR_EACH_NEIGHBOR(graph, v, it) {
+                int u = it.neighbor;
+                if (trial[u] == 0) continue;
+                if (frontier.in_queue[u]) {
+                    gain[u] += 2 * neighbor_weight(graph, &it);
+                    gain_buckets_update(&frontier, u, gain[u]);
+                } else {
+                    int g = 0;
+                    FOR_EACH_NEIGHBOR(graph, u, inner) {
+                        g += (trial[inner.neighbor] == 0) ? neighbor_weight(graph, &inner) : -neighbor_weight(graph, &inner);
+                    }
+                    gain[u] = g;
+                    gain_buckets_insert(&frontier, u, g);
+                }
+            }
+        }
+
+        if (refine_fm_bounded(graph, trial, 2, min_weight, max_weight) != 0) {
+            gain_buckets_free(&frontier);
+            arena_release(scratch, mark);
+            return -1;
+        }
+
+        long cut = calculate_cut_from_parts(graph, trial);
+        if (cut < best_cut) {
+            best_cut = cut;
+            memcpy(side, trial, n * sizeof(int));
+        }
+    }
+
+    gain_buckets_free(&frontier);
+    arena_release(scratch, mark);
+    return 0;
+}
+
+// Funkcja dzieląca graf na num_parts części rekurencyjną bisekcją
+// Części otrzymują numery first_part .. first_part + num_parts - 1; przy nieparzystej
+// liczbie części strony bisekcji otrzymują wagi proporcjonalne do liczby swoich części
+// Parametr local_index - tablica pomocnicza rozmiaru graph->total_vertices wypełniona -1
+// Tablice pomocnicze kolejnych poziomów rekurencji przydzielane są z areny scratch
+// jak ze stosu i zwalniane przy powrocie
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int recursive_bisection(const Graph* graph, int* part_of, int first_part, int num_parts,
+                               double tolerance, uint64_t* rng, int* local_index, Arena* scratch) {
+    int n = graph->total_vertices;
+    if (num_parts == 1 || n == 0) {
+        for (int v = 0; v < n; v++) part_of[v] = first_part;
+        return 0;
+    }
+
+    int left_parts = num_parts / 2;
+    long total = total_vertex_weight(graph);
+    double spread = sqrt(1.0 + tolerance / 100.0);
+    int min_weight[2], max_weight[2];
+    double target[2] = { (double)total * left_parts / num_parts, 0.0 };
+    target[1] = total - target[0];
+    for (int s = 0; s < 2; s++) {
+        min_weight[s] = (int)floor(target[s] / spread);
+        max_weight[s] = (int)ceil(target[s] * spread);
+    }
+
+    ArenaMark mark = arena_mark(scratch);
+    int* side = (int*)arena_alloc(scratch, n, sizeof(int));
+    int* vertices = (int*)arena_alloc(scratch, n, sizeof(int));
+    if (!side || !vertices || grow_bisection(graph, side, min_weight, max_weight, rng, scratch) != 0) {
+        arena_release(scratch, mark);
+        return -1;
+    }
+
+    // Rekurencyjny podział obu stron
+    int status = 0;
+    for (int s = 0; s < 2 && status == 0; s++) {
+        int count = 0;
+        for (int v = 0; v < n; v++) {
+            if (side[v] == s) vertices[count++] = v;
+        }
+
+        ArenaMark side_mark = arena_mark(scratch);
+        Graph* sub = extract_subgraph(graph, vertices, count, local_index);
+        int* sub_part = (int*)arena_alloc(scratch, count, sizeof(int));
+        int* sub_index = (int*)arena_alloc(scratch, count, sizeof(int));
+        if (!sub || !sub_part || !sub_index) {
+            status = -1;
+        } else {
+            for (int i = 0; i < count; i++) sub_index[i] = -1;
+            int sub_first = first_part + (s == 0 ? 0 : left_parts);
+            int sub_parts = (s == 0) ? left_parts : num_parts - left_parts;
+            status = recursive_bisection(sub, sub_part, sub_first, sub_parts, tolerance, rng, sub_index,
+                                         scratch);
+            for (int i = 0; i < count && status == 0; i++) {
+                part_of[vertices[i]] = sub_part[i];
+            }
+        }
+        destroy_graph(sub);
+        arena_release(scratch, side_mark);
+    }
+
+    arena_release(scratch, mark);
+    return status;
+}
+
+// Funkcja obliczająca tolerancję pojedynczej bisekcji
+// Margines dzielony jest między poziomy rekurencji, tak aby złożenie bisekcji
+// mieściło się w marginesie całego podziału
+static double bisection_tolerance(const PartitionOptions* options) {
+    int depth = (int)ceil(log(options->num_parts) / log(2));
+    return options->margin_percentage / (depth > 0 ? depth : 1);
+}
+
+// Funkcja wyznaczająca podział początkowy rekurencyjną bisekcją z zachłannym rozrostem
+// Losowe węzły początkowe wybierane są generatorem zainicjalizowanym ziarnem z opcji
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int initial_partition_growing(const Graph* graph, int* part_of, const PartitionOptions* options) {
+    int n = graph->total_vertices;
+    uint64_t rng = (uint64_t)options->seed * 0x2545F4914F6CDD1DULL + 1;
+    Arena scratch;
+    arena_init(&scratch, ARENA_DEFAULT_BLOCK_SIZE);
+    int* local_index = (int*)arena_alloc(&scratch, n, sizeof(int));
+    if (!local_index) {
+        arena_destroy(&scratch);
+        return -1;
+    }
+    for (int v = 0; v < n; v++) local_index[v] = -1;
+
+    int status = recursive_bisection(graph, part_of, 0, options->num_parts,
+                                     bisection_tolerance(options), &rng, local_index, &scratch);
+    arena_destroy(&scratch);
+    return status;
+}
+
+// Funkcja udoskonalająca podział algorytmem sekwencyjnym doprowadzającym wagi części
+// do granic marginesu: k-drożnym, a dla dwóch części - FM
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int refine_balanced(const Graph* graph, int* part_of, const PartitionOptions* options) {
+    return (options->num_parts > 2)
+        ? refine_kway(graph, part_of, options->num_parts, options->margin_percentage)
+        : refine_fm(graph, part_of, options->num_parts, options->margin_percentage);
+}
+
+// Funkcja udoskonalająca podział na jednym poziomie hierarchii
+// Przy propagacji etykiet wszystkie poziomy poprawiane są równolegle (wagi części
+// zachowane z podziału początkowego przenoszą się na kolejne poziomy). W pozostałych
+// trybach grafy pośrednie poprawia refine_balanced, a na grafie wejściowym działa
+// algorytm wybrany w opcjach. KL zachowuje rozmiary części, dlatego przed nim podział
+// doprowadzany jest do granic marginesu
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int refine_level(const Graph* graph, int* part_of, const PartitionOptions* options, bool input_graph) {
+    if (options->refinement == REFINE_LP) {
+        return refine_lp(graph, part_of, options->num_parts, options->margin_percentage, options->num_threads);
+    }
+    if (!input_graph || options->refinement == REFINE_KL) {
+        int status = refine_balanced(graph, part_of, options);
+        if (status != 0 || !input_graph) return status;
+    }
+    return refine_partition(graph, part_of, options);
+}
+
+// Funkcja dzieląca graf metodą wielopoziomową
+// 1. Zgrubianie: kolejne poziomy powstają przez skojarzenie najcięższych krawędzi,
+//    aż graf ma około COARSEN_VERTICES_PER_PART węzłów na część
+// 2. Podział początkowy najgrubszego grafu rekurencyjną bisekcją z zachłannym rozrostem
+// 3. Rozgrubianie: podział jest rzutowany poziom po poziomie na grafy drobniejsze
+//    i na każdym poziomie poprawiany (refine_level)
+// Parametr part_of - tablica wynikowa przypisania węzłów do części
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int partition_multilevel(const Graph* graph, int* part_of, const PartitionOptions* options) {
+    int num_parts = options->num_parts;
+    uint64_t rng = (uint64_t)options->seed * 0x2545F4914F6CDD1DULL + 1;
+
+    int coarsest_target = COARSEN_VERTICES_PER_PART * num_parts;
+    if (coarsest_target < COARSEN_MIN_VERTICES) coarsest_target = COARSEN_MIN_VERTICES;
+    long total = total_vertex_weight(graph);
+    int max_vertex_weight = (int)(1.5 * total / coarsest_target) + 1;
+
+    int capacity = 8;
+    int num_levels = 1;
+    Level* levels = (Level*)calloc(capacity, sizeof(Level));
+    if (!levels) return -1;
+    levels[0].graph = (Graph*)graph;
+
+    // Cała pamięć hierarchii i tablice pomocnicze pochodzą z kontekstu, zwalnianego
+    // na końcu jednym wywołaniem
+    PartitionContext context;
+    partition_context_init(&context);
+    int status = 0;
+
+    // Etap 1: zgrubianie
+    while (levels[num_levels - 1].graph->total_vertices > coarsest_target) {
+        Level* current = &levels[num_levels - 1];
+        int n = current->graph->total_vertices;
+        ArenaMark mark = arena_mark(&context.hierarchy);
+        current->cmap = (int*)arena_alloc(&context.hierarchy, n, sizeof(int));
+        Graph* coarse = current->cmap ? coarsen_graph(&context, current->graph, current->cmap,
+                                                      max_vertex_weight, &rng) : NULL;
+        if (!coarse) {
+            status = -1;
+            break;
+        }
+        if (coarse->total_vertices > COARSEN_MIN_REDUCTION * n) {
+            arena_release(&context.hierarchy, mark);
+            current->cmap = NULL;
+            break;
+        }
+
+        if (num_levels == capacity) {
+            Level* grown = (Level*)realloc(levels, 2 * capacity * sizeof(Level));
+            if (!grown) {
+                status = -1;
+                break;
+            }
+            levels = grown;
+            capacity *= 2;
+        }
+        levels[num_levels].graph = coarse;
+        levels[num_levels].cmap = NULL;
+        num_levels++;
+    }
+
+    // Etap 2: podział początkowy najgrubszego grafu
+    // Podziały poziomów pośrednich zajmują na przemian dwa bufory o rozmiarze
+    // największego grafu grubszego; poziom 0 zapisywany jest od razu do part_of
+    Graph* coarsest = levels[num_levels - 1].graph;
+    int buffer_size = levels[num_levels > 1 ? 1 : 0].graph->total_vertices;
+    int* coarse_part = NULL;
+    int* spare_part = NULL;
+    int* local_index = NULL;
+    if (status == 0) {
+        coarse_part = (int*)arena_alloc(&context.scratch, buffer_size, sizeof(int));
+        spare_part = (int*)arena_alloc(&context.scratch, buffer_size, sizeof(int));
+        local_index = (int*)arena_alloc(&context.scratch, coarsest->total_vertices, sizeof(int));
+        if (!coarse_part || !spare_part || !local_index) status = -1;
+    }
+    if (status == 0) {
+        for (int v = 0; v < coarsest->total_vertices; v++) local_index[v] = -1;
+        status = recursive_bisection(coarsest, coarse_part, 0, num_parts, bisection_tolerance(options),
+                                     &rng, local_index, &context.scratch);
+    }
+    if (status == 0) {
+        status = refine_balanced(coarsest, coarse_part, options);
+    }
+
+    // Etap 3: rzutowanie i udoskonalanie na kolejnych poziomach
+    for (int level = num_levels - 2; level >= 0 && status == 0; level--) {
+        Graph* fine = levels[level].graph;
+        int* fine_part = (level == 0) ? part_of : spare_part;
+        for (int v = 0; v < fine->total_vertices; v++) {
+            fine_part[v] = coarse_part[levels[level].cmap[v]];
+        }
+        spare_part = coarse_part;
+        coarse_part = fine_part;
+
+        status = refine_level(fine, fine_part, options, level == 0);
+    }
+
+    // Graf wejściowy nie został zgrubiony - podział początkowy jest wynikiem
+    if (status == 0 && num_levels == 1) {
+        memcpy(part_of, coarse_part, graph->total_vertices * sizeof(int));
+        status = refine_level(graph, part_of, options, true);
+    }
+
+    partition_context_destroy(&context);
+    free(levels);
+    return status;
+}
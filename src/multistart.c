@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "../include/graph.h"
+
+// Wspólny stan startów wykonywanych równolegle
+// Graf i opcje są tylko odczytywane; najlepszy wynik chroniony jest muteksem,
+// a każdy start pracuje na własnej tablicy przypisań i własnych buforach roboczych
+typedef struct {
+    const Graph* graph;               // Dzielony graf (tylko do odczytu)
+    const PartitionOptions* options;  // Opcje podziału
+    int threads_per_start;            // Liczba wątków udoskonalania jednego startu
+    pthread_mutex_t lock;             // Ochrona pól opisujących najlepszy wynik
+    int* best_part;                   // Przypisanie najlepszego startu (NULL - brak wyniku)
+    int best_start;                   // Numer najlepszego startu
+    long best_cut;                    // Przekrój najlepszego startu
+    double best_difference;           // Różnica wag części najlepszego startu w %
+    bool failed;                      // Czy któryś start zakończył się błędem
+} MultiStartContext;
+
+// Funkcja wykonująca pojedynczy start
+// Start 0 zaczyna od podziału początkowego wybranego w opcjach (jak podział bez wielu startów),
+// kolejne - od rekurencyjnej bisekcji z losowymi węzłami początkowymi. Każdy start
+// używa własnego ziarna, więc wynik nie zależy od liczby wątków
+// Parametr num_threads - liczba wątków dostępnych dla startu (udoskonalanie lp)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int run_start(const Graph* graph, int* part_of, const PartitionOptions* options, int start,
+                     int num_threads) {
+    PartitionOptions local = *options;
+    local.seed = options->seed + (unsigned int)start;
+    local.num_starts = 1;
+    local.num_threads = num_threads;
+
+    if (local.multilevel) return partition_multilevel(graph, part_of, &local);
+
+    if (start == 0) {
+        if (initial_partition(graph, part_of, &local) != 0) return -1;
+    } else if (initial_partition_growing(graph, part_of, &local) != 0) {
+        return -1;
+    }
+    return refine_partition(graph, part_of, &local);
+}
+
+// Funkcja sprawdzająca, czy wynik startu jest lepszy od dotychczas najlepszego
+// Pierwszeństwo mają wyniki mieszczące się w marginesie, potem mniejszy przekrój;
+// wyniki poza marginesem porównywane są różnicą wag. Remisy rozstrzyga numer startu
+static bool better_result(const MultiStartContext* ctx, int start, long cut, double difference) {
+    if (!ctx->best_part) return true;
+
+    double margin = ctx->options->margin_percentage;
+    bool feasible = difference <= margin;
+    bool best_feasible = ctx->best_difference <= margin;
+    if (feasible != best_feasible) return feasible;
+    if (!feasible && difference != ctx->best_difference) return difference < ctx->best_difference;
+    if (cut != ctx->best_cut) return cut < ctx->best_cut;
+    return start < ctx->best_start;
+}
+
+// Zadanie puli wątków: wykonanie startu i porównanie wyniku z najlepszym
+static void start_task(void* arg, int index) {
+    MultiStartContext* ctx = (MultiStartContext*)arg;
+    int n = ctx->graph->total_vertices;
+
+    int* part_of = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!part_of || run_start(ctx->graph, part_of, ctx->options, index, ctx->threads_per_start) != 0) {
+        free(part_of);
+        pthread_mutex_lock(&ctx->lock);
+        ctx->failed = true;
+        pthread_mutex_unlock(&ctx->lock);
+        return;
+    }
+    long cut = calculate_cut_from_parts(ctx->graph, part_of);
+    double difference = calculate_weight_difference(ctx->graph, part_of, ctx->options->num_parts);
+
+    pthread_mutex_lock(&ctx->lock);
+    if (difference >= 0 && better_result(ctx, index, cut, difference)) {
+        int* previous = ctx->best_part;
+        ctx->best_part = part_of;
+        ctx->best_start = index;
+        ctx->best_cut = cut;
+        ctx->best_difference = difference;
+        part_of = previous;
+    }
+    pthread_mutex_unlock(&ctx->lock);
+    free(part_of);
+}
+
+// Funkcja dzieląca graf options->num_starts razy z różnymi ziarnami i wybierająca
+// najlepszy wynik (najmniejszy przekrój spośród podziałów mieszczących się w marginesie)
+// Starty wykonywane są równolegle na options->num_threads wątkach, które dzielone są
+// po równo między jednocześnie wykonywane starty, więc udoskonalanie lp wewnątrz startu
+// nie tworzy własnej puli pełnego rozmiaru (łącznie nie więcej niż num_threads wątków)
+// Parametr part_of - tablica wynikowa przypisania węzłów do części
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int partition_multistart(const Graph* graph, int* part_of, const PartitionOptions* options) {
+    int num_starts = options->num_starts > 0 ? options->num_starts : 1;
+    int num_threads = options->num_threads < num_starts ? options->num_threads : num_starts;
+
+    MultiStartContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.graph = graph;
+    ctx.options = options;
+    ctx.threads_per_start = num_threads > 1 ? options->num_threads / num_threads : options->num_threads;
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    ThreadPool* pool = (num_threads > 1) ? thread_pool_create(num_threads) : NULL;
+    thread_pool_run(pool, num_starts, start_task, &ctx);
+    thread_pool_destroy(pool);
+    pthread_mutex_destroy(&ctx.lock);
+
+    if (ctx.failed || !ctx.best_part) {
+        free(ctx.best_part);
+        return -1;
+    }
+    memcpy(part_of, ctx.best_part, graph->total_vertices * sizeof(int));
+    free(ctx.best_part);
+    return 0;
+}
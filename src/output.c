@@ -0,0 +1,489 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../include/graph.h"
+
+// Rozmiar bufora zapisu; pełny bufor wysyłany jest jednym wywołaniem write
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+
+// Sygnatury binarnych formatów podziału (format listy grup nie ma sygnatury;
+// jego pierwsze cztery bajty to liczba grup, która nigdy nie przyjmuje tych wartości)
+#define PART_VECTOR_MAGIC "PART"
+#define VARINT_GROUPS_MAGIC "GVAR"
+
+// Funkcja zapisująca cały blok danych (write może zapisać tylko część)
+// Zwraca true w przypadku sukcesu
+static bool write_all(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        ssize_t written = write(fd, p, size);
+        if (written <= 0) return false;
+        p += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+// Funkcja otwierająca plik wyjściowy i przydzielająca bufor
+// Parametr filename równy NULL oznacza standardowe wyjście
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int output_open(OutputBuffer* out, const char* filename) {
+    out->size = 0;
+    out->failed = false;
+    out->data = (char*)malloc(OUTPUT_BUFFER_SIZE);
+    if (!out->data) return -1;
+    out->fd = filename ? open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+    if (out->fd < 0) {
+        free(out->data);
+        return -1;
+    }
+    return 0;
+}
+
+// Funkcja wysyłająca zawartość bufora do pliku
+void output_flush(OutputBuffer* out) {
+    if (out->size > 0 && !out->failed) {
+        out->failed = !write_all(out->fd, out->data, out->size);
+    }
+    out->size = 0;
+}
+
+// Funkcja zapewniająca w buforze miejsce na needed bajtów
+static inline void output_reserve(OutputBuffer* out, size_t needed) {
+    if (out->size + needed > OUTPUT_BUFFER_SIZE) output_flush(out);
+}
+
+// Funkcja dopisująca blok bajtów; bloki większe od bufora zapisywane są bezpośrednio
+static void output_bytes(OutputBuffer* out, const void* data, size_t size) {
+    if (size >= OUTPUT_BUFFER_SIZE) {
+        output_flush(out);
+        if (!out->failed) out->failed = !write_all(out->fd, data, size);
+        return;
+    }
+    output_reserve(out, size);
+    memcpy(out->data + out->size, data, size);
+    out->size += size;
+}
+
+// Funkcja dopisująca napis
+void output_string(OutputBuffer* out, const char* text) {
+    output_bytes(out, text, strlen(text));
+}
+
+// Funkcja dopisująca znak
+void output_char(OutputBuffer* out, char c) {
+    output_reserve(out, 1);
+    out->data[out->size++] = c;
+}
+
+// Funkcja dopisująca liczbę całkowitą w zapisie dziesiętnym
+// Cyfry wyznaczane są od końca do bufora pomocniczego, a następnie kopiowane
+void output_int(OutputBuffer* out, int value) {
+    char digits[12];
+    int length = 0;
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        digits[sizeof(digits) - 1 - length++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) digits[sizeof(digits) - 1 - length++] = '-';
+
+    output_reserve(out, (size_t)length);
+    memcpy(out->data + out->size, digits + sizeof(digits) - length, (size_t)length);
+    out->size += (size_t)length;
+}
+
+// Funkcja dopisująca liczbę 4-bajtową w kolejności bajtów maszyny
+static inline void output_raw_int(OutputBuffer* out, int value) {
+    output_reserve(out, sizeof(int));
+    memcpy(out->data + out->size, &value, sizeof(int));
+    out->size += sizeof(int);
+}
+
+// Funkcja dopisująca liczbę w kodowaniu varint (7 bitów na bajt, najstarszy bit
+// oznacza kontynuację)
+static inline void output_varint(OutputBuffer* out, uint32_t value) {
+    output_reserve(out, 5);
+    while (value >= 0x80) {
+        out->data[out->size++] = (char)(value | 0x80);
+        value >>= 7;
+    }
+    out->data[out->size++] = (char)value;
+}
+
+// Funkcja opróżniająca bufor i zamykająca plik
+// Zwraca 0 w przypadku sukcesu, -1 gdy którykolwiek zapis się nie powiódł
+int output_close(OutputBuffer* out) {
+    output_flush(out);
+    if (out->fd != STDOUT_FILENO && close(out->fd) != 0) out->failed = true;
+    free(out->data);
+    return out->failed ? -1 : 0;
+}
+
+// Funkcja wyznaczająca wektor przypisań części indeksowany indeksami węzłów
+// (graph->vertex_indices), czyli odwrócenie list grup
+// Zwraca tablicę o rozmiarze *count lub NULL w przypadku błędu
+static int* groups_to_part_vector(const Graph* graph, const VertexGroup* groups, int num_groups, int* count) {
+    int n = graph->total_vertices;
+    int* part = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!part) return NULL;
+
+    for (int v = 0; v < n; v++) part[v] = -1;
+    for (int g = 0; g < num_groups; g++) {
+        for (int j = 0; j < groups[g].count; j++) {
+            int index = graph->vertex_indices[groups[g].vertices[j]];
+            if (index < 0 || index >= n) {
+                free(part);
+                return NULL;
+            }
+            part[index] = g;
+        }
+    }
+    *count = n;
+    return part;
+}
+
+// Funkcja budująca kopię grup z węzłami uporządkowanymi rosnąco według pierwotnych
+// indeksów (dla grafów przenumerowanych funkcją graph_reorder); dzięki temu pliki
+// wynikowe nie zależą od wewnętrznej kolejności węzłów
+// Zwraca tablicę grup (zwalnianą funkcją free_sorted_groups) lub NULL w przypadku błędu
+static VertexGroup* sort_groups_by_index(const Graph* graph, const VertexGroup* groups, int num_groups) {
+    int n = graph->total_vertices;
+    int count;
+    int* part = groups_to_part_vector(graph, groups, num_groups, &count);
+    int* internal = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    VertexGroup* sorted = (VertexGroup*)calloc(num_groups > 0 ? num_groups : 1, sizeof(VertexGroup));
+    if (!part || !internal || !sorted) {
+        free(part);
+        free(internal);
+        free(sorted);
+        return NULL;
+    }
+    for (int v = 0; v < n; v++) internal[graph->vertex_indices[v]] = v;
+
+    bool failed = false;
+    for (int g = 0; g < num_groups; g++) {
+        sorted[g].vertices = (int*)malloc((groups[g].count > 0 ? groups[g].count : 1) * sizeof(int));
+        if (!sorted[g].vertices) failed = true;
+    }
+    if (!failed) {
+        for (int index = 0; index < n; index++) {
+            int g = part[index];
+            if (g >= 0) sorted[g].vertices[sorted[g].count++] = internal[index];
+        }
+    }
+    free(part);
+    free(internal);
+    if (failed) {
+        for (int g = 0; g < num_groups; g++) free(sorted[g].vertices);
+        free(sorted);
+        return NULL;
+    }
+    return sorted;
+}
+
+// Funkcja zwalniająca grupy zbudowane przez sort_groups_by_index
+static void free_sorted_groups(VertexGroup* groups, int num_groups) {
+    for (int g = 0; g < num_groups; g++) free(groups[g].vertices);
+    free(groups);
+}
+
+// Zapis podziału jako listy grup (format tekstowy lub binarny)
+static void write_groups(OutputBuffer* out, const Graph* graph, const VertexGroup* groups,
+                         int num_groups, bool binary_output) {
+    if (binary_output) {
+        output_raw_int(out, num_groups);
+        for (int i = 0; i < num_groups; i++) {
+            output_raw_int(out, groups[i].count);
+            for (int j = 0; j < groups[i].count; j++) {
+                output_raw_int(out, graph->vertex_indices[groups[i].vertices[j]]);
+            }
+        }
+        return;
+    }
+
+    output_int(out, num_groups);
+    output_char(out, '\n');
+    for (int i = 0; i < num_groups; i++) {
+        output_string(out, "Group ");
+        output_int(out, i + 1);
+        output_string(out, " (");
+        output_int(out, groups[i].count);
+        output_string(out, " vertices):");
+        for (int j = 0; j < groups[i].count; j++) {
+            output_char(out, ' ');
+            output_int(out, graph->vertex_indices[groups[i].vertices[j]]);
+        }
+        output_char(out, '\n');
+    }
+}
+
+// Zapis podziału jako wektora części
+// Format tekstowy odpowiada plikom .part programu METIS: wiersz i zawiera numer
+// części węzła o indeksie i. Format binarny: sygnatura PART, liczba węzłów i tablica
+// numerów części, zapisywana jednym wywołaniem write
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int write_part_vector(OutputBuffer* out, const Graph* graph, const VertexGroup* groups,
+                             int num_groups, bool binary_output) {
+    int count;
+    int* part = groups_to_part_vector(graph, groups, num_groups, &count);
+    if (!part) return -1;
+
+    if (binary_output) {
+        output_bytes(out, PART_VECTOR_MAGIC, 4);
+        output_raw_int(out, count);
+        output_flush(out);
+        if (!out->failed) out->failed = !write_all(out->fd, part, (size_t)count * sizeof(int));
+    } else {
+        for (int i = 0; i < count; i++) {
+            output_int(out, part[i]);
+            output_char(out, '\n');
+        }
+    }
+    free(part);
+    return 0;
+}
+
+// Zapis podziału jako list grup w kodowaniu varint (format wyłącznie binarny)
+// Po sygnaturze GVAR następują: liczba grup, a dla każdej grupy liczba węzłów
+// i różnice kolejnych indeksów węzłów w kodowaniu zigzag (małe liczby dodatnie
+// dla list rosnących, poprawne także dla dowolnej kolejności)
+static void write_varint_groups(OutputBuffer* out, const Graph* graph, const VertexGroup* groups,
+                                int num_groups) {
+    output_bytes(out, VARINT_GROUPS_MAGIC, 4);
+    output_varint(out, (uint32_t)num_groups);
+    for (int i = 0; i < num_groups; i++) {
+        output_varint(out, (uint32_t)groups[i].count);
+        int previous = 0;
+        for (int j = 0; j < groups[i].count; j++) {
+            int index = graph->vertex_indices[groups[i].vertices[j]];
+            int64_t delta = (int64_t)index - previous;
+            output_varint(out, (uint32_t)((delta << 1) ^ (delta >> 63)));
+            previous = index;
+        }
+    }
+}
+
+// Zapisywanie wyniku do pliku w wybranym formacie
+// Dla formatu DIVISION_VARINT parametr binary_output nie ma znaczenia
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int save_graph_division_format(const char* filename, const Graph* graph, VertexGroup* groups,
+                               int num_groups, DivisionFormat format, bool binary_output) {
+    STATS_PHASE_BEGIN(start);
+    // Grafy przenumerowane: listy grup zapisywane są w kolejności pierwotnych indeksów
+    VertexGroup* sorted = NULL;
+    if (format != DIVISION_PART_VECTOR && graph_is_reordered(graph)) {
+        sorted = sort_groups_by_index(graph, groups, num_groups);
+        if (!sorted) {
+            STATS_PHASE_END(PHASE_SAVE, start);
+            return -1;
+        }
+        groups = sorted;
+    }
+
+    OutputBuffer out;
+    if (output_open(&out, filename) != 0) {
+        if (sorted) free_sorted_groups(sorted, num_groups);
+        STATS_PHASE_END(PHASE_SAVE, start);
+        return -1;
+    }
+
+    int result = 0;
+    switch (format) {
+        case DIVISION_GROUPS:
+            write_groups(&out, graph, groups, num_groups, binary_output);
+            break;
+        case DIVISION_PART_VECTOR:
+            result = write_part_vector(&out, graph, groups, num_groups, binary_output);
+            break;
+        case DIVISION_VARINT:
+            write_varint_groups(&out, graph, groups, num_groups);
+            break;
+    }
+
+    if (output_close(&out) != 0) result = -1;
+    if (sorted) free_sorted_groups(sorted, num_groups);
+    STATS_PHASE_END(PHASE_SAVE, start);
+    return result;
+}
+
+// Zapisywanie wyniku do pliku (format listy grup)
+int save_graph_division(const char* filename, const Graph* graph,
+                       VertexGroup* groups, int num_groups, bool binary_output) {
+    return save_graph_division_format(filename, graph, groups, num_groups, DIVISION_GROUPS, binary_output);
+}
+
+// Funkcja zwalniająca grupy wczytane przez load_graph_division
+static void free_loaded_groups(VertexGroup* groups, int num_groups) {
+    for (int i = 0; i < num_groups; i++) free(groups[i].vertices);
+    free(groups);
+}
+
+// Funkcja odtwarzająca listy grup z binarnego wektora części
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędnych danych lub błędu alokacji
+static int part_vector_to_groups(const unsigned char* data, size_t size, VertexGroup** groups, int* num_groups) {
+    int count;
+    if (size < sizeof(int)) return -1;
+    memcpy(&count, data, sizeof(int));
+    if (count < 0 || (size - sizeof(int)) / sizeof(int) < (size_t)count) return -1;
+
+    int* part = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    if (!part) return -1;
+    memcpy(part, data + sizeof(int), (size_t)count * sizeof(int));
+
+    int parts = 0;
+    for (int i = 0; i < count; i++) {
+        if (part[i] < 0) {
+            free(part);
+            return -1;
+        }
+        if (part[i] >= parts) parts = part[i] + 1;
+    }
+    int result = partition_to_groups(part, count, parts, groups);
+    free(part);
+    if (result != 0) return -1;
+    *num_groups = parts;
+    return 0;
+}
+
+// Funkcja odczytująca liczbę w kodowaniu varint
+// Zwraca false, gdy dane są niepełne lub liczba przekracza 32 bity
+static bool read_varint(const unsigned char** cursor, const unsigned char* end, uint32_t* value) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (*cursor >= end) return false;
+        unsigned char byte = *(*cursor)++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Funkcja odtwarzająca listy grup z kodowania varint
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędnych danych lub błędu alokacji
+static int varint_to_groups(const unsigned char* data, size_t size, VertexGroup** groups, int* num_groups) {
+    const unsigned char* cursor = data;
+    const unsigned char* end = data + size;
+    uint32_t group_count;
+    if (!read_varint(&cursor, end, &group_count) || group_count > (uint32_t)size) return -1;
+
+    *groups = (VertexGroup*)calloc(group_count > 0 ? group_count : 1, sizeof(VertexGroup));
+    if (!*groups) return -1;
+
+    for (uint32_t i = 0; i < group_count; i++) {
+        VertexGroup* group = &(*groups)[i];
+        uint32_t count;
+        // Każdy węzeł zajmuje co najmniej jeden bajt
+        if (!read_varint(&cursor, end, &count) || count > (uint32_t)(end - cursor)) {
+            free_loaded_groups(*groups, (int)i);
+            return -1;
+        }
+        group->vertices = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+        if (!group->vertices) {
+            free_loaded_groups(*groups, (int)i);
+            return -1;
+        }
+        group->count = (int)count;
+        group->capacity = (int)count;
+
+        int64_t previous = 0;
+        for (uint32_t j = 0; j < count; j++) {
+            uint32_t encoded;
+            if (!read_varint(&cursor, end, &encoded)) {
+                free_loaded_groups(*groups, (int)i + 1);
+                return -1;
+            }
+            int64_t delta = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+            previous += delta;
+            group->vertices[j] = (int)previous;
+        }
+        group->first_vertex = count > 0 ? group->vertices[0] : 0;
+    }
+    *num_groups = (int)group_count;
+    return 0;
+}
+
+// Funkcja odczytująca podział zapisany w jednym z formatów z sygnaturą
+// (wektor części lub listy grup varint); plik wczytywany jest w całości
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int load_tagged_division(FILE* file, const char* magic, VertexGroup** groups, int* num_groups) {
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0 || st.st_size < 4) return -1;
+
+    size_t size = (size_t)st.st_size - 4;
+    unsigned char* data = (unsigned char*)malloc(size > 0 ? size : 1);
+    if (!data) return -1;
+    if (fread(data, 1, size, file) != size) {
+        free(data);
+        return -1;
+    }
+
+    int result = (memcmp(magic, PART_VECTOR_MAGIC, 4) == 0)
+        ? part_vector_to_groups(data, size, groups, num_groups)
+        : varint_to_groups(data, size, groups, num_groups);
+    free(data);
+    return result;
+}
+
+// Funkcja do odczytu podziału grafu z pliku binarnego
+// Obsługuje listy grup, wektor części (PART) oraz listy grup varint (GVAR)
+// Zwraca 0 w przypadku sukcesu, -1 gdy pliku nie da się otworzyć lub jego zawartość
+// jest niepoprawna (komunikat o błędzie wypisuje wywołujący)
+int load_graph_division(const char* filename, VertexGroup** groups, int* num_groups) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return -1;
+
+    // Odczytanie liczby grup z pliku (lub sygnatury formatu)
+    if (fread(num_groups, sizeof(int), 1, file) != 1) {
+        fclose(file);
+        return -1;
+    }
+
+    char magic[4];
+    memcpy(magic, num_groups, sizeof(magic));
+    if (memcmp(magic, PART_VECTOR_MAGIC, 4) == 0 || memcmp(magic, VARINT_GROUPS_MAGIC, 4) == 0) {
+        int result = load_tagged_division(file, magic, groups, num_groups);
+        fclose(file);
+        return result;
+    }
+
+    // Alokacja pamięci na grupy wierzchołków
+    *groups = (*num_groups >= 0) ? (VertexGroup*)malloc((*num_groups > 0 ? *num_groups : 1) * sizeof(VertexGroup)) : NULL;
+    if (!*groups) {
+        fclose(file);
+        return -1;
+    }
+
+    // Odczytanie danych dla każdej grupy
+    for (int i = 0; i < *num_groups; i++) {
+        // Odczytanie liczby wierzchołków w grupie i alokacja pamięci na jej wierzchołki
+        int count;
+        int* vertices = NULL;
+        if (fread(&count, sizeof(int), 1, file) == 1 && count >= 0) {
+            vertices = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+        }
+
+        // Odczytanie wierzchołków grupy
+        if (!vertices || fread(vertices, sizeof(int), count, file) != (size_t)count) {
+            free(vertices);
+            free_loaded_groups(*groups, i);
+            fclose(file);
+            return -1;
+        }
+        (*groups)[i].vertices = vertices;
+        (*groups)[i].count = count;
+        (*groups)[i].capacity = count;
+        (*groups)[i].first_vertex = count > 0 ? vertices[0] : 0;
+    }
+
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "../include/graph.h"
+
+// Maski do przetwarzania ośmiu bajtów jednocześnie (SWAR)
+#define BYTES_ONES  0x0101010101010101ULL
+#define BYTES_LOW7  0x7F7F7F7F7F7F7F7FULL
+#define BYTES_SEMI  0x3B3B3B3B3B3B3B3BULL  // Osiem znaków ';'
+
+// Funkcja zliczająca średniki w zakresie [begin, end)
+// Przetwarza po osiem bajtów naraz: bajty równe ';' po operacji XOR stają się zerami,
+// a dokładne zliczenie zerowych bajtów sprowadza się do jednego popcount
+long count_separators(const char* begin, const char* end) {
+    long count = 0;
+    const char* p = begin;
+
+    while (p + sizeof(uint64_t) <= end) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        uint64_t x = word ^ BYTES_SEMI;
+        uint64_t t = ((x & BYTES_LOW7) + BYTES_LOW7) | x | BYTES_LOW7;
+        count += __builtin_popcountll(~t);
+        p += sizeof(uint64_t);
+    }
+    while (p < end) {
+        count += (*p++ == ';');
+    }
+    return count;
+}
+
+// Funkcja parsująca ciąg liczb całkowitych z zakresu [begin, end) do tablicy out
+// Separatorem jest każdy znak niebędący cyfrą ani minusem (średnik, białe znaki, '%')
+// Parametr capacity - rozmiar tablicy out
+// Zwraca liczbę wczytanych liczb, -1 gdy liczba nie mieści się w int lub
+// -2 gdy tablica out jest za mała
+long parse_numbers_into(const char* begin, const char* end, int* out, long capacity) {
+    long count = 0;
+    const char* p = begin;
+
+    while (p < end) {
+        unsigned char c = (unsigned char)*p;
+        bool negative = false;
+        if (c == '-' && p + 1 < end && (unsigned)(p[1] - '0') < 10) {
+            negative = true;
+            c = (unsigned char)*++p;
+        }
+        if ((unsigned)(c - '0') >= 10) {
+            p++;
+            continue;
+        }
+
+        // Pętla cyfr bez wywołań bibliotecznych; przepełnienie sprawdzane jest
+        // dopiero po wczytaniu liczby, dzięki limitowi 19 cyfr w long long
+        const char* digits = p;
+        long long value = 0;
+        do {
+            value = value * 10 + (c - '0');
+            if (++p == end) break;
+            c = (unsigned char)*p;
+        } while ((unsigned)(c - '0') < 10 && p - digits < 19);
+        if ((unsigned)(c - '0') < 10 && p < end) return -1;
+
+        if (negative) value = -value;
+        if (value > INT_MAX || value < INT_MIN) return -1;
+        if (count >= capacity) return -2;
+        out[count++] = (int)value;
+    }
+    return count;
+}
+
+// Funkcja wczytująca liczby oddzielone średnikami z zakresu [begin, end)
+// Rozmiar tablicy wynikowej jest wyznaczany z góry na podstawie liczby średników;
+// dopiero gdy liczby rozdzielono innymi znakami, tablica jest powiększana
+// Zwraca tablicę wczytanych liczb lub NULL w przypadku błędu
+int* parse_number_list(const char* begin, const char* end, int* count) {
+    long capacity = count_separators(begin, end) + 1;
+    *count = 0;
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (capacity > INT_MAX) return NULL;
+        int* numbers = (int*)malloc(capacity * sizeof(int));
+        if (!numbers) return NULL;
+
+        long parsed = parse_numbers_into(begin, end, numbers, capacity);
+        if (parsed >= 0) {
+            *count = (int)parsed;
+            return numbers;
+        }
+        free(numbers);
+        if (parsed == -1) return NULL;
+
+        // Liczby rozdzielone nie tylko średnikami - każda zajmuje co najmniej
+        // jedną cyfrę i jeden separator, co daje bezpieczne górne ograniczenie
+        capacity = (end - begin + 1) / 2 + 1;
+    }
+    return NULL;
+}
+
+// Minimalny rozmiar fragmentu linii przetwarzanego przez jeden wątek
+#define PARALLEL_CHUNK_MIN (64 * 1024)
+
+// Stan równoległego parsowania jednej linii podzielonej na fragmenty
+typedef struct {
+    const char** bounds;   // Granice fragmentów (num_chunks + 1 wskaźników)
+    long* offsets;         // Pozycje fragmentów w tablicy wynikowej
+    long* counts;          // Górne ograniczenie, a po parsowaniu liczba wczytanych liczb
+    int* out;              // Tablica wynikowa
+} ParallelParse;
+
+// Zadanie pierwszego etapu: zliczenie liczb we fragmencie
+// Fragment zakończony średnikiem zawiera tyle liczb, ile średników,
+// w przeciwnym razie może zawierać jedną liczbę więcej
+static void count_chunk_task(void* arg, int chunk) {
+    ParallelParse* job = (ParallelParse*)arg;
+    const char* begin = job->bounds[chunk];
+    const char* end = job->bounds[chunk + 1];
+    long separators = count_separators(begin, end);
+    job->counts[chunk] = (end > begin && end[-1] == ';') ? separators : separators + 1;
+}
+
+// Zadanie drugiego etapu: parsowanie fragmentu na jego pozycję w tablicy wynikowej
+static void parse_chunk_task(void* arg, int chunk) {
+    ParallelParse* job = (ParallelParse*)arg;
+    job->counts[chunk] = parse_numbers_into(job->bounds[chunk], job->bounds[chunk + 1],
+                                            job->out + job->offsets[chunk], job->counts[chunk]);
+}
+
+// Funkcja wczytująca liczby oddzielone średnikami z zakresu [begin, end) równolegle
+// Linia dzielona jest na fragmenty na granicach średników; każdy wątek zlicza liczby
+// w swoim fragmencie, suma prefiksowa wyznacza miejsca fragmentów w tablicy wynikowej,
+// a następnie fragmenty są parsowane niezależnie bezpośrednio na swoje miejsca
+// Krótkie linie oraz linie z innymi separatorami parsowane są sekwencyjnie
+// Zwraca tablicę wczytanych liczb lub NULL w przypadku błędu
+int* parse_number_list_parallel(ThreadPool* pool, const char* begin, const char* end, int* count) {
+    long length = end - begin;
+    int num_chunks = thread_pool_size(pool);
+    if (length / PARALLEL_CHUNK_MIN < num_chunks) {
+        num_chunks = (int)(length / PARALLEL_CHUNK_MIN);
+    }
+    if (num_chunks <= 1) return parse_number_list(begin, end, count);
+
+    ParallelParse job;
+    job.bounds = (const char**)malloc((num_chunks + 1) * sizeof(const char*));
+    job.offsets = (long*)malloc((num_chunks + 1) * sizeof(long));
+    job.counts = (long*)malloc(num_chunks * sizeof(long));
+    job.out = NULL;
+    if (!job.bounds || !job.offsets || !job.counts) {
+        free(job.bounds);
+        free(job.offsets);
+        free(job.counts);
+        return NULL;
+    }
+
+    // Wyznaczenie granic fragmentów - każda granica leży tuż za średnikiem
+    job.bounds[0] = begin;
+    job.bounds[num_chunks] = end;
+    for (int c = 1; c < num_chunks; c++) {
+        const char* nominal = begin + length / num_chunks * c;
+        if (nominal < job.bounds[c - 1]) nominal = job.bounds[c - 1];
+        const char* separator = (const char*)memchr(nominal, ';', end - nominal);
+        job.bounds[c] = separator ? separator + 1 : end;
+    }
+
+    // Etap 1: zliczenie liczb we fragmentach i suma prefiksowa
+    thread_pool_run(pool, num_chunks, count_chunk_task, &job);
+    job.offsets[0] = 0;
+    for (int c = 0; c < num_chunks; c++) {
+        job.offsets[c + 1] = job.offsets[c] + job.counts[c];
+    }
+
+    int* numbers = NULL;
+    if (job.offsets[num_chunks] <= INT_MAX) {
+        job.out = (int*)malloc((job.offsets[num_chunks] > 0 ? job.offsets[num_chunks] : 1) * sizeof(int));
+    }
+
+    // Etap 2: parsowanie fragmentów bezpośrednio na ich miejsca
+    bool fallback = false;
+    if (job.out) {
+        thread_pool_run(pool, num_chunks, parse_chunk_task, &job);
+
+        // Zsunięcie fragmentów, które zawierały mniej liczb niż ograniczenie
+        long total = 0;
+        for (int c = 0; c < num_chunks; c++) {
+            if (job.counts[c] < 0) {
+                fallback = (job.counts[c] == -2);
+                total = -1;
+                break;
+            }
+            if (total != job.offsets[c]) {
+                memmove(job.out + total, job.out + job.offsets[c], job.counts[c] * sizeof(int));
+            }
+            total += job.counts[c];
+        }
+        if (total >= 0) {
+            *count = (int)total;
+            numbers = job.out;
+        } else {
+            free(job.out);
+        }
+    }
+
+    free(job.bounds);
+    free(job.offsets);
+    free(job.counts);
+
+    // Liczby rozdzielone nie tylko średnikami - parsowanie sekwencyjne
+    if (fallback) return parse_number_list(begin, end, count);
+    return numbers;
+}
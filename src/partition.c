@@ -1,241 +1,420 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <stdbool.h>
-#include <math.h>
-#include <ctype.h>
-#include "../include/graph.h"
-
-#define INITIAL_CAPACITY 16
-
-// Funkcja porównująca zyski dla sortowania
-// Używana przez qsort do sortowania par wierzchołków według zysku
-static int compare_gains(const void* a, const void* b) {
-    return ((GainInfo*)b)->gain - ((GainInfo*)a)->gain;
-}
-
-// Funkcja obliczająca koszt zewnętrzny (D) dla wierzchołka
-// Koszt zewnętrzny to liczba krawędzi łączących wierzchołek z wierzchołkami spoza grupy
-static int calculate_external_cost(const Graph* graph, int vertex, 
-                                 const int* group_vertices, int group_size) {
-    int cost = 0;
-    AdjacencyList* adj = &graph->adj_list[vertex];
-    
-    // Sprawdzenie każdego sąsiada wierzchołka
-    for (int i = 0; i < adj->count; i++) {
-        int neighbor = adj->neighbors[i];
-        bool in_group = false;
-        
-        // Sprawdzenie czy sąsiad należy do grupy
-        for (int j = 0; j < group_size; j++) {
-            if (group_vertices[j] == neighbor) {
-                in_group = true;
-                break;
-            }
-        }
-        
-        // Jeśli sąsiad nie należy do grupy, zwiększ koszt
-        if (!in_group) {
-            cost++;
-        }
-    }
-    
-    return cost;
-}
-
-// Funkcja obliczająca koszt wewnętrzny (I) dla wierzchołka
-// Koszt wewnętrzny to liczba krawędzi łączących wierzchołek z wierzchołkami w grupie
-static int calculate_internal_cost(const Graph* graph, int vertex, 
-                                 const int* group_vertices, int group_size) {
-    int cost = 0;
-    AdjacencyList* adj = &graph->adj_list[vertex];
-    
-    // Sprawdzenie każdego sąsiada wierzchołka
-    for (int i = 0; i < adj->count; i++) {
-        int neighbor = adj->neighbors[i];
-        // Sprawdzenie czy sąsiad należy do grupy
-        for (int j = 0; j < group_size; j++) {
-            if (group_vertices[j] == neighbor) {
-                cost++;
-                break;
-            }
-        }
-    }
-    
-    return cost;
-}
-
-// Funkcja obliczająca zysk dla pary wierzchołków
-// Zysk określa, jak korzystna byłaby zamiana wierzchołków między grupami
-static int calculate_pair_gain(const Graph* graph, int v1, int v2,
-                             const VertexGroup* group1, const VertexGroup* group2) {
-    // Obliczenie kosztów zewnętrznych i wewnętrznych dla obu wierzchołków
-    int D1 = calculate_external_cost(graph, v1, group1->vertices, group1->count);
-    int D2 = calculate_external_cost(graph, v2, group2->vertices, group2->count);
-    int I1 = calculate_internal_cost(graph, v1, group1->vertices, group1->count);
-    int I2 = calculate_internal_cost(graph, v2, group2->vertices, group2->count);
-    
-    // Sprawdzenie czy wierzchołki są połączone krawędzią
-    bool connected = false;
-    AdjacencyList* adj = &graph->adj_list[v1];
-    for (int i = 0; i < adj->count; i++) {
-        if (adj->neighbors[i] == v2) {
-            connected = true;
-            break;
-        }
-    }
-    
-    // Obliczenie zysku według wzoru: D1 + D2 - 2*I1 - 2*I2 + (connected ? 2 : 0)
-    return D1 + D2 - 2 * I1 - 2 * I2 + (connected ? 2 : 0);
-}
-
-// Funkcja zamieniająca wierzchołki między grupami
-static void swap_vertices(VertexGroup* group1, int idx1, 
-                         VertexGroup* group2, int idx2) {
-    int temp = group1->vertices[idx1];
-    group1->vertices[idx1] = group2->vertices[idx2];
-    group2->vertices[idx2] = temp;
-}
-
-// Główna funkcja dzieląca graf na części
-// Implementuje algorytm KL (Kernighan-Lin) z optymalizacjami
-int divide_graph(Graph* graph, int num_parts, double margin_percentage, VertexGroup** groups) {
-    // Sprawdzenie poprawności parametrów
-    if (!graph || num_parts <= 0 || margin_percentage < 0 || !groups) return -1;
-
-    // Alokacja pamięci na grupy wierzchołków
-    *groups = (VertexGroup*)malloc(num_parts * sizeof(VertexGroup));
-    if (!*groups) return -1;
-
-    // Inicjalizacja grup - równomierny podział wierzchołków
-    int base_size = graph->total_vertices / num_parts;
-    int extra = graph->total_vertices % num_parts;
-    int current_vertex = 0;
-
-    // Rozdzielenie wierzchołków między grupy
-    for (int i = 0; i < num_parts; i++) {
-        (*groups)[i].vertices = (int*)malloc(graph->total_vertices * sizeof(int));
-        if (!(*groups)[i].vertices) {
-            for (int j = 0; j < i; j++) free((*groups)[j].vertices);
-            free(*groups);
-            return -1;
-        }
-
-        // Obliczenie rozmiaru grupy (uwzględniając resztę)
-        int group_size = base_size + (i < extra ? 1 : 0);
-        (*groups)[i].count = group_size;
-        (*groups)[i].first_vertex = current_vertex;
-        
-        // Przypisanie wierzchołków do grupy
-        for (int j = 0; j < group_size; j++) {
-            (*groups)[i].vertices[j] = current_vertex++;
-        }
-    }
-
-    // Alokacja struktur pomocniczych
-    int max_batch_size = 1000; // Maksymalny rozmiar partii do przetwarzania
-    int batch_size = graph->total_vertices < max_batch_size ? graph->total_vertices : max_batch_size;
-    
-    GainInfo* gains1 = (GainInfo*)malloc(batch_size * sizeof(GainInfo));
-    GainInfo* gains2 = (GainInfo*)malloc(batch_size * sizeof(GainInfo));
-    bool* locked = (bool*)calloc(graph->total_vertices, sizeof(bool));
-    
-    if (!gains1 || !gains2 || !locked) {
-        free(gains1);
-        free(gains2);
-        free(locked);
-        for (int i = 0; i < num_parts; i++) free((*groups)[i].vertices);
-        free(*groups);
-        return -1;
-    }
-
-    // Iteracyjna optymalizacja podziału
-    bool improved;
-    int max_passes = (int)(5 + log(graph->total_vertices) / log(2)); // Dostosowanie liczby przejść do rozmiaru grafu
-    int pass = 0;
-
-    do {
-        improved = false;
-        pass++;
-
-        // Przetwarzanie każdej pary grup
-        for (int i = 0; i < num_parts && !improved; i++) {
-            for (int j = i + 1; j < num_parts && !improved; j++) {
-                VertexGroup* group1 = &(*groups)[i];
-                VertexGroup* group2 = &(*groups)[j];
-                
-                // Reset tablicy zablokowanych wierzchołków
-                memset(locked, 0, graph->total_vertices * sizeof(bool));
-                
-                int total_gain = 0;
-                int best_total_gain = 0;
-                int best_k = 0;
-                
-                // Przetwarzanie wierzchołków w partiach
-                for (int k = 0; k < group1->count && k < group2->count; k += batch_size) {
-                    // Obliczenie rozmiaru bieżącej partii
-                    int current_batch_size = batch_size;
-                    if (k + batch_size > group1->count || k + batch_size > group2->count) {
-                        current_batch_size = (group1->count < group2->count) ? 
-                                           group1->count - k : group2->count - k;
-                    }
-                    
-                    // Obliczenie zysków dla bieżącej partii
-                    int gains_count = 0;
-                    for (int v1 = k; v1 < k + current_batch_size && v1 < group1->count; v1++) {
-                        if (!locked[group1->vertices[v1]]) {
-                            for (int v2 = k; v2 < k + current_batch_size && v2 < group2->count; v2++) {
-                                if (!locked[group2->vertices[v2]]) {
-                                    int gain = calculate_pair_gain(graph, 
-                                        group1->vertices[v1], 
-                                        group2->vertices[v2],
-                                        group1, group2);
-                                        
-                                    if (gains_count < batch_size) {
-                                        gains1[gains_count].vertex = v1;
-                                        gains2[gains_count].vertex = v2;
-                                        gains1[gains_count].gain = gain;
-                                        gains_count++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    
-                    if (gains_count == 0) continue;
-                    
-                    // Sortowanie par według zysku
-                    qsort(gains1, gains_count, sizeof(GainInfo), compare_gains);
-                    
-                    // Wybór najlepszej pary do zamiany
-                    int best_gain = gains1[0].gain;
-                    int best_v1 = gains1[0].vertex;
-                    int best_v2 = gains2[0].vertex;
-                    
-                    // Wykonanie zamiany jeśli jest korzystna
-                    if (best_gain > 0) {
-                        swap_vertices(group1, best_v1, group2, best_v2);
-                        locked[group1->vertices[best_v1]] = true;
-                        locked[group2->vertices[best_v2]] = true;
-                        
-                        total_gain += best_gain;
-                        improved = true;
-                        
-                        // Aktualizacja najlepszego wyniku
-                        if (total_gain > best_total_gain) {
-                            best_total_gain = total_gain;
-                            best_k = k + 1;
-                        }
-                    }
-                }
-            }
-        }
-    } while (improved && pass < max_passes);
-
-    // Zwolnienie pamięci pomocniczej
-    free(gains1);
-    free(gains2);
-    free(locked);
-
-    return 0;
-}
\ No newline at end of file
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <math.h>
+#include <ctype.h>
+#include "../include/graph.h"
+
+// Przestrzeń robocza algorytmu KL dla jednej pary grup
+// Alokowana raz na cały podział i używana ponownie w każdym przejściu
+typedef struct {
+    int* d_value;          // D = koszt zewnętrzny - koszt wewnętrzny dla każdego węzła
+    bool* locked;          // Węzły zamienione w bieżącym przejściu
+    int* mark;             // Znaczniki sąsiadów badanego węzła
+    int* mark_weight;      // Waga krawędzi do oznaczonego sąsiada
+    int stamp;             // Bieżąca wartość znacznika
+    int part_a;            // Grupa, której węzły trafiają do kolejki side[0]
+    int* swap_a;           // Kolejne zamienione węzły z pierwszej grupy
+    int* swap_b;           // Kolejne zamienione węzły z drugiej grupy
+    long gain_evaluations; // Liczba zbadanych par w bieżącym przejściu (instrumentacja)
+    GainBuckets side[2];   // Kolejki wartości D dla obu grup
+    Arena memory;          // Jeden blok, z którego pochodzą tablice przestrzeni roboczej
+} KLWorkspace;
+
+// Funkcja zwalniająca przestrzeń roboczą KL
+static void kl_workspace_free(KLWorkspace* ws) {
+    arena_destroy(&ws->memory);
+    gain_buckets_free(&ws->side[0]);
+    gain_buckets_free(&ws->side[1]);
+}
+
+// Funkcja alokująca przestrzeń roboczą KL dla grafu
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int kl_workspace_init(KLWorkspace* ws, const Graph* graph) {
+    int n = graph->total_vertices;
+    int max_degree = max_weighted_degree(graph);
+
+    memset(ws, 0, sizeof(*ws));
+    arena_init(&ws->memory, (size_t)n * (5 * sizeof(int) + sizeof(bool)) + 6 * ARENA_ALIGNMENT);
+    ws->d_value = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->locked = (bool*)arena_calloc(&ws->memory, n, sizeof(bool));
+    ws->mark = (int*)arena_calloc(&ws->memory, n, sizeof(int));
+    ws->mark_weight = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->swap_a = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    ws->swap_b = (int*)arena_alloc(&ws->memory, n, sizeof(int));
+    int status_a = gain_buckets_init(&ws->side[0], n, max_degree);
+    int status_b = gain_buckets_init(&ws->side[1], n, max_degree);
+    if (!ws->d_value || !ws->locked || !ws->mark || !ws->mark_weight || !ws->swap_a || !ws->swap_b ||
+        status_a != 0 || status_b != 0) {
+        kl_workspace_free(ws);
+        return -1;
+    }
+    return 0;
+}
+
+// Funkcja wyszukująca parę (a, b) o największym zysku zamiany
+// Zysk pary to D_a + D_b - 2 * c(a, b), gdzie c(a, b) to waga krawędzi między węzłami
+// Kubełki przeglądane są malejąco, a przeszukiwanie kończy się, gdy suma
+// największych pozostałych wartości D nie może poprawić dotychczasowego wyniku
+// Zwraca zysk najlepszej pary lub INT_MIN, gdy któraś z kolejek jest pusta
+static int kl_find_best_pair(const Graph* graph, KLWorkspace* ws, int* best_a, int* best_b) {
+    GainBuckets* side_a = &ws->side[0];
+    GainBuckets* side_b = &ws->side[1];
+    int top_a = gain_buckets_top(side_a);
+    int top_b = gain_buckets_top(side_b);
+    if (top_a < 0 || top_b < 0) return INT_MIN;
+
+    int max_gain_b = top_b - side_b->max_gain;
+    int best = INT_MIN;
+
+    for (int ba = top_a; ba >= 0; ba--) {
+        int gain_a = ba - side_a->max_gain;
+        if (best != INT_MIN && gain_a + max_gain_b <= best) break;
+
+        for (int a = side_a->head[ba]; a != -1; a = side_a->next[a]) {
+            if (best != INT_MIN && gain_a + max_gain_b <= best) break;
+
+            // Oznaczenie sąsiadów węzła a
+            if (ws->stamp == INT_MAX) {
+                memset(ws->mark, 0, graph->total_vertices * sizeof(int));
+                ws->stamp = 0;
+            }
+            ws->stamp++;
+            FOR_EACH_NEIGHBOR(graph, a, it) {
+                ws->mark[it.neighbor] = ws->stamp;
+                ws->mark_weight[it.neighbor] = neighbor_weight(graph, &it);
+            }
+
+            bool done = false;
+            for (int bb = top_b; bb >= 0 && !done; bb--) {
+                int gain_b = bb - side_b->max_gain;
+                if (best != INT_MIN && gain_a + gain_b <= best) break;
+
+                for (int b = side_b->head[bb]; b != -1; b = side_b->next[b]) {
+                    STATS_INC(ws->gain_evaluations);
+                    bool connected = ws->mark[b] == ws->stamp;
+                    int gain = gain_a + gain_b - (connected ? 2 * ws->mark_weight[b] : 0);
+                    if (gain > best) {
+                        best = gain;
+                        *best_a = a;
+                        *best_b = b;
+                    }
+                    // Dla niepołączonej pary żaden dalszy węzeł b nie da większego zysku
+                    if (!connected) {
+                        done = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// Funkcja aktualizująca wartości D sąsiadów węzła przeniesionego z grupy from do grupy to
+// Dla sąsiada z grupy from krawędź staje się zewnętrzna (D += 2w),
+// dla sąsiada z grupy to krawędź staje się wewnętrzna (D -= 2w)
+static void kl_update_neighbors(const Graph* graph, const int* part_of, KLWorkspace* ws,
+                                int vertex, int from, int to) {
+    FOR_EACH_NEIGHBOR(graph, vertex, it) {
+        int neighbor = it.neighbor;
+        if (ws->locked[neighbor]) continue;
+
+        int delta;
+        if (part_of[neighbor] == from) delta = 2 * neighbor_weight(graph, &it);
+        else if (part_of[neighbor] == to) delta = -2 * neighbor_weight(graph, &it);
+        else continue;
+
+        ws->d_value[neighbor] += delta;
+        gain_buckets_update(&ws->side[part_of[neighbor] == ws->part_a ? 0 : 1], neighbor,
+                            ws->d_value[neighbor]);
+    }
+}
+
+// Funkcja wykonująca jedno przejście algorytmu Kernighana-Lina dla pary grup
+// Wartości D są liczone raz na przejście w czasie O(E), po każdej zamianie
+// aktualizowani są tylko sąsiedzi zamienionych węzłów, a na końcu przejścia
+// cofane są zamiany wykonane po najlepszym prefiksie ciągu zamian
+// Zwraca łączny zysk zachowanych zamian (0, gdy przejście niczego nie poprawiło)
+static int kl_pass(const Graph* graph, int* part_of, int part_a, int part_b, KLWorkspace* ws) {
+    int n = graph->total_vertices;
+    ws->part_a = part_a;
+    ws->gain_evaluations = 0;
+    gain_buckets_clear(&ws->side[0]);
+    gain_buckets_clear(&ws->side[1]);
+
+    // Obliczenie wartości D dla węzłów obu grup
+    int count_a = 0;
+    int count_b = 0;
+    for (int v = 0; v < n; v++) {
+        int part = part_of[v];
+        if (part != part_a && part != part_b) continue;
+
+        int other = (part == part_a) ? part_b : part_a;
+        int to_part, to_other;
+        neighbor_pair_weights(graph, part_of, v, part, other, &to_part, &to_other);
+        int d = to_other - to_part;
+        ws->d_value[v] = d;
+        ws->locked[v] = false;
+        if (part == part_a) {
+            gain_buckets_insert(&ws->side[0], v, d);
+            count_a++;
+        } else {
+            gain_buckets_insert(&ws->side[1], v, d);
+            count_b++;
+        }
+    }
+
+    int max_swaps = count_a < count_b ? count_a : count_b;
+    int total_gain = 0;
+    int best_total_gain = 0;
+    int best_k = 0;
+    int swaps = 0;
+
+    while (swaps < max_swaps) {
+        int a, b;
+        int gain = kl_find_best_pair(graph, ws, &a, &b);
+        if (gain == INT_MIN) break;
+
+        // Zablokowanie i zamiana pary
+        gain_buckets_remove(&ws->side[0], a);
+        gain_buckets_remove(&ws->side[1], b);
+        ws->locked[a] = true;
+        ws->locked[b] = true;
+        part_of[a] = part_b;
+        part_of[b] = part_a;
+        ws->swap_a[swaps] = a;
+        ws->swap_b[swaps] = b;
+        swaps++;
+
+        kl_update_neighbors(graph, part_of, ws, a, part_a, part_b);
+        kl_update_neighbors(graph, part_of, ws, b, part_b, part_a);
+
+        total_gain += gain;
+        if (total_gain > best_total_gain) {
+            best_total_gain = total_gain;
+            best_k = swaps;
+        }
+    }
+
+    // Cofnięcie zamian wykonanych po najlepszym prefiksie
+    for (int i = swaps - 1; i >= best_k; i--) {
+        part_of[ws->swap_a[i]] = part_a;
+        part_of[ws->swap_b[i]] = part_b;
+    }
+
+    STATS_ADD(COUNTER_KL_PAIR_PASSES, 1);
+    STATS_ADD(COUNTER_KL_GAIN_EVALUATIONS, ws->gain_evaluations);
+    STATS_ADD(COUNTER_KL_SWAPS, best_k);
+    STATS_ADD(COUNTER_KL_ROLLBACKS, swaps - best_k);
+    return best_total_gain;
+}
+
+// Funkcja tworząca grupy wierzchołków na podstawie przypisania part_of
+// Wierzchołki w każdej grupie są uporządkowane rosnąco
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int partition_to_groups(const int* part_of, int num_vertices, int num_parts, VertexGroup** groups) {
+    *groups = (VertexGroup*)calloc(num_parts, sizeof(VertexGroup));
+    if (!*groups) return -1;
+
+    for (int v = 0; v < num_vertices; v++) {
+        (*groups)[part_of[v]].capacity++;
+    }
+    for (int i = 0; i < num_parts; i++) {
+        VertexGroup* group = &(*groups)[i];
+        group->vertices = (int*)malloc((group->capacity > 0 ? group->capacity : 1) * sizeof(int));
+        if (!group->vertices) {
+            for (int j = 0; j < i; j++) free((*groups)[j].vertices);
+            free(*groups);
+            *groups = NULL;
+            return -1;
+        }
+    }
+    for (int v = 0; v < num_vertices; v++) {
+        VertexGroup* group = &(*groups)[part_of[v]];
+        group->vertices[group->count++] = v;
+    }
+    for (int i = 0; i < num_parts; i++) {
+        VertexGroup* group = &(*groups)[i];
+        group->first_vertex = group->count > 0 ? group->vertices[0] : 0;
+    }
+    return 0;
+}
+
+// Funkcja wyznaczająca dopuszczalne rozmiary części dla marginesu margin_percentage
+// Margines ogranicza względną różnicę (max - min) / min, dlatego granice leżą
+// symetrycznie (w skali logarytmicznej) wokół średniego rozmiaru części
+// Górna granica obcinana jest do total, aby bardzo duży margines nie przepełnił int
+void compute_part_bounds(int total, int num_parts, double margin_percentage, int* min_size, int* max_size) {
+    double average = (double)total / num_parts;
+    double spread = sqrt(1.0 + margin_percentage / 100.0);
+
+    *min_size = (int)ceil(average / spread);
+    double upper = floor(average * spread);
+    *max_size = upper < total ? (int)upper : total;
+    if (*min_size > (int)floor(average)) *min_size = (int)floor(average);
+    if (*max_size < (int)ceil(average)) *max_size = (int)ceil(average);
+}
+
+// Funkcja dzieląca wierzchołki na num_parts równych, ciągłych zakresów indeksów
+void initial_partition_contiguous(int num_vertices, int num_parts, int* part_of) {
+    int base_size = num_vertices / num_parts;
+    int extra = num_vertices % num_parts;
+    int current_vertex = 0;
+    for (int i = 0; i < num_parts; i++) {
+        int group_size = base_size + (i < extra ? 1 : 0);
+        for (int j = 0; j < group_size; j++) {
+            part_of[current_vertex++] = i;
+        }
+    }
+}
+
+// Funkcja wyznaczająca podział początkowy wybrany w opcjach
+// Zwraca 0 w przypadku sukcesu, -1 gdy graf nie ma współrzędnych węzłów
+// lub w przypadku błędu alokacji
+int initial_partition(const Graph* graph, int* part_of, const PartitionOptions* options) {
+    if (options->initial == INITIAL_GEOMETRIC) {
+        return initial_partition_geometric(graph, part_of, options->num_parts);
+    }
+    initial_partition_contiguous(graph->total_vertices, options->num_parts, part_of);
+    return 0;
+}
+
+// Funkcja ustawiająca domyślne opcje podziału
+void partition_options_init(PartitionOptions* options) {
+    options->num_parts = 2;
+    options->margin_percentage = 20.0;
+    options->refinement = REFINE_KL;
+    options->initial = INITIAL_CONTIGUOUS;
+    options->multilevel = false;
+    options->seed = 1;
+    options->num_starts = 1;
+    options->num_threads = 1;
+    options->components = false;
+}
+
+// Funkcja udoskonalająca podział algorytmem Kernighana-Lina
+// Zamiany par nie zmieniają liczebności grup (wagi węzłów nie są uwzględniane)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+int refine_kl(const Graph* graph, int* part_of, int num_parts) {
+    KLWorkspace ws;
+    if (kl_workspace_init(&ws, graph) != 0) return -1;
+
+    // Iteracyjna optymalizacja podziału
+    bool improved;
+    int max_passes = (int)(5 + log(graph->total_vertices) / log(2)); // Dostosowanie liczby przejść do rozmiaru grafu
+    int pass = 0;
+
+    // Przekrój po każdym przejściu wyznaczany jest z zysków przejść, tylko gdy zbierane są pomiary
+    long cut = STATS_ENABLED() ? calculate_cut_from_parts(graph, part_of) : 0;
+
+    do {
+        improved = false;
+        pass++;
+
+        // Przetwarzanie każdej pary grup
+        for (int i = 0; i < num_parts && !improved; i++) {
+            for (int j = i + 1; j < num_parts && !improved; j++) {
+                int gain = kl_pass(graph, part_of, i, j, &ws);
+                if (gain > 0) {
+                    improved = true;
+                    cut -= gain;
+                }
+            }
+        }
+        STATS_ADD(COUNTER_KL_PASSES, 1);
+        STATS_RECORD_CUT(cut);
+    } while (improved && pass < max_passes);
+
+    kl_workspace_free(&ws);
+    return 0;
+}
+
+// Funkcja udoskonalająca podział wybranym algorytmem
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int refine_partition(const Graph* graph, int* part_of, const PartitionOptions* options) {
+    STATS_PHASE_BEGIN(start);
+    int result = -1;
+    switch (options->refinement) {
+        case REFINE_KL:
+            result = refine_kl(graph, part_of, options->num_parts);
+            break;
+        case REFINE_FM:
+            result = refine_fm(graph, part_of, options->num_parts, options->margin_percentage);
+            break;
+        case REFINE_KWAY:
+            result = refine_kway(graph, part_of, options->num_parts, options->margin_percentage);
+            break;
+        case REFINE_LP:
+            result = refine_lp(graph, part_of, options->num_parts, options->margin_percentage,
+                               options->num_threads);
+            break;
+        case REFINE_NONE:
+            result = 0;
+            break;
+    }
+    STATS_PHASE_END(PHASE_REFINE, start);
+    return result;
+}
+
+// Funkcja wyznaczająca podział całego grafu bez rozkładu na spójne składowe
+// Przy wielu startach podział wyznacza partition_multistart, w trybie wielopoziomowym
+// partition_multilevel; w przeciwnym razie wyznaczany jest podział początkowy wybrany
+// w opcjach (ciągłe zakresy indeksów lub podział geometryczny), a następnie jest on
+// udoskonalany algorytmem wybranym w opcjach
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int partition_graph_direct(const Graph* graph, const PartitionOptions* options, int* part_of) {
+    if (options->num_starts > 1) return partition_multistart(graph, part_of, options);
+    if (options->multilevel) return partition_multilevel(graph, part_of, options);
+    int status = initial_partition(graph, part_of, options);
+    if (status == 0) status = refine_partition(graph, part_of, options);
+    return status;
+}
+
+// Funkcja wyznaczająca podział grafu do tablicy part_of podanej przez wywołującego
+// Z opcją options->components graf niespójny dzielony jest osobno dla każdej spójnej
+// składowej (partition_components), w przeciwnym razie partition_graph_direct
+// Parametr part_of - tablica wynikowa rozmiaru graph->total_vertices
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int partition_graph(const Graph* graph, const PartitionOptions* options, int* part_of) {
+    // Sprawdzenie poprawności parametrów
+    // Margines NaN lub nieskończony nie wyznacza granic rozmiarów części
+    if (!graph || !options || options->num_parts <= 0 || !(options->margin_percentage >= 0) ||
+        isinf(options->margin_percentage) || !part_of) {
+        return -1;
+    }
+
+    STATS_PHASE_BEGIN(start);
+    int status = options->components ? partition_components(graph, options, part_of)
+                                     : partition_graph_direct(graph, options, part_of);
+    STATS_PHASE_END(PHASE_PARTITION, start);
+    return status;
+}
+
+// Główna funkcja dzieląca graf na części
+// Podział wyznacza partition_graph, a wynik zapisywany jest jako listy węzłów grup
+int divide_graph_with_options(Graph* graph, const PartitionOptions* options, VertexGroup** groups) {
+    if (!graph || !groups) return -1;
+
+    int n = graph->total_vertices;
+    int* part_of = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!part_of) return -1;
+
+    int result = partition_graph(graph, options, part_of);
+    if (result == 0) {
+        result = partition_to_groups(part_of, n, options->num_parts, groups);
+    }
+    free(part_of);
+    return result;
+}
+
+// Funkcja dzieląca graf na części z domyślnym algorytmem udoskonalania (KL)
+int divide_graph(Graph* graph, int num_parts, double margin_percentage, VertexGroup** groups) {
+    PartitionOptions options;
+    partition_options_init(&options);
+    options.num_parts = num_parts;
+    options.margin_percentage = margin_percentage;
+    return divide_graph_with_options(graph, &options, groups);
+}
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include "../include/graph.h"
+
+// Największy rozmiar treści żądania (pola stałe i dwie ścieżki)
+#define REQUEST_MAX_SIZE (64 + 2 * PROTOCOL_MAX_PATH)
+
+// Rozmiar stałej części odpowiedzi: status, przekrój, liczba węzłów, trafienie,
+// dwa czasy, długość wektora części i długość komunikatu
+#define RESPONSE_HEADER_SIZE (4 + 8 + 4 + 4 + 8 + 8 + 4 + 4)
+
+// Bufor kodowania lub dekodowania treści ramki
+typedef struct {
+    unsigned char* data;
+    size_t size;        // Liczba zapisanych bajtów (kodowanie) lub rozmiar danych (dekodowanie)
+    size_t capacity;    // Pojemność bufora kodowania
+    size_t position;    // Pozycja odczytu (dekodowanie)
+    bool failed;        // Przepełnienie bufora lub zbyt krótkie dane
+} Message;
+
+// Funkcja dopisująca do komunikatu size bajtów
+static void put_bytes(Message* message, const void* data, size_t size) {
+    if (message->failed || message->capacity - message->size < size) {
+        message->failed = true;
+        return;
+    }
+    memcpy(message->data + message->size, data, size);
+    message->size += size;
+}
+
+// Funkcja odczytująca z komunikatu size bajtów
+static void get_bytes(Message* message, void* data, size_t size) {
+    if (message->failed || message->size - message->position < size) {
+        message->failed = true;
+        memset(data, 0, size);
+        return;
+    }
+    memcpy(data, message->data + message->position, size);
+    message->position += size;
+}
+
+static void put_i32(Message* message, int32_t value) { put_bytes(message, &value, sizeof(value)); }
+static void put_i64(Message* message, int64_t value) { put_bytes(message, &value, sizeof(value)); }
+static void put_f64(Message* message, double value) { put_bytes(message, &value, sizeof(value)); }
+
+static int32_t get_i32(Message* message) {
+    int32_t value;
+    get_bytes(message, &value, sizeof(value));
+    return value;
+}
+
+static int64_t get_i64(Message* message) {
+    int64_t value;
+    get_bytes(message, &value, sizeof(value));
+    return value;
+}
+
+static double get_f64(Message* message) {
+    double value;
+    get_bytes(message, &value, sizeof(value));
+    return value;
+}
+
+// Funkcja dopisująca napis (długość i znaki bez kończącego zera)
+static void put_string(Message* message, const char* text) {
+    size_t length = strlen(text);
+    put_i32(message, (int32_t)length);
+    put_bytes(message, text, length);
+}
+
+// Funkcja odczytująca napis do bufora o rozmiarze capacity (z kończącym zerem)
+static void get_string(Message* message, char* text, size_t capacity) {
+    int32_t length = get_i32(message);
+    if (length < 0 || (size_t)length >= capacity) {
+        message->failed = true;
+        text[0] = '\0';
+        return;
+    }
+    get_bytes(message, text, (size_t)length);
+    text[message->failed ? 0 : length] = '\0';
+}
+
+// Funkcja zapisująca do deskryptora wszystkie size bajtów
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int write_full(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        ssize_t written = write(fd, p, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return -1;
+        p += written;
+        size -= (size_t)written;
+    }
+    return 0;
+}
+
+// Funkcja odczytująca z deskryptora dokładnie size bajtów
+// Zwraca 0 w przypadku sukcesu, 1 gdy połączenie zamknięto przed pierwszym bajtem,
+// -1 w przypadku błędu lub przerwania w środku danych
+static int read_full(int fd, void* data, size_t size) {
+    char* p = (char*)data;
+    size_t done = 0;
+    while (done < size) {
+        ssize_t count = read(fd, p + done, size - done);
+        if (count < 0 && errno == EINTR) continue;
+        if (count == 0 && done == 0) return 1;
+        if (count <= 0) return -1;
+        done += (size_t)count;
+    }
+    return 0;
+}
+
+// Funkcja wysyłająca ramkę: długość treści i treść
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+static int send_frame(int fd, const Message* message) {
+    uint32_t length = (uint32_t)message->size;
+    if (write_full(fd, &length, sizeof(length)) != 0) return -1;
+    return write_full(fd, message->data, message->size);
+}
+
+// Funkcja wysyłająca żądanie
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int protocol_send_request(int fd, const PartitionRequest* request) {
+    unsigned char buffer[REQUEST_MAX_SIZE];
+    Message message = { buffer, 0, sizeof(buffer), 0, false };
+
+    const PartitionOptions* options = &request->options;
+    put_i32(&message, (int32_t)PROTOCOL_MAGIC);
+    put_i32(&message, PROTOCOL_VERSION);
+    put_i32(&message, request->type);
+    put_i32(&message, options->num_parts);
+    put_f64(&message, options->margin_percentage);
+    put_i32(&message, options->refinement);
+    put_i32(&message, options->initial);
+    put_i32(&message, options->multilevel);
+    put_i32(&message, (int32_t)options->seed);
+    put_i32(&message, options->num_starts);
+    put_i32(&message, request->format);
+    put_i32(&message, request->binary_output);
+    put_string(&message, request->graph_path);
+    put_string(&message, request->output_path);
+    if (message.failed) return -1;
+    return send_frame(fd, &message);
+}
+
+// Funkcja odbierająca żądanie
+// Zwraca 0 w przypadku sukcesu, 1 gdy klient zamknął połączenie,
+// -1 w przypadku błędu lub niepoprawnego żądania
+int protocol_recv_request(int fd, PartitionRequest* request) {
+    uint32_t length;
+    int status = read_full(fd, &length, sizeof(length));
+    if (status != 0) return status;
+    if (length > REQUEST_MAX_SIZE) return -1;
+
+    unsigned char buffer[REQUEST_MAX_SIZE];
+    if (read_full(fd, buffer, length) != 0) return -1;
+    Message message = { buffer, length, length, 0, false };
+
+    if ((uint32_t)get_i32(&message) != PROTOCOL_MAGIC || get_i32(&message) != PROTOCOL_VERSION) return -1;
+    memset(request, 0, sizeof(*request));
+    partition_options_init(&request->options);
+    request->type = (RequestType)get_i32(&message);
+    request->options.num_parts = get_i32(&message);
+    request->options.margin_percentage = get_f64(&message);
+    request->options.refinement = (RefinementMode)get_i32(&message);
+    request->options.initial = (InitialPartition)get_i32(&message);
+    request->options.multilevel = get_i32(&message) != 0;
+    request->options.seed = (unsigned int)get_i32(&message);
+    request->options.num_starts = get_i32(&message);
+    request->format = (DivisionFormat)get_i32(&message);
+    request->binary_output = get_i32(&message) != 0;
+    get_string(&message, request->graph_path, sizeof(request->graph_path));
+    get_string(&message, request->output_path, sizeof(request->output_path));
+    return (message.failed || message.position != message.size) ? -1 : 0;
+}
+
+// Funkcja wysyłająca odpowiedź; wektor części dołączany jest bez kopiowania
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int protocol_send_response(int fd, const PartitionResponse* response) {
+    unsigned char buffer[RESPONSE_HEADER_SIZE + PROTOCOL_MAX_MESSAGE];
+    Message message = { buffer, 0, sizeof(buffer), 0, false };
+
+    int32_t vector_count = response->part_of ? response->num_vertices : 0;
+    size_t message_length = strnlen(response->message, PROTOCOL_MAX_MESSAGE - 1);
+    put_i32(&message, response->status);
+    put_i64(&message, response->cut);
+    put_i32(&message, response->num_vertices);
+    put_i32(&message, response->cache_hit);
+    put_f64(&message, response->load_ms);
+    put_f64(&message, response->partition_ms);
+    put_i32(&message, vector_count);
+    put_i32(&message, (int32_t)message_length);
+    put_bytes(&message, response->message, message_length);
+    if (message.failed) return -1;
+
+    uint64_t total = message.size + (uint64_t)vector_count * sizeof(int);
+    if (total > UINT32_MAX) return -1;
+    uint32_t length = (uint32_t)total;
+    if (write_full(fd, &length, sizeof(length)) != 0 || write_full(fd, message.data, message.size) != 0) {
+        return -1;
+    }
+    return vector_count > 0 ? write_full(fd, response->part_of, (size_t)vector_count * sizeof(int)) : 0;
+}
+
+// Funkcja odbierająca odpowiedź; wektor części (jeśli przesłany) jest alokowany
+// i należy go zwolnić funkcją free
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int protocol_recv_response(int fd, PartitionResponse* response) {
+    memset(response, 0, sizeof(*response));
+    uint32_t length;
+    unsigned char buffer[RESPONSE_HEADER_SIZE];
+    if (read_full(fd, &length, sizeof(length)) != 0 || length < RESPONSE_HEADER_SIZE ||
+        read_full(fd, buffer, RESPONSE_HEADER_SIZE) != 0) {
+        return -1;
+    }
+    Message message = { buffer, RESPONSE_HEADER_SIZE, RESPONSE_HEADER_SIZE, 0, false };
+
+    response->status = get_i32(&message);
+    response->cut = (long)get_i64(&message);
+    response->num_vertices = get_i32(&message);
+    response->cache_hit = get_i32(&message) != 0;
+    response->load_ms = get_f64(&message);
+    response->partition_ms = get_f64(&message);
+    int32_t vector_count = get_i32(&message);
+    int32_t message_length = get_i32(&message);
+    if (vector_count < 0 || message_length < 0 || message_length >= PROTOCOL_MAX_MESSAGE ||
+        length != RESPONSE_HEADER_SIZE + (uint64_t)message_length + (uint64_t)vector_count * sizeof(int)) {
+        return -1;
+    }
+    if (read_full(fd, response->message, (size_t)message_length) != 0) return -1;
+    response->message[message_length] = '\0';
+
+    if (vector_count > 0) {
+        response->part_of = (int*)malloc((size_t)vector_count * sizeof(int));
+        if (!response->part_of || read_full(fd, response->part_of, (size_t)vector_count * sizeof(int)) != 0) {
+            free(response->part_of);
+            response->part_of = NULL;
+            return -1;
+        }
+    }
+    return 0;
+}
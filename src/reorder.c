@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/graph.h"
+
+// Liczba przebiegów BFS przy szukaniu węzła pseudoperyferyjnego (algorytm George'a-Liu)
+#define PERIPHERAL_SWEEPS 4
+
+// Największa liczba elementów sortowanych przez wstawianie
+#define INSERTION_SORT_LIMIT 32
+
+// Stan wyznaczania kolejności węzłów
+typedef struct {
+    const Graph* graph;
+    int* order;        // Kolejne węzły w nowej numeracji (order[nowy] = stary)
+    int* placed;       // Czy węzeł ma już nowy numer
+    int* level;        // Odległość od źródła bieżącego przeszukiwania (-1 - nieodwiedzony)
+    int* queue;        // Kolejka przeszukiwania pomocniczego
+    int64_t* sort_buffer; // Nieumieszczeni sąsiedzi jednego węzła (stopień << 32 | węzeł)
+} OrderingState;
+
+static int compare_keys(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Funkcja sortująca rosnąco klucze; krótkie tablice (typowe zbiory nowych sąsiadów)
+// sortowane są przez wstawianie, dłuższe funkcją qsort
+static void sort_keys(int64_t* keys, int count) {
+    if (count > INSERTION_SORT_LIMIT) {
+        qsort(keys, count, sizeof(int64_t), compare_keys);
+        return;
+    }
+    for (int i = 1; i < count; i++) {
+        int64_t key = keys[i];
+        int j = i - 1;
+        while (j >= 0 && keys[j] > key) {
+            keys[j + 1] = keys[j];
+            j--;
+        }
+        keys[j + 1] = key;
+    }
+}
+
+// Funkcja przeszukująca wszerz składową węzła start i wyznaczająca poziomy węzłów
+// Parametry eccentricity i last_vertex - numer ostatniego poziomu i węzeł tego poziomu
+// o najmniejszym stopniu
+// Zwraca liczbę odwiedzonych węzłów; level jest po powrocie ponownie wypełnione -1
+static int bfs_levels(OrderingState* state, int start, int* eccentricity, int* last_vertex) {
+    const Graph* graph = state->graph;
+    int head = 0;
+    int tail = 0;
+    state->queue[tail++] = start;
+    state->level[start] = 0;
+    while (head < tail) {
+        int v = state->queue[head++];
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            if (state->level[it.neighbor] >= 0) continue;
+            state->level[it.neighbor] = state->level[v] + 1;
+            state->queue[tail++] = it.neighbor;
+        }
+    }
+
+    int depth = state->level[state->queue[tail - 1]];
+    int best = state->queue[tail - 1];
+    for (int i = tail - 1; i >= 0 && state->level[state->queue[i]] == depth; i--) {
+        int v = state->queue[i];
+        if (graph_degree(graph, v) < graph_degree(graph, best)) best = v;
+    }
+    for (int i = 0; i < tail; i++) state->level[state->queue[i]] = -1;
+    *eccentricity = depth;
+    *last_vertex = best;
+    return tail;
+}
+
+// Funkcja wybierająca węzeł pseudoperyferyjny składowej węzła start
+// Kolejne przeszukiwania startują z węzła o najmniejszym stopniu na ostatnim poziomie,
+// dopóki liczba poziomów rośnie; numeracja od takiego węzła daje wąskie poziomy
+static int pseudo_peripheral(OrderingState* state, int start) {
+    int eccentricity;
+    int candidate;
+    bfs_levels(state, start, &eccentricity, &candidate);
+    for (int sweep = 0; sweep < PERIPHERAL_SWEEPS && candidate != start; sweep++) {
+        int next_eccentricity;
+        int next_candidate;
+        bfs_levels(state, candidate, &next_eccentricity, &next_candidate);
+        if (next_eccentricity <= eccentricity) break;
+        start = candidate;
+        eccentricity = next_eccentricity;
+        candidate = next_candidate;
+    }
+    return start;
+}
+
+// Funkcja numerująca składową węzła start przeszukiwaniem wszerz od pozycji position
+// Dla kolejności Cuthilla-McKee sąsiedzi każdego węzła numerowani są rosnąco według
+// stopnia, dla BFS w kolejności list sąsiadów
+// Zwraca pierwszą wolną pozycję za składową
+static int number_component(OrderingState* state, int start, int position, VertexOrdering ordering) {
+    const Graph* graph = state->graph;
+    int head = position;
+    int tail = position;
+    state->order[tail++] = start;
+    state->placed[start] = 1;
+    while (head < tail) {
+        int v = state->order[head++];
+        int first = tail;
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            if (state->placed[it.neighbor]) continue;
+            state->placed[it.neighbor] = 1;
+            state->order[tail++] = it.neighbor;
+        }
+        if (ordering == ORDER_RCM && tail - first > 1) {
+            int count = tail - first;
+            for (int i = 0; i < count; i++) {
+                int u = state->order[first + i];
+                state->sort_buffer[i] = ((int64_t)graph_degree(graph, u) << 32) | (uint32_t)u;
+            }
+            sort_keys(state->sort_buffer, count);
+            for (int i = 0; i < count; i++) state->order[first + i] = (int)(state->sort_buffer[i] & 0xFFFFFFFF);
+        }
+    }
+    return tail;
+}
+
+// Funkcja wyznaczająca nową kolejność węzłów (order[nowy] = stary)
+// Składowe numerowane są kolejno, każda od węzła pseudoperyferyjnego (RCM)
+// albo od węzła o najmniejszym indeksie (BFS); kolejność RCM jest odwróconą
+// kolejnością Cuthilla-McKee
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu alokacji
+static int compute_ordering(const Graph* graph, VertexOrdering ordering, int* order) {
+    int n = graph->total_vertices;
+    int max_degree = 0;
+    for (int v = 0; v < n; v++) {
+        int degree = graph_degree(graph, v);
+        if (degree > max_degree) max_degree = degree;
+    }
+
+    OrderingState state;
+    state.graph = graph;
+    state.order = order;
+    state.placed = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+    state.level = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    state.queue = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    state.sort_buffer = (int64_t*)malloc((max_degree > 0 ? max_degree : 1) * sizeof(int64_t));
+    if (!state.placed || !state.level || !state.queue || !state.sort_buffer) {
+        free(state.placed);
+        free(state.level);
+        free(state.queue);
+        free(state.sort_buffer);
+        return -1;
+    }
+    for (int v = 0; v < n; v++) state.level[v] = -1;
+
+    int position = 0;
+    for (int v = 0; v < n; v++) {
+        if (state.placed[v]) continue;
+        int start = (ordering == ORDER_RCM) ? pseudo_peripheral(&state, v) : v;
+        position = number_component(&state, start, position, ordering);
+    }
+
+    if (ordering == ORDER_RCM) {
+        for (int i = 0, j = n - 1; i < j; i++, j--) {
+            int vertex = order[i];
+            order[i] = order[j];
+            order[j] = vertex;
+        }
+    }
+
+    free(state.placed);
+    free(state.level);
+    free(state.queue);
+    free(state.sort_buffer);
+    return 0;
+}
+
+// Funkcja przenumerowująca węzły grafu w kolejności RCM lub BFS
+// Sąsiedzi w kolejnych listach mają wtedy zbliżone numery, więc wszystkie pętle po
+// sąsiadach odwołują się do pobliskich elementów tablic węzłów (part_of, zyski, wagi)
+// zamiast skakać po całej pamięci. Tablice CSR, wagi i kolumny węzłów budowane są
+// od nowa w nowej kolejności, a vertex_indices[nowy] przechowuje pierwotny indeks
+// węzła - przez tę tablicę zapisywane są wyniki, więc pliki wynikowe zawierają
+// pierwotne indeksy. row_pointers nadal opisuje wiersze w pierwotnej numeracji
+// Grafy odwzorowane z pliku .csrb i skompresowane nie są przenumerowywane
+// (przenumerowanie należy wykonać przed kompresją)
+// Zwraca 0 w przypadku sukcesu, -1 w przypadku błędu
+int graph_reorder(Graph* graph, VertexOrdering ordering) {
+    if (!graph || graph->mapping || graph->adj_offsets || !graph->xadj || !graph->vertex_indices) return -1;
+    if (ordering == ORDER_NONE) return 0;
+    if (ordering != ORDER_BFS && ordering != ORDER_RCM) return -1;
+
+    STATS_PHASE_BEGIN(start);
+    int n = graph->total_vertices;
+    int64_t slots = graph->xadj[n];
+    int* order = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    int* new_id = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    int64_t* xadj = (int64_t*)malloc(((size_t)n + 1) * sizeof(int64_t));
+    int32_t* adjncy = (int32_t*)malloc((slots > 0 ? slots : 1) * sizeof(int32_t));
+    int* adjwgt = graph->adjwgt ? (int*)malloc((slots > 0 ? slots : 1) * sizeof(int)) : NULL;
+    int* vwgt = graph->vwgt ? (int*)malloc((n > 0 ? n : 1) * sizeof(int)) : NULL;
+    int* cols = graph->vertex_cols ? (int*)malloc((n > 0 ? n : 1) * sizeof(int)) : NULL;
+    int* indices = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!order || !new_id || !xadj || !adjncy || (graph->adjwgt && !adjwgt) || (graph->vwgt && !vwgt) ||
+        (graph->vertex_cols && !cols) || !indices || compute_ordering(graph, ordering, order) != 0) {
+        free(order);
+        free(new_id);
+        free(xadj);
+        free(adjncy);
+        free(adjwgt);
+        free(vwgt);
+        free(cols);
+        free(indices);
+        STATS_PHASE_END(PHASE_REORDER, start);
+        return -1;
+    }
+    for (int i = 0; i < n; i++) new_id[order[i]] = i;
+
+    // Długości list w nowej kolejności
+    xadj[0] = 0;
+    for (int i = 0; i < n; i++) {
+        xadj[i + 1] = xadj[i] + graph_degree(graph, order[i]);
+    }
+
+    // Listy budowane są przez transpozycję: węzeł i dopisywany jest do list swoich
+    // sąsiadów w kolejności rosnących nowych numerów, więc każda lista jest posortowana
+    int64_t* fill = (int64_t*)malloc((n > 0 ? n : 1) * sizeof(int64_t));
+    if (!fill) {
+        free(order);
+        free(new_id);
+        free(xadj);
+        free(adjncy);
+        free(adjwgt);
+        free(vwgt);
+        free(cols);
+        free(indices);
+        STATS_PHASE_END(PHASE_REORDER, start);
+        return -1;
+    }
+    memcpy(fill, xadj, (size_t)n * sizeof(int64_t));
+    for (int i = 0; i < n; i++) {
+        FOR_EACH_NEIGHBOR(graph, order[i], it) {
+            int64_t position = fill[new_id[it.neighbor]]++;
+            adjncy[position] = i;
+            if (adjwgt) adjwgt[position] = neighbor_weight(graph, &it);
+        }
+        if (vwgt) vwgt[i] = graph->vwgt[order[i]];
+        if (cols) cols[i] = graph->vertex_cols[order[i]];
+        indices[i] = graph->vertex_indices[order[i]];
+    }
+    free(fill);
+    free(order);
+    free(new_id);
+
+    graph_set_adjacency(graph, xadj, adjncy);
+    free(graph->adjwgt);
+    free(graph->vwgt);
+    free(graph->vertex_cols);
+    free(graph->vertex_indices);
+    graph->adjwgt = adjwgt;
+    graph->vwgt = vwgt;
+    graph->vertex_cols = cols;
+    graph->vertex_indices = indices;
+    STATS_PHASE_END(PHASE_REORDER, start);
+    return 0;
+}
+
+// Funkcja sprawdzająca, czy numeracja węzłów grafu różni się od pierwotnej
+bool graph_is_reordered(const Graph* graph) {
+    if (!graph->vertex_indices) return false;
+    for (int v = 0; v < graph->total_vertices; v++) {
+        if (graph->vertex_indices[v] != v) return true;
+    }
+    return false;
+}
+
+// Funkcja wyznaczająca średnią odległość numerów sąsiadów (|u - v| po wszystkich
+// krawędziach); mała wartość oznacza dobrą lokalność odwołań w pętlach po sąsiadach
+double graph_average_gap(const Graph* graph) {
+    double total = 0.0;
+    long count = 0;
+    for (int v = 0; v < graph->total_vertices; v++) {
+        FOR_EACH_NEIGHBOR(graph, v, it) {
+            total += (it.neighbor > v) ? it.neighbor - v : v - it.neighbor;
+            count++;
+        }
+    }
+    return count > 0 ? total / count : 0.0;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/graph.h"
+
+// Raporty tekstowe programów wiersza poleceń
+// Moduł nie wchodzi w skład biblioteki libgraphpart, która niczego nie wypisuje
+
+// Funkcja wyświetlająca podstawowe informacje o grafie
+// Wyświetla liczbę wierzchołków, strukturę wierszy i statystyki połączeń
+void print_graph_info(const Graph* graph) {
+    if (!graph) return;
+
+    printf("\nInformacje o grafie:\n");
+    printf("----------------\n");
+    printf("Całkowita liczba wierzchołków: %d\n", graph->total_vertices);
+    printf("Maksymalna liczba wierzchołków w wierszu: %d\n", graph->max_vertices);
+    printf("Liczba wierszy: %d\n", graph->num_rows);
+    
+    // Wyświetlanie struktury wierszy grafu
+    printf("\nStruktura wierszy:\n");
+    for (int i = 0; i < graph->num_rows; i++) {
+        int start = graph->row_pointers[i];
+        int end = (i < graph->num_rows - 1) ? graph->row_pointers[i + 1] : graph->total_vertices;
+        printf("Wiersz %d (wierzchołki %d-%d):", i + 1, start + 1, end);
+        for (int j = start; j < end; j++) {
+            printf(" %d", j);
+        }
+        printf("\n");
+    }
+
+    // Obliczanie statystyk połączeń w grafie
+    long total_edges = 0;   // Całkowita liczba krawędzi
+    int max_degree = 0;     // Maksymalny stopień wierzchołka
+    double avg_degree = 0.0; // Średni stopień wierzchołka
+
+    // Obliczanie stopni wierzchołków i całkowitej liczby krawędzi
+    for (int i = 0; i < graph->total_vertices; i++) {
+        int degree = graph_degree(graph, i);
+        total_edges += degree;
+        if (degree > max_degree) {
+            max_degree = degree;
+        }
+    }
+    total_edges /= 2; // Każda krawędź była liczona dwukrotnie
+    avg_degree = (double)total_edges * 2 / graph->total_vertices;
+
+    // Wyświetlanie statystyk połączeń
+    printf("\nStatystyki połączeń:\n");
+    printf("Całkowita liczba krawędzi: %ld\n", total_edges);
+    printf("Maksymalny stopień wierzchołka: %d\n", max_degree);
+    printf("Średni stopień wierzchołka: %.2f\n", avg_degree);
+}
+
+// Funkcja wyświetlająca informacje o podziale grafu na grupy
+// Wyświetla szczegóły każdej grupy i statystyki podziału
+// Indeksy węzłów wyświetlane są w pierwotnej numeracji (graph->vertex_indices)
+void print_division_info(const Graph* graph, const VertexGroup* groups, int num_groups) {
+    if (!groups || num_groups <= 0) return;
+
+    printf("\nInformacje o podziale:\n");
+    printf("-------------------\n");
+    
+    // Obliczanie statystyk grup
+    int min_size = groups[0].count;  // Minimalna wielkość grupy
+    int max_size = groups[0].count;  // Maksymalna wielkość grupy
+    double avg_size = 0.0;           // Średnia wielkość grupy
+    
+    // Znajdowanie minimalnej, maksymalnej i średniej wielkości grup
+    for (int i = 0; i < num_groups; i++) {
+        int size = groups[i].count;
+        if (size < min_size) min_size = size;
+        if (size > max_size) max_size = size;
+        avg_size += size;
+    }
+    avg_size /= num_groups;
+
+    // Wyświetlanie szczegółów każdej grupy
+    for (int i = 0; i < num_groups; i++) {
+        printf("\nGrupa %d:\n", i + 1);
+        printf("  Rozmiar: %d wierzchołków\n", groups[i].count);
+        printf("  Indeks pierwszego wierzchołka: %d\n", graph->vertex_indices[groups[i].first_vertex]);
+        printf("  Wierzchołki:");
+        
+        // Wyświetlanie maksymalnie 10 pierwszych wierzchołków w grupie
+        int display_count = groups[i].count > 10 ? 10 : groups[i].count;
+        for (int j = 0; j < display_count; j++) {
+            printf(" %d", graph->vertex_indices[groups[i].vertices[j]]);
+        }
+        if (groups[i].count > 10) {
+            printf(" ... (pozostałe %d)", groups[i].count - 10);
+        }
+        printf("\n");
+    }
+
+    // Wyświetlanie statystyk podziału
+    printf("\nStatystyki podziału:\n");
+    printf("Minimalna wielkość grupy: %d wierzchołków\n", min_size);
+    printf("Maksymalna wielkość grupy: %d wierzchołków\n", max_size);
+    printf("Średnia wielkość grupy: %.2f wierzchołków\n", avg_size);
+    printf("Różnica wielkości: %.2f%%\n", ((double)(max_size - min_size) / min_size) * 100.0);
+}
@@ -0,0 +1,502 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <math.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include "../include/graph.h"
+
+#define DEFAULT_WORKERS 4          // Domyślna liczba wątków obsługi połączeń
+#define DEFAULT_CACHE_GRAPHS 8     // Domyślna liczba grafów utrzymywanych w pamięci
+#define CONNECTION_QUEUE_SIZE 64   // Pojemność kolejki połączeń oczekujących na obsługę
+#define POLL_INTERVAL_MS 250       // Co ile wątki sprawdzają flagę zatrzymania
+#define IO_TIMEOUT_SECONDS 30      // Najdłuższe oczekiwanie na dalszą część ramki lub zapis odpowiedzi
+
+// Graf utrzymywany w pamięci, identyfikowany ścieżką oraz stanem pliku z chwili wczytania
+typedef struct CacheEntry {
+    char* path;                  // Ścieżka podana w żądaniu
+    dev_t device;                // Urządzenie, i-węzeł, rozmiar i czas modyfikacji pliku
+    ino_t inode;
+    off_t size;
+    struct timespec mtime;
+    Graph* graph;
+    int references;              // Liczba żądań korzystających z grafu
+    bool stale;                  // Wpis usunięty z listy; zwalniany po ostatnim użyciu
+    unsigned long last_used;     // Znacznik ostatniego użycia (wybór wpisu do usunięcia)
+    struct CacheEntry* next;
+} CacheEntry;
+
+// Pamięć podręczna wczytanych grafów
+typedef struct {
+    pthread_mutex_t lock;
+    CacheEntry* entries;
+    int count;
+    int capacity;                // Największa liczba grafów na liście
+    bool compress;               // Kompresja list sąsiadów wczytanych grafów
+    unsigned long clock;
+} GraphCache;
+
+// Stan serwera współdzielony przez wątki
+typedef struct {
+    GraphCache cache;
+    int partition_threads;       // Wątki używane przez pojedynczy podział
+    pthread_mutex_t lock;        // Ochrona kolejki połączeń
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    int queue[CONNECTION_QUEUE_SIZE];
+    int queue_head;
+    int queue_count;
+} Server;
+
+// Flaga zatrzymania ustawiana przez sygnał lub żądanie REQUEST_SHUTDOWN
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+// Funkcja zwracająca bieżący czas monotoniczny w milisekundach
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+// Funkcja sprawdzająca, czy wpis odpowiada bieżącemu stanowi pliku
+static bool entry_matches(const CacheEntry* entry, const struct stat* st) {
+    return entry->device == st->st_dev && entry->inode == st->st_ino && entry->size == st->st_size &&
+           entry->mtime.tv_sec == st->st_mtim.tv_sec && entry->mtime.tv_nsec == st->st_mtim.tv_nsec;
+}
+
+// Funkcja zwalniająca wpis pamięci podręcznej
+static void entry_free(CacheEntry* entry) {
+    destroy_graph(entry->graph);
+    free(entry->path);
+    free(entry);
+}
+
+// Funkcja odłączająca wpis od listy; wpis w użyciu zwalniany jest przez cache_release
+// Wywoływana z zablokowanym cache->lock
+static void cache_unlink(GraphCache* cache, CacheEntry* entry) {
+    for (CacheEntry** link = &cache->entries; *link; link = &(*link)->next) {
+        if (*link == entry) {
+            *link = entry->next;
+            cache->count--;
+            break;
+        }
+    }
+    entry->stale = true;
+    if (entry->references == 0) entry_free(entry);
+}
+
+// Funkcja usuwająca najdawniej używane, nieużywane grafy ponad pojemność pamięci podręcznej
+// Wywoływana z zablokowanym cache->lock
+static void cache_evict(GraphCache* cache) {
+    while (cache->count > cache->capacity) {
+        CacheEntry* oldest = NULL;
+        for (CacheEntry* entry = cache->entries; entry; entry = entry->next) {
+            if (entry->references == 0 && (!oldest || entry->last_used < oldest->last_used)) oldest = entry;
+        }
+        if (!oldest) break;
+        cache_unlink(cache, oldest);
+    }
+}
+
+// Funkcja pobierająca graf z pamięci podręcznej lub wczytująca go z pliku
+// Wpis jest aktualny, gdy plik ma ten sam i-węzeł, rozmiar i czas modyfikacji co przy
+// wczytaniu; w przeciwnym razie graf jest wczytywany ponownie. Wczytywanie odbywa się
+// bez blokady, więc inne żądania są w tym czasie obsługiwane. Przy włączonej kompresji
+// listy sąsiadów grafów wczytanych z CSRRG są kompresowane; grafy .csrb pozostają
+// odwzorowane bez zmian
+// Parametry hit i load_ms - informacja o trafieniu i czas wczytywania
+// Zwraca wpis (do zwolnienia przez cache_release) lub NULL w przypadku błędu
+static CacheEntry* cache_acquire(GraphCache* cache, const char* path, int num_threads, bool* hit,
+                                 double* load_ms) {
+    *hit = false;
+    *load_ms = 0.0;
+    struct stat st;
+    if (stat(path, &st) != 0) return NULL;
+
+    pthread_mutex_lock(&cache->lock);
+    for (CacheEntry* entry = cache->entries; entry; entry = entry->next) {
+        if (strcmp(entry->path, path) != 0) continue;
+        if (entry_matches(entry, &st)) {
+            entry->references++;
+            entry->last_used = ++cache->clock;
+            pthread_mutex_unlock(&cache->lock);
+            *hit = true;
+            return entry;
+        }
+        cache_unlink(cache, entry);
+        break;
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    CacheEntry* loaded = (CacheEntry*)calloc(1, sizeof(CacheEntry));
+    if (!loaded || !(loaded->path = strdup(path))) {
+        free(loaded);
+        return NULL;
+    }
+    double start = now_ms();
+    if (load_graph_from_file_parallel(path, &loaded->graph, num_threads) != 0) {
+        free(loaded->path);
+        free(loaded);
+        return NULL;
+    }
+    if (cache->compress && !loaded->graph->mapping && graph_compress(loaded->graph) != 0) {
+        destroy_graph(loaded->graph);
+        free(loaded->path);
+        free(loaded);
+        return NULL;
+    }
+    *load_ms = now_ms() - start;
+    loaded->device = st.st_dev;
+    loaded->inode = st.st_ino;
+    loaded->size = st.st_size;
+    loaded->mtime = st.st_mtim;
+    loaded->references = 1;
+
+    pthread_mutex_lock(&cache->lock);
+    loaded->last_used = ++cache->clock;
+    loaded->next = cache->entries;
+    cache->entries = loaded;
+    cache->count++;
+    // Starszy wpis tej samej ścieżki (wczytany równolegle) zostaje zastąpiony
+    for (CacheEntry* entry = loaded->next; entry; entry = entry->next) {
+        if (strcmp(entry->path, path) == 0) {
+            cache_unlink(cache, entry);
+            break;
+        }
+    }
+    cache_evict(cache);
+    pthread_mutex_unlock(&cache->lock);
+    return loaded;
+}
+
+// Funkcja zwalniająca wpis pobrany przez cache_acquire
+static void cache_release(GraphCache* cache, CacheEntry* entry) {
+    pthread_mutex_lock(&cache->lock);
+    entry->references--;
+    if (entry->references == 0) {
+        if (entry->stale) entry_free(entry);
+        else cache_evict(cache);
+    }
+    pthread_mutex_unlock(&cache->lock);
+}
+
+// Funkcja zwalniająca wszystkie grafy pamięci podręcznej
+static void cache_destroy(GraphCache* cache) {
+    CacheEntry* entry = cache->entries;
+    while (entry) {
+        CacheEntry* next = entry->next;
+        entry_free(entry);
+        entry = next;
+    }
+    pthread_mutex_destroy(&cache->lock);
+}
+
+// Funkcja sprawdzająca poprawność opcji żądania dla grafu o n węzłach
+static const char* validate_request(const PartitionRequest* request, int n) {
+    const PartitionOptions* options = &request->options;
+    if (options->num_parts <= 0 || options->num_parts > n) return "Niepoprawna liczba części";
+    if (!(options->margin_percentage >= 0) || isinf(options->margin_percentage)) {
+        return "Margines musi być skończoną liczbą nieujemną";
+    }
+    if (options->num_starts <= 0) return "Liczba startów musi być większa od 0";
+    if (options->refinement < REFINE_KL || options->refinement > REFINE_NONE) return "Nieznany algorytm udoskonalania";
+    if (options->initial != INITIAL_CONTIGUOUS && options->initial != INITIAL_GEOMETRIC) return "Nieznany podział początkowy";
+    if (request->format < DIVISION_GROUPS || request->format > DIVISION_VARINT) return "Nieznany format wyniku";
+    return NULL;
+}
+
+// Funkcja wykonująca żądanie podziału i wypełniająca odpowiedź
+// Wektor części zwalnia wywołujący (response->part_of)
+static void process_partition(Server* server, const PartitionRequest* request, PartitionResponse* response) {
+    bool hit;
+    CacheEntry* entry = cache_acquire(&server->cache, request->graph_path, server->partition_threads,
+                                      &hit, &response->load_ms);
+    if (!entry) {
+        snprintf(response->message, sizeof(response->message), "Nie udało się wczytać grafu z pliku: %.160s",
+                 request->graph_path);
+        return;
+    }
+    Graph* graph = entry->graph;
+    response->cache_hit = hit;
+    response->num_vertices = graph->total_vertices;
+
+    const char* invalid = validate_request(request, graph->total_vertices);
+    int* part_of = invalid ? NULL : (int*)malloc((graph->total_vertices > 0 ? graph->total_vertices : 1) * sizeof(int));
+    if (invalid || !part_of) {
+        snprintf(response->message, sizeof(response->message), "%s", invalid ? invalid : "Brak pamięci");
+        cache_release(&server->cache, entry);
+        return;
+    }
+
+    PartitionOptions options = request->options;
+    options.num_threads = server->partition_threads;
+    double start = now_ms();
+    int status = partition_graph(graph, &options, part_of);
+    response->partition_ms = now_ms() - start;
+    if (status == 0) response->cut = calculate_cut_from_parts(graph, part_of);
+
+    // Zapis wyniku do pliku wskazanego w żądaniu
+    if (status == 0 && request->output_path[0] != '\0') {
+        VertexGroup* groups = NULL;
+        status = partition_to_groups(part_of, graph->total_vertices, options.num_parts, &groups);
+        if (status == 0) {
+            status = save_graph_division_format(request->output_path, graph, groups, options.num_parts,
+                                                request->format, request->binary_output);
+            for (int i = 0; i < options.num_parts; i++) free(groups[i].vertices);
+            free(groups);
+        }
+        if (status != 0) {
+            snprintf(response->message, sizeof(response->message), "Nie udało się zapisać podziału do pliku: %.160s",
+                     request->output_path);
+        }
+        free(part_of);
+        part_of = NULL;
+    } else if (status != 0) {
+        snprintf(response->message, sizeof(response->message), "Nie udało się podzielić grafu");
+    }
+    cache_release(&server->cache, entry);
+
+    if (status != 0) {
+        free(part_of);
+        return;
+    }
+    response->status = 0;
+    response->part_of = part_of;
+}
+
+// Funkcja czekająca na dane połączenia z okresowym sprawdzaniem flagi zatrzymania
+// Zwraca true, gdy można czytać
+static bool wait_readable(int fd) {
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    while (!stop_requested) {
+        int ready = poll(&pfd, 1, POLL_INTERVAL_MS);
+        if (ready > 0) return true;
+        if (ready < 0 && errno != EINTR) return false;
+    }
+    return false;
+}
+
+// Funkcja obsługująca połączenie: kolejne żądania aż do zamknięcia przez klienta
+static void handle_connection(Server* server, int fd) {
+    PartitionRequest* request = (PartitionRequest*)malloc(sizeof(PartitionRequest));
+    if (!request) return;
+
+    while (wait_readable(fd) && protocol_recv_request(fd, request) == 0) {
+        PartitionResponse response;
+        memset(&response, 0, sizeof(response));
+        response.status = -1;
+
+        if (request->type == REQUEST_SHUTDOWN) {
+            stop_requested = 1;
+            response.status = 0;
+            snprintf(response.message, sizeof(response.message), "Serwer zostanie zatrzymany");
+        } else if (request->type == REQUEST_PARTITION) {
+            process_partition(server, request, &response);
+        } else {
+            snprintf(response.message, sizeof(response.message), "Nieznany rodzaj żądania");
+        }
+
+        int sent = protocol_send_response(fd, &response);
+        free(response.part_of);
+        if (sent != 0) break;
+    }
+    free(request);
+}
+
+// Główna pętla wątku obsługi: pobieranie połączeń z kolejki
+static void* worker_main(void* data) {
+    Server* server = (Server*)data;
+    for (;;) {
+        pthread_mutex_lock(&server->lock);
+        while (server->queue_count == 0 && !stop_requested) {
+            pthread_cond_wait(&server->not_empty, &server->lock);
+        }
+        if (server->queue_count == 0) {
+            pthread_mutex_unlock(&server->lock);
+            return NULL;
+        }
+        int fd = server->queue[server->queue_head];
+        server->queue_head = (server->queue_head + 1) % CONNECTION_QUEUE_SIZE;
+        server->queue_count--;
+        pthread_cond_signal(&server->not_full);
+        pthread_mutex_unlock(&server->lock);
+
+        handle_connection(server, fd);
+        close(fd);
+    }
+}
+
+// Funkcja tworząca nasłuchujące gniazdo uniksowe
+// Plik gniazda pozostawiony przez poprzedni, zakończony serwer jest usuwany; gdy pod
+// ścieżką działa inny serwer, funkcja kończy się błędem
+// Zwraca deskryptor gniazda lub -1 w przypadku błędu
+static int open_listener(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Błąd: Zbyt długa ścieżka gniazda: %s\n", path);
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe >= 0) {
+        bool running = connect(probe, (struct sockaddr*)&address, sizeof(address)) == 0;
+        close(probe);
+        if (running) {
+            fprintf(stderr, "Błąd: Pod ścieżką %s działa już serwer\n", path);
+            return -1;
+        }
+    }
+    unlink(path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        fprintf(stderr, "Błąd: Nie udało się utworzyć gniazda: %s (%s)\n", path, strerror(errno));
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Podpolecenie serve: serwer podziału utrzymujący wczytane grafy w pamięci
+// Połączenia przyjmowane są w wątku głównym i przekazywane przez kolejkę do puli
+// wątków obsługi; serwer kończy pracę po sygnale SIGINT/SIGTERM lub żądaniu zatrzymania
+// Zwraca kod wyjścia programu
+int serve_command(int argc, char* argv[]) {
+    int num_workers = DEFAULT_WORKERS;
+    int partition_threads = 1;
+    int cache_graphs = DEFAULT_CACHE_GRAPHS;
+    bool compress = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "w:j:c:z")) != -1) {
+        int value = optarg ? atoi(optarg) : 1;
+        if (value <= 0) opt = '?';
+        switch (opt) {
+            case 'w':
+                num_workers = value;
+                break;
+            case 'j':
+                partition_threads = value;
+                break;
+            case 'c':
+                cache_graphs = value;
+                break;
+            case 'z':
+                compress = true;
+                break;
+            default:
+                fprintf(stderr, "Błąd: Nieprawidłowa opcja polecenia serve\n");
+                return 1;
+        }
+    }
+    if (argc - optind != 1) {
+        fprintf(stderr, "Błąd: Polecenie serve wymaga ścieżki gniazda\n");
+        return 1;
+    }
+    const char* socket_path = argv[optind];
+
+    int listener = open_listener(socket_path);
+    if (listener < 0) return 1;
+
+    // Sygnały przerywają oczekiwanie zamiast wznawiać wywołania systemowe
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_stop_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    Server server;
+    memset(&server, 0, sizeof(server));
+    pthread_mutex_init(&server.cache.lock, NULL);
+    server.cache.capacity = cache_graphs;
+    server.cache.compress = compress;
+    server.partition_threads = partition_threads;
+    pthread_mutex_init(&server.lock, NULL);
+    pthread_cond_init(&server.not_empty, NULL);
+    pthread_cond_init(&server.not_full, NULL);
+
+    pthread_t* workers = (pthread_t*)malloc(num_workers * sizeof(pthread_t));
+    int started = 0;
+    while (workers && started < num_workers &&
+           pthread_create(&workers[started], NULL, worker_main, &server) == 0) {
+        started++;
+    }
+    if (started == 0) {
+        fprintf(stderr, "Błąd: Nie udało się uruchomić wątków obsługi\n");
+        stop_requested = 1;
+    } else {
+        printf("Serwer nasłuchuje na gnieździe: %s (wątki obsługi: %d, wątki podziału: %d, grafy w pamięci: %d)\n",
+               socket_path, started, partition_threads, cache_graphs);
+        fflush(stdout);
+    }
+
+    // Przyjmowanie połączeń
+    struct pollfd pfd = { listener, POLLIN, 0 };
+    while (!stop_requested) {
+        int ready = poll(&pfd, 1, POLL_INTERVAL_MS);
+        if (ready <= 0) continue;
+        int client = accept(listener, NULL, NULL);
+        if (client < 0) continue;
+
+        // Limit czasu odczytu i zapisu: klient, który przerwie wysyłanie ramki w połowie
+        // albo przestanie odbierać odpowiedź, nie blokuje wątku obsługi (ani zatrzymania
+        // serwera) - read_full i write_full kończą się błędem, a połączenie jest zamykane
+        // Oczekiwanie na kolejne żądanie odbywa się w wait_readable i nie jest ograniczone
+        struct timeval timeout = { IO_TIMEOUT_SECONDS, 0 };
+        if (setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0 ||
+            setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0) {
+            close(client);
+            continue;
+        }
+
+        pthread_mutex_lock(&server.lock);
+        while (server.queue_count == CONNECTION_QUEUE_SIZE && !stop_requested) {
+            pthread_cond_wait(&server.not_full, &server.lock);
+        }
+        if (stop_requested) {
+            close(client);
+        } else {
+            server.queue[(server.queue_head + server.queue_count) % CONNECTION_QUEUE_SIZE] = client;
+            server.queue_count++;
+            pthread_cond_signal(&server.not_empty);
+        }
+        pthread_mutex_unlock(&server.lock);
+    }
+
+    // Zatrzymanie: wątki kończą bieżące żądania, połączenia z kolejki są zamykane
+    pthread_mutex_lock(&server.lock);
+    for (int i = 0; i < server.queue_count; i++) {
+        close(server.queue[(server.queue_head + i) % CONNECTION_QUEUE_SIZE]);
+    }
+    server.queue_count = 0;
+    pthread_cond_broadcast(&server.not_empty);
+    pthread_mutex_unlock(&server.lock);
+    for (int i = 0; i < started; i++) pthread_join(workers[i], NULL);
+    free(workers);
+
+    close(listener);
+    unlink(socket_path);
+    cache_destroy(&server.cache);
+    pthread_mutex_destroy(&server.lock);
+    pthread_cond_destroy(&server.not_empty);
+    pthread_cond_destroy(&server.not_full);
+    printf("Serwer zatrzymano\n");
+    return started > 0 ? 0 : 1;
+}
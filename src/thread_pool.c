@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "../include/graph.h"
+
+// Pula wątków wykonująca zadania w stylu "parallel for"
+// Wątek wywołujący thread_pool_run również pobiera zadania, więc pula
+// dla num_threads wątków tworzy num_threads - 1 wątków roboczych
+struct ThreadPool {
+    pthread_t* workers;          // Wątki robocze
+    int num_workers;             // Liczba wątków roboczych
+    pthread_mutex_t lock;        // Ochrona stanu bieżącego zlecenia
+    pthread_cond_t work_ready;   // Sygnał nowego zlecenia lub zamknięcia puli
+    pthread_cond_t work_done;    // Sygnał zakończenia wszystkich zadań zlecenia
+    pthread_mutex_t run_lock;    // Serializacja kolejnych wywołań thread_pool_run
+    ThreadTask task;             // Funkcja bieżącego zlecenia (NULL - brak zlecenia)
+    void* arg;                   // Argument wspólny dla zadań zlecenia
+    int task_count;              // Liczba zadań w zleceniu
+    int next_task;               // Indeks następnego zadania do pobrania
+    int active;                  // Liczba zadań w trakcie wykonywania
+    bool shutdown;               // Flaga zamykania puli
+};
+
+// Funkcja pobierająca i wykonująca zadania bieżącego zlecenia
+// Wywoływana z zablokowanym pool->lock, wraca również z zablokowanym
+static void run_pending_tasks(ThreadPool* pool) {
+    while (pool->task && pool->next_task < pool->task_count) {
+        int index = pool->next_task++;
+        ThreadTask task = pool->task;
+        void* arg = pool->arg;
+        pool->active++;
+        pthread_mutex_unlock(&pool->lock);
+
+        task(arg, index);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->active--;
+        if (pool->next_task >= pool->task_count && pool->active == 0) {
+            pthread_cond_broadcast(&pool->work_done);
+        }
+    }
+}
+
+// Główna pętla wątku roboczego
+static void* worker_main(void* data) {
+    ThreadPool* pool = (ThreadPool*)data;
+
+    pthread_mutex_lock(&pool->lock);
+    while (!pool->shutdown) {
+        if (pool->task && pool->next_task < pool->task_count) {
+            run_pending_tasks(pool);
+        } else {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+// Funkcja tworząca pulę wątków
+// Parametr num_threads - łączna liczba wątków wykonujących zadania (łącznie z wywołującym)
+// Zwraca wskaźnik do puli lub NULL w przypadku błędu
+ThreadPool* thread_pool_create(int num_threads) {
+    if (num_threads < 1) num_threads = 1;
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) return NULL;
+
+    pool->workers = (pthread_t*)malloc((num_threads > 1 ? num_threads - 1 : 1) * sizeof(pthread_t));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_mutex_init(&pool->run_lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+
+    for (int i = 0; i < num_threads - 1; i++) {
+        if (pthread_create(&pool->workers[i], NULL, worker_main, pool) != 0) {
+            break;  // Pula działa z mniejszą liczbą wątków
+        }
+        pool->num_workers++;
+    }
+    return pool;
+}
+
+// Funkcja zamykająca pulę i zwalniająca jej zasoby
+void thread_pool_destroy(ThreadPool* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_cond_destroy(&pool->work_done);
+    pthread_mutex_destroy(&pool->run_lock);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+// Funkcja zwracająca liczbę wątków wykonujących zadania puli
+int thread_pool_size(const ThreadPool* pool) {
+    return pool ? pool->num_workers + 1 : 1;
+}
+
+// Funkcja wykonująca zadania task(arg, 0) .. task(arg, task_count - 1) na wątkach puli
+// Wraca dopiero po zakończeniu wszystkich zadań; dla pool == NULL zadania są
+// wykonywane sekwencyjnie. Zadania nie mogą wywoływać thread_pool_run tej samej puli
+void thread_pool_run(ThreadPool* pool, int task_count, ThreadTask task, void* arg) {
+    if (task_count <= 0) return;
+    if (!pool || pool->num_workers == 0 || task_count == 1) {
+        for (int i = 0; i < task_count; i++) task(arg, i);
+        return;
+    }
+
+    pthread_mutex_lock(&pool->run_lock);
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->arg = arg;
+    pool->task_count = task_count;
+    pool->next_task = 0;
+    pthread_cond_broadcast(&pool->work_ready);
+
+    run_pending_tasks(pool);
+    while (pool->next_task < pool->task_count || pool->active > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+
+    pool->task = NULL;
+    pool->arg = NULL;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->run_lock);
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../include/graph.h"
+
+#define PREVIOUS_PARTS 8
+#define MARGIN 10.0
+
+// Przypadek testowy: zmiana liczby części i algorytm udoskonalania podziału przyrostowego
+typedef struct {
+    int num_parts;
+    RefinementMode refinement;
+    const char* name;
+} IncrementalCase;
+
+static const IncrementalCase CASES[] = {
+    {PREVIOUS_PARTS, REFINE_KWAY, "kway, ta sama liczba części"},
+    {PREVIOUS_PARTS, REFINE_LP, "lp, ta sama liczba części"},
+    {PREVIOUS_PARTS + 4, REFINE_KWAY, "kway, więcej części"},
+    {PREVIOUS_PARTS + 4, REFINE_LP, "lp, więcej części"},
+};
+
+static void free_groups(VertexGroup* groups, int num_groups) {
+    for (int i = 0; i < num_groups; i++) free(groups[i].vertices);
+    free(groups);
+}
+
+// Funkcja sprawdzająca podział przyrostowy jednego grafu dla wszystkich przypadków
+// Poprzednim podziałem jest podział wielopoziomowy na PREVIOUS_PARTS części; wynik
+// podziału przyrostowego musi mieć wszystkie części niepuste i mieścić się w marginesie
+// Zwraca liczbę nieudanych przypadków
+static int check_graph(const char* filename) {
+    Graph* graph = NULL;
+    if (load_graph_from_file(filename, &graph) != 0) {
+        fprintf(stderr, "Błąd: Nie udało się wczytać grafu z pliku: %s\n", filename);
+        return 1;
+    }
+    int n = graph->total_vertices;
+    int* part_of = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    VertexGroup* previous = NULL;
+
+    PartitionOptions options;
+    partition_options_init(&options);
+    options.num_parts = PREVIOUS_PARTS;
+    options.margin_percentage = MARGIN;
+    options.multilevel = true;
+    options.refinement = REFINE_KWAY;
+    if (!part_of || partition_graph(graph, &options, part_of) != 0 ||
+        partition_to_groups(part_of, n, PREVIOUS_PARTS, &previous) != 0) {
+        fprintf(stderr, "Błąd: Nie udało się wyznaczyć poprzedniego podziału: %s\n", filename);
+        free(part_of);
+        destroy_graph(graph);
+        return 1;
+    }
+
+    int failures = 0;
+    for (size_t c = 0; c < sizeof(CASES) / sizeof(CASES[0]); c++) {
+        const IncrementalCase* test = &CASES[c];
+        options.num_parts = test->num_parts;
+        options.refinement = test->refinement;
+        int migrated = 0;
+        int status = repartition_incremental(graph, previous, PREVIOUS_PARTS, &options, part_of, &migrated, NULL);
+        double difference = status == 0 ? calculate_weight_difference(graph, part_of, test->num_parts) : 0.0;
+        bool passed = status == 0 && difference >= 0.0 && difference <= MARGIN;
+        printf("%-8s %-30s %s (różnica wag %.2f%%, migracja %d)\n", passed ? "OK" : "BŁĄD", test->name,
+               filename, difference, migrated);
+        if (!passed) failures++;
+    }
+
+    free_groups(previous, PREVIOUS_PARTS);
+    free(part_of);
+    destroy_graph(graph);
+    return failures;
+}
+
+// Test podziału przyrostowego (repartition_incremental): zachowanie liczby części
+// oraz jej zwiększenie, dla udoskonalania k-drożnego i propagacji etykiet
+// Użycie: test_incremental plik.csrrg...
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Użycie: %s plik.csrrg...\n", argv[0]);
+        return 1;
+    }
+
+    int failures = 0;
+    for (int f = 1; f < argc; f++) failures += check_graph(argv[f]);
+    if (failures > 0) {
+        printf("Nieudane przypadki: %d\n", failures);
+        return 1;
+    }
+    return 0;
+}